@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+
+namespace trading {
+
+/**
+ * @brief Load-adaptive fragment limit for subscription polling
+ *
+ * Under light load the limit stays small so that one duty cycle never
+ * spends long on a single stream. When a poll comes back with a full batch
+ * the subscription is backlogged and the limit doubles (up to the maximum)
+ * to amortise the per-poll cost; when polls come back mostly empty it
+ * halves again. Setting min == max gives a fixed limit.
+ *
+ * Single writer (the polling thread); statistics may be read from any thread.
+ */
+class AdaptivePollLimit {
+public:
+    static constexpr int kDefaultFragmentLimit = 10;
+    static constexpr int kHistogramBuckets = 10;  // 0, 1, 2-3, 4-7, ..., 128-255, 256+
+
+    struct Statistics {
+        std::uint64_t polls;
+        std::uint64_t fragments;
+        std::uint64_t saturated_polls;    // Polls that returned the full limit
+        std::uint64_t limit_increases;
+        std::uint64_t limit_decreases;
+        int current_limit;
+        int max_limit_used;
+        std::uint64_t fragments_per_poll[kHistogramBuckets];  // log2 buckets
+    };
+
+    explicit AdaptivePollLimit(int min_limit = kDefaultFragmentLimit,
+                               int max_limit = kDefaultFragmentLimit) {
+        setLimits(min_limit, max_limit);
+    }
+
+    /**
+     * @brief Set the limit range; resets the current limit to the minimum
+     */
+    void setLimits(int min_limit, int max_limit) {
+        min_limit_ = std::max(1, min_limit);
+        max_limit_ = std::max(min_limit_, max_limit);
+        limit_ = min_limit_;
+        publishLimit();
+    }
+
+    int minLimit() const { return min_limit_; }
+    int maxLimit() const { return max_limit_; }
+    bool isAdaptive() const { return max_limit_ > min_limit_; }
+
+    /**
+     * @brief Fragment limit to pass to the next poll
+     */
+    int limit() const { return limit_; }
+
+    /**
+     * @brief Record the result of a poll and adapt the limit
+     * @param fragments_read Fragments returned by the poll
+     */
+    void onPoll(int fragments_read) {
+        increment(polls_);
+        add(fragments_, static_cast<std::uint64_t>(fragments_read));
+        increment(histogram_[bucketFor(fragments_read)]);
+
+        if (fragments_read >= limit_) {
+            increment(saturated_polls_);
+            if (limit_ < max_limit_) {
+                limit_ = std::min(limit_ * 2, max_limit_);
+                increment(limit_increases_);
+                publishLimit();
+            }
+        } else if (fragments_read <= limit_ / 4 && limit_ > min_limit_) {
+            limit_ = std::max(limit_ / 2, min_limit_);
+            increment(limit_decreases_);
+            publishLimit();
+        }
+    }
+
+    Statistics getStatistics() const {
+        Statistics stats{};
+        stats.polls = polls_.load(std::memory_order_relaxed);
+        stats.fragments = fragments_.load(std::memory_order_relaxed);
+        stats.saturated_polls = saturated_polls_.load(std::memory_order_relaxed);
+        stats.limit_increases = limit_increases_.load(std::memory_order_relaxed);
+        stats.limit_decreases = limit_decreases_.load(std::memory_order_relaxed);
+        stats.current_limit = current_limit_.load(std::memory_order_relaxed);
+        stats.max_limit_used = max_limit_used_.load(std::memory_order_relaxed);
+        for (int i = 0; i < kHistogramBuckets; ++i) {
+            stats.fragments_per_poll[i] = histogram_[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    static int bucketFor(int fragments) {
+        int bucket = 0;
+        while (fragments > 0 && bucket < kHistogramBuckets - 1) {
+            fragments >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+private:
+    int min_limit_;
+    int max_limit_;
+    int limit_;
+
+    // Counters are only written by the polling thread, so a relaxed
+    // load/store pair is enough and avoids a locked read-modify-write.
+    std::atomic<std::uint64_t> polls_{0};
+    std::atomic<std::uint64_t> fragments_{0};
+    std::atomic<std::uint64_t> saturated_polls_{0};
+    std::atomic<std::uint64_t> limit_increases_{0};
+    std::atomic<std::uint64_t> limit_decreases_{0};
+    std::atomic<int> current_limit_{0};
+    std::atomic<int> max_limit_used_{0};
+    std::atomic<std::uint64_t> histogram_[kHistogramBuckets] = {};
+
+    static void increment(std::atomic<std::uint64_t>& counter) {
+        add(counter, 1);
+    }
+
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    void publishLimit() {
+        current_limit_.store(limit_, std::memory_order_relaxed);
+        if (limit_ > max_limit_used_.load(std::memory_order_relaxed)) {
+            max_limit_used_.store(limit_, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace trading
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace trading {
@@ -18,10 +19,53 @@ public:
         std::int64_t timeout_ms;
     };
 
+    struct AdaptiveThetaConfig {
+        bool enabled;              // Scale each symbol's theta with its realized volatility
+        double event_interval_s;   // Targeted mean time between DC events
+        int half_life_ticks;       // Volatility EWMA half-life and warm-up
+        double min_scale;          // Theta bounds as multiples of the configured theta
+        double max_scale;
+    };
+
     struct DCConfig {
         double theta;              // DC threshold (e.g., 0.004 for 0.4%)
         bool enable_tmv_calculation;
         bool enable_time_adjustment;
+        AdaptiveThetaConfig adaptive_theta;
+        std::vector<double> theta_scales;  // Theta ladder as multiples of each symbol's theta
+    };
+
+    struct SymbolParameterConfig {
+        std::string symbol;
+        double theta;              // Inherits dc_strategy.theta
+        double leverage_factor;    // Scales each strategy's leverage; inherits 1.0
+    };
+
+    struct TradingRuleConfig {
+        std::string event;       // upturn, downturn or any
+        std::string regime;      // unknown, low, normal, high or any
+        std::string position;    // flat, long, short or any
+        double min_return;       // Time-adjusted return in [min_return, max_return)
+        double max_return;
+        double min_tmv;          // |TMV| in [min_tmv, max_tmv)
+        double max_tmv;
+        std::string action;      // buy, sell or none
+        double size;             // Multiplies the base quantity
+    };
+
+    struct ThetaEnsembleConfig {
+        bool enabled;                         // Trade the consensus of the theta ladder
+        std::vector<std::uint32_t> weights;   // Per rung; empty weighs every rung 1
+        std::uint32_t quorum;                 // Weighted votes a direction needs; 0 = strict majority
+    };
+
+    struct StrategyInstanceConfig {
+        std::string name;
+        double leverage_factor;
+        bool enable_hmm;
+        std::vector<double> thetas;   // DC thresholds it trades; empty trades all
+        bool trade_synthetics;        // Also trade synthetic instruments' signals
+        std::vector<TradingRuleConfig> rules;  // DC_Rules_v1 only, first match wins
     };
 
     struct StrategyConfig {
@@ -29,7 +73,119 @@ public:
         bool enable_hmm;
         int hmm_states;
         int hmm_max_iterations;
+        std::string hmm_model_file;  // Regime models written by hmm_trainer
+        int hmm_restarts;             // hmm_trainer: EM runs per model, best kept
+        int hmm_trainer_threads;      // hmm_trainer: 0 uses every core
+        int hmm_min_symbol_events;    // hmm_trainer: fewer DC events use the default model
         double leverage_factor;
+        bool trade_synthetics;        // Synthetics have no venue; their signals feed features only unless set
+        std::vector<TradingRuleConfig> rules;  // DC_Rules_v1 only, first match wins
+        std::vector<StrategyInstanceConfig> instances;  // Strategies hosted side by side; empty runs name alone
+        int worker_threads;           // Threads running the instances; 0 runs them on the engine thread
+        ThetaEnsembleConfig theta_ensemble;
+    };
+
+    struct LeadLagPairConfig {
+        std::string leader;
+        std::string follower;
+    };
+
+    struct LeadLagConfig {
+        bool enabled;                     // Track lead-lag statistics as strategy features
+        std::int64_t max_lag_ns;          // Longest lag from a leader's DC event still matched
+        int half_life_events;             // EWMA half-life of each pair's statistics
+        int min_samples;                  // Matched events before a pair is used
+        std::vector<LeadLagPairConfig> pairs;
+    };
+
+    struct SyntheticLegConfig {
+        std::string symbol;
+        double weight;             // Inherits 1.0
+    };
+
+    struct SyntheticConfig {
+        std::string name;          // Symbol its DC signals are published under
+        std::string type;          // spread (w0*p0 - w1*p1), ratio (w0*p0 / w1*p1) or basket (sum wi*pi)
+        double offset;             // Added to a spread or basket, e.g. to keep it positive
+        std::vector<SyntheticLegConfig> legs;
+    };
+
+    struct RiskSymbolConfig {
+        std::string symbol;
+        double max_position;
+        double max_notional;
+        std::uint32_t max_orders_per_second;
+        double price_band_bps;
+    };
+
+    struct RiskConfig {
+        bool enabled;                          // Pre-trade checks on strategy orders
+        double max_position;                   // Units per symbol, 0 = no limit
+        double max_notional;                   // Per order, 0 = no limit
+        std::uint32_t max_orders_per_second;   // Per symbol, 0 = no limit
+        double price_band_bps;                 // Around the last price, 0 = no limit
+        std::vector<RiskSymbolConfig> symbols; // Per-symbol overrides
+    };
+
+    struct ThrottleConfig {
+        std::uint64_t symbol_orders_per_second;  // Per-symbol sustained rate, 0 = no limit
+        std::uint64_t symbol_burst;
+        std::uint64_t global_orders_per_second;  // Across all symbols, 0 = no limit
+        std::uint64_t global_burst;
+    };
+
+    struct OrderBatchingConfig {
+        bool enabled;         // Net and batch strategy orders
+        std::int64_t window_ns;  // Batch lifetime; 0 = one batch per poll
+    };
+
+    struct RecoveryConfig {
+        bool enable_gap_recovery;      // Replay sequence gaps from the recording
+        std::string recording_file;    // Local market data recording
+        std::uint64_t recording_capacity;  // Hard limit; the recording never wraps, so later gaps are unrecoverable
+        int max_replay_per_cycle;      // Recorded messages replayed per duty cycle
+    };
+
+    struct SimulatedVenueConfig {
+        std::uint64_t seed;                    // Reproduces the same fills run to run
+        std::int64_t base_latency_ns;          // Order-to-fill latency floor
+        std::int64_t latency_jitter_ns;        // Uniform jitter added to the floor
+        double slippage_bps;                   // Fixed adverse slippage
+        double impact_bps_per_unit;            // Additional slippage per unit of quantity
+        double slippage_noise_bps;             // Uniform noise (+/-) on top
+        double partial_fill_probability;       // Share of orders filled in pieces
+        int max_partial_fills;                 // Upper bound on pieces per order
+        std::int64_t partial_fill_interval_ns; // Spacing between pieces
+        std::size_t max_pending_fills;         // Fills the venue can hold in flight
+        bool match_against_book;               // Match against books built from market data
+        double tick_size;                      // Book price increment
+        double quote_half_spread_bps;          // Quoted half spread around each tick
+        int quote_levels;                      // Levels quoted on each side per tick
+        double limit_slippage_bps;             // How far past its price an order may fill
+        std::int64_t resting_timeout_ns;       // Cancel unfilled remainders after this
+        std::size_t book_levels;               // Price levels per side per symbol
+        std::size_t max_working_orders;        // Simulated orders live at once
+    };
+
+    struct TradeJournalConfig {
+        bool enabled;                  // Journal executions to disk
+        std::string path;              // Segment file path prefix
+        std::uint64_t segment_capacity;  // Executions per segment file
+    };
+
+    struct MarkToMarketConfig {
+        bool enabled;                  // Mark positions to the market data stream
+    };
+
+    struct PollingConfig {
+        bool adaptive_fragment_limit;  // Adapt the poll limit to load
+        int fragment_limit;            // Fixed limit when not adaptive
+        int min_fragment_limit;        // Adaptive lower bound (light load)
+        int max_fragment_limit;        // Adaptive upper bound (backlogged)
+    };
+
+    struct HotReloadConfig {
+        bool enabled;                  // Apply parameter changes in the config file while running
     };
 
     struct PerformanceConfig {
@@ -42,12 +198,31 @@ public:
     
     bool loadConfig(const std::string& config_file);
     
+    /**
+     * @brief Load the file again while running
+     * @return false if it cannot be loaded; the current configuration is kept
+     */
+    bool reloadConfig(const std::string& config_file);
+    
     // Getters
     const AeronConfig& getMarketDataConfig() const { return market_data_config_; }
     const AeronConfig& getStrategyConfig() const { return strategy_config_; }
     const AeronConfig& getExecutionConfig() const { return execution_config_; }
+    const AeronConfig& getExecutionReportConfig() const { return execution_report_config_; }
     const DCConfig& getDCConfig() const { return dc_config_; }
+    const std::vector<SymbolParameterConfig>& getSymbolParameters() const { return symbol_parameters_; }
     const StrategyConfig& getStrategySettings() const { return strategy_settings_; }
+    const LeadLagConfig& getLeadLagConfig() const { return lead_lag_config_; }
+    const std::vector<SyntheticConfig>& getSyntheticConfig() const { return synthetic_config_; }
+    const RiskConfig& getRiskConfig() const { return risk_config_; }
+    const ThrottleConfig& getThrottleConfig() const { return throttle_config_; }
+    const OrderBatchingConfig& getOrderBatchingConfig() const { return order_batching_config_; }
+    const RecoveryConfig& getRecoveryConfig() const { return recovery_config_; }
+    const SimulatedVenueConfig& getSimulatedVenueConfig() const { return simulated_venue_config_; }
+    const TradeJournalConfig& getTradeJournalConfig() const { return trade_journal_config_; }
+    const MarkToMarketConfig& getMarkToMarketConfig() const { return mark_to_market_config_; }
+    const PollingConfig& getPollingConfig() const { return polling_config_; }
+    const HotReloadConfig& getHotReloadConfig() const { return hot_reload_config_; }
     const PerformanceConfig& getPerformanceConfig() const { return performance_config_; }
 
 private:
@@ -56,8 +231,21 @@ private:
     AeronConfig market_data_config_;
     AeronConfig strategy_config_;
     AeronConfig execution_config_;
+    AeronConfig execution_report_config_;
     DCConfig dc_config_;
+    std::vector<SymbolParameterConfig> symbol_parameters_;
     StrategyConfig strategy_settings_;
+    LeadLagConfig lead_lag_config_;
+    std::vector<SyntheticConfig> synthetic_config_;
+    RiskConfig risk_config_;
+    ThrottleConfig throttle_config_;
+    OrderBatchingConfig order_batching_config_;
+    RecoveryConfig recovery_config_;
+    SimulatedVenueConfig simulated_venue_config_;
+    TradeJournalConfig trade_journal_config_;
+    MarkToMarketConfig mark_to_market_config_;
+    PollingConfig polling_config_;
+    HotReloadConfig hot_reload_config_;
     PerformanceConfig performance_config_;
     
     void setDefaults();
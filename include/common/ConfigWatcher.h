@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+
+namespace trading {
+
+/**
+ * @brief Reports changes to a configuration file through inotify
+ *
+ * Watches the file's directory rather than the file, so editors and
+ * deployment tools that write a new file and rename it over the old one
+ * are seen as well as in-place writes. A change is reported once the
+ * writer has closed the file, never while it is half written. Polled, so
+ * the caller decides which thread reloads the configuration.
+ */
+class ConfigWatcher {
+public:
+    ConfigWatcher() = default;
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /**
+     * @brief Start watching a file
+     * @param path Configuration file; it may be replaced but its directory must exist
+     * @return false if inotify is unavailable or the directory cannot be watched
+     */
+    bool watch(const std::string& path);
+
+    /**
+     * @brief Stop watching
+     */
+    void close();
+
+    /**
+     * @brief Whether the file was written or replaced since the last call
+     *
+     * Never blocks; any number of writes since the last call count as one
+     * change.
+     */
+    bool changed();
+
+    bool isWatching() const { return fd_ >= 0; }
+
+private:
+    int fd_ = -1;
+    std::string file_name_;
+};
+
+} // namespace trading
@@ -42,6 +42,21 @@ struct DCEvent {
                 tmv_ext(0.0), duration(0), time_adjusted_return(0.0) {}
 };
 
+/**
+ * @brief Settings of the volatility-adaptive threshold
+ *
+ * For a driftless price the expected time between DC events is about
+ * (theta / sigma)^2, so a theta of sigma * sqrt(event_interval_s) keeps
+ * the event rate roughly constant as volatility changes.
+ */
+struct AdaptiveThetaSettings {
+    bool enabled;
+    double event_interval_s;       // Targeted mean time between DC events
+    std::uint32_t half_life_ticks; // EWMA half-life of the volatility estimate; also the warm-up
+    double min_scale;              // Bounds on theta as multiples of the configured theta
+    double max_scale;
+};
+
 /**
  * @brief Directional Change (DC) indicator calculator
  */
@@ -56,18 +71,50 @@ public:
      */
     DCEvent processDataPoint(const MarketDataPoint& data_point);
     
+    /**
+     * @brief Fold in a data point that arrived after newer ones were processed
+     *
+     * An out-of-order point can no longer trigger a DC event, but if it set a
+     * new extreme since the last DC event the extreme must reflect it, or the
+     * next event's TMV and duration are computed from the wrong extreme.
+     * @param data_point Late market data point
+     * @return true if the point replaced the current extreme
+     */
+    bool processLateDataPoint(const MarketDataPoint& data_point);
+    
     /**
      * @brief Set DC threshold
-     * @param theta New threshold value (e.g., 0.004 for 0.4%)
+     * @param theta New threshold value (e.g., 0.004 for 0.4%); with an
+     *        adaptive threshold, the base its bounds and warm-up value use
      */
-    void setTheta(double theta) { theta_ = theta; }
+    void setTheta(double theta);
     
     /**
      * @brief Get current theta value
-     * @return Current threshold
+     * @return Current threshold, adapted to volatility when enabled
      */
     double getTheta() const { return theta_; }
     
+    /**
+     * @brief Get the configured theta the threshold adapts around
+     */
+    double getBaseTheta() const { return base_theta_; }
+    
+    /**
+     * @brief Rescale theta with realized volatility
+     *
+     * Volatility is an O(1) EWMA of squared tick returns over an EWMA of
+     * the time between ticks, so irregular tick spacing is accounted for.
+     * Theta stays at the configured value until half_life_ticks ticks have
+     * been seen, then follows the estimate within the bounds.
+     */
+    void setAdaptiveTheta(const AdaptiveThetaSettings& settings);
+    
+    /**
+     * @brief Realized volatility per square-root second, 0 during warm-up
+     */
+    double getVolatility() const;
+    
     /**
      * @brief Reset the indicator state
      */
@@ -86,7 +133,8 @@ public:
     const DCEvent& getLastDCEvent() const { return last_dc_event_; }
 
 private:
-    double theta_;                    // DC threshold
+    double theta_;                    // DC threshold in use
+    double base_theta_;               // Configured threshold
     int current_trend_;               // Current trend: 1=up, -1=down, 0=unknown
     
     // State tracking
@@ -97,6 +145,18 @@ private:
     
     DCEvent last_dc_event_;
     
+    // Volatility-adaptive threshold
+    AdaptiveThetaSettings adaptive_;
+    double ewma_alpha_;
+    double last_price_;               // Previous in-order tick
+    std::int64_t last_timestamp_;
+    double ewma_squared_return_;
+    double ewma_interval_s_;
+    std::uint32_t volatility_samples_;
+    
+    void updateVolatility(const MarketDataPoint& data_point);
+    double adaptedTheta() const;
+    
     // Internal calculation methods
     double calculateTMV(double current_price, double previous_extreme) const;
     std::int64_t calculateDuration(std::int64_t current_time, std::int64_t previous_time) const;
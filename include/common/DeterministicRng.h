@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace trading {
+
+/**
+ * @brief Small deterministic PRNG (splitmix64)
+ *
+ * Used instead of <random> distributions, whose output is implementation
+ * defined, so a seed reproduces the same fills and the same training
+ * restarts on every platform.
+ */
+class DeterministicRng {
+public:
+    explicit DeterministicRng(std::uint64_t seed = 0) : state_(seed) {}
+
+    void seed(std::uint64_t seed) { state_ = seed; }
+
+    std::uint64_t next() {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Uniform double in [0, 1)
+     */
+    double uniform() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Standard normal by Box-Muller, one draw per call
+     */
+    double normal() {
+        const double u1 = 1.0 - uniform();  // (0, 1], so the log is finite
+        const double u2 = uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    /**
+     * @brief Uniform integer in [low, high]
+     */
+    std::int64_t uniformInt(std::int64_t low, std::int64_t high) {
+        if (high <= low) {
+            return low;
+        }
+        return low + static_cast<std::int64_t>(next() % static_cast<std::uint64_t>(high - low + 1));
+    }
+
+private:
+    std::uint64_t state_;
+};
+
+} // namespace trading
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trading {
+
+/**
+ * @brief Per-hop timestamps carried from tick ingress to execution
+ *
+ * Every hop is stamped with TimeUtils::getCurrentTimestampNs() inside this
+ * process, so differences between hops are meaningful even though the feed
+ * timestamp in MarketDataMessage comes from another clock. Unset hops are 0.
+ */
+struct HopTimestamps {
+    std::int64_t feed_receive_ns;      // Tick received by MarketDataProcessor (ingress)
+    std::int64_t dc_detected_ns;       // DC event detected for the tick
+    std::int64_t signal_published_ns;  // DC signal offered to the strategy stream
+    std::int64_t order_created_ns;     // Trading order created by StrategyEngine
+    std::int64_t execution_ns;         // Execution recorded by ExecutionEngine
+};
+
+/**
+ * @brief Running latency for one hop
+ */
+struct HopLatency {
+    std::int64_t avg_ns;
+    std::int64_t max_ns;
+    
+    void update(std::int64_t latency_ns, std::uint64_t samples) {
+        if (samples == 1) {
+            avg_ns = latency_ns;
+        } else {
+            avg_ns = static_cast<std::int64_t>((avg_ns * 0.9) + (latency_ns * 0.1));
+        }
+        if (latency_ns > max_ns) {
+            max_ns = latency_ns;
+        }
+    }
+};
+
+/**
+ * @brief Tick-to-trade latency and its per-hop breakdown
+ */
+struct LatencyBreakdown {
+    std::uint64_t samples;
+    HopLatency feed_to_dc;          // Feed receive -> DC detected
+    HopLatency dc_to_signal;        // DC detected -> signal published
+    HopLatency signal_to_order;     // Signal published -> order created
+    HopLatency order_to_execution;  // Order created -> execution
+    HopLatency tick_to_trade;       // Feed receive -> execution
+    
+    void record(const HopTimestamps& hops) {
+        if (hops.feed_receive_ns == 0 || hops.execution_ns == 0) {
+            return;  // Order did not originate from a timed tick
+        }
+        samples++;
+        feed_to_dc.update(hops.dc_detected_ns - hops.feed_receive_ns, samples);
+        dc_to_signal.update(hops.signal_published_ns - hops.dc_detected_ns, samples);
+        signal_to_order.update(hops.order_created_ns - hops.signal_published_ns, samples);
+        order_to_execution.update(hops.execution_ns - hops.order_created_ns, samples);
+        tick_to_trade.update(hops.execution_ns - hops.feed_receive_ns, samples);
+    }
+};
+
+} // namespace trading
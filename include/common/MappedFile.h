@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace trading {
+
+/**
+ * @brief RAII wrapper around a shared memory-mapped file
+ *
+ * Used for recordings and journals that are written by one process and
+ * read by others through the page cache.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Create (or truncate) a file of the given size and map it read-write
+     * @param path File path
+     * @param size File size in bytes
+     * @return true if successful
+     */
+    bool create(const std::string& path, std::size_t size);
+
+    /**
+     * @brief Map an existing file
+     * @param path File path
+     * @param writable Map read-write instead of read-only
+     * @return true if successful
+     */
+    bool open(const std::string& path, bool writable = false);
+
+    /**
+     * @brief Unmap and close the file
+     */
+    void close();
+
+    /**
+     * @brief Flush dirty pages in a range to the file asynchronously
+     */
+    void sync(std::size_t offset, std::size_t length);
+
+    /**
+     * @brief Drop a range of pages from this process's resident set
+     *
+     * The data stays in the file and the page cache; touching the range again
+     * faults it back in.
+     */
+    void release(std::size_t offset, std::size_t length);
+
+    bool isOpen() const { return data_ != nullptr; }
+    std::uint8_t* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+    static bool exists(const std::string& path);
+
+private:
+    std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+    int fd_ = -1;
+    std::string path_;
+
+    bool map(bool writable);
+    static std::size_t pageAlignDown(std::size_t offset);
+};
+
+} // namespace trading
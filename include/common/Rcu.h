@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trading {
+
+/**
+ * @brief Quiescent-state based read-copy-update domain
+ *
+ * Reader threads register once and call quiescent() at a point where they
+ * hold no pointers obtained from an RcuPointer, typically at the top of
+ * each duty cycle. Readers pay one relaxed load per read and one store per
+ * cycle; writers wait in synchronize() until every online reader has passed
+ * a quiescent state, after which the old version can be freed. A reader
+ * that stops polling (thread exit, long sleep) must go offline() or it will
+ * hold writers up. The domain is sized for its readers up front;
+ * registering more than max_readers is a programming error.
+ */
+class RcuDomain {
+public:
+    using ReaderId = std::size_t;
+
+    explicit RcuDomain(std::size_t max_readers = 8)
+        : epoch_(1)
+        , readers_(max_readers)
+        , registered_(0)
+    {
+        for (ReaderSlot& reader : readers_) {
+            reader.epoch.store(kOffline, std::memory_order_relaxed);
+        }
+    }
+
+    RcuDomain(const RcuDomain&) = delete;
+    RcuDomain& operator=(const RcuDomain&) = delete;
+
+    /**
+     * @brief Claim a reader slot; the reader starts offline
+     * @return Reader id, or max_readers if every slot is taken. That id is
+     *         not a reader: passing it to quiescent(), online() or offline()
+     *         asserts.
+     */
+    ReaderId registerReader() {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        assert(registered_ < readers_.size() && "RcuDomain sized for fewer readers");
+        if (registered_ == readers_.size()) {
+            return readers_.size();
+        }
+        return registered_++;
+    }
+
+    /**
+     * @brief Announce that the reader holds no protected pointers
+     */
+    void quiescent(ReaderId reader) {
+        assert(reader < readers_.size());
+        readers_[reader].epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /**
+     * @brief Take part in grace periods again after offline()
+     */
+    void online(ReaderId reader) {
+        quiescent(reader);
+        // The slot store must be visible before this reader's next read(), or a
+        // concurrent synchronize() could see it offline and free what it reads.
+        // Pairs with the fence in synchronize().
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Stop taking part in grace periods until online()
+     */
+    void offline(ReaderId reader) {
+        assert(reader < readers_.size());
+        readers_[reader].epoch.store(kOffline, std::memory_order_release);
+    }
+
+    /**
+     * @brief Wait until every online reader has passed a quiescent state
+     */
+    void synchronize() {
+        const std::uint64_t target = epoch_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        // Orders the caller's pointer swap before the slot scan; see online()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::size_t count = registered();
+        for (std::size_t i = 0; i < count; ++i) {
+            for (;;) {
+                const std::uint64_t seen = readers_[i].epoch.load(std::memory_order_acquire);
+                if (seen == kOffline || seen >= target) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint64_t kOffline = 0;
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch;
+    };
+
+    std::atomic<std::uint64_t> epoch_;
+    std::vector<ReaderSlot> readers_;
+    std::size_t registered_;  // Guarded by writer_mutex_
+    std::mutex writer_mutex_;
+
+    std::size_t registered() {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        return registered_;
+    }
+};
+
+/**
+ * @brief Pointer to an immutable value, replaced by RCU
+ *
+ * read() is a single acquire load. update() publishes the new value with a
+ * pointer swap, waits for a grace period on the domain, then frees the old
+ * value; it may be called from any thread but never from a reader of the
+ * same domain, which would wait on itself.
+ */
+template<typename T>
+class RcuPointer {
+public:
+    RcuPointer(RcuDomain& domain, std::unique_ptr<T> initial)
+        : domain_(domain)
+        , current_(initial.release())
+    {
+    }
+
+    ~RcuPointer() {
+        delete current_.load(std::memory_order_relaxed);
+    }
+
+    RcuPointer(const RcuPointer&) = delete;
+    RcuPointer& operator=(const RcuPointer&) = delete;
+
+    /**
+     * @brief Current value; valid until the reader's next quiescent state
+     */
+    const T* read() const { return current_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Publish a new value and free the previous one once unused
+     */
+    void update(std::unique_ptr<T> next) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        std::unique_ptr<T> previous(current_.exchange(next.release(), std::memory_order_acq_rel));
+        domain_.synchronize();
+    }
+
+private:
+    RcuDomain& domain_;
+    std::atomic<T*> current_;
+    std::mutex update_mutex_;
+};
+
+} // namespace trading
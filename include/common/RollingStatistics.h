@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace trading {
+
+/**
+ * @brief Mean, variance and downside deviation over the last N samples
+ *
+ * Samples live in a preallocated ring. Mean and the sum of squared
+ * deviations are kept with Welford's update; when the ring is full the
+ * evicted and the new sample are folded in one step, so every add() is O(1)
+ * however large the window. Not thread-safe.
+ */
+class RollingStatistics {
+public:
+    explicit RollingStatistics(std::size_t capacity)
+        : samples_(std::max<std::size_t>(capacity, 1), 0.0)
+    {
+        reset();
+    }
+
+    void reset() {
+        head_ = 0;
+        count_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+        downside_sq_ = 0.0;
+    }
+
+    void add(double value) {
+        const double downside = value < 0.0 ? value * value : 0.0;
+
+        if (count_ < samples_.size()) {
+            samples_[(head_ + count_) % samples_.size()] = value;
+            count_++;
+            const double delta = value - mean_;
+            mean_ += delta / static_cast<double>(count_);
+            m2_ += delta * (value - mean_);
+        } else {
+            // Replace the oldest sample: remove and add in one Welford step
+            const double evicted = samples_[head_];
+            samples_[head_] = value;
+            head_ = (head_ + 1) % samples_.size();
+
+            const double old_mean = mean_;
+            mean_ += (value - evicted) / static_cast<double>(count_);
+            m2_ += (value - evicted) * (value - mean_ + evicted - old_mean);
+            downside_sq_ -= evicted < 0.0 ? evicted * evicted : 0.0;
+        }
+
+        downside_sq_ += downside;
+        // Rounding can push the running sums slightly negative
+        m2_ = std::max(m2_, 0.0);
+        downside_sq_ = std::max(downside_sq_, 0.0);
+    }
+
+    std::size_t count() const { return count_; }
+    std::size_t capacity() const { return samples_.size(); }
+    bool full() const { return count_ == samples_.size(); }
+
+    double mean() const { return mean_; }
+
+    /**
+     * @brief Sample variance (n - 1 denominator)
+     */
+    double variance() const {
+        return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0;
+    }
+
+    double stddev() const { return std::sqrt(variance()); }
+
+    /**
+     * @brief Root mean square of the negative samples (target return 0)
+     */
+    double downsideDeviation() const {
+        return count_ > 0 ? std::sqrt(downside_sq_ / static_cast<double>(count_)) : 0.0;
+    }
+
+    /**
+     * @brief Mean over standard deviation (risk-free rate 0); 0 until defined
+     */
+    double sharpeRatio() const {
+        const double sd = stddev();
+        return (count_ > 1 && sd > 0.0) ? mean_ / sd : 0.0;
+    }
+
+    /**
+     * @brief Mean over downside deviation; 0 until defined
+     */
+    double sortinoRatio() const {
+        const double dd = downsideDeviation();
+        return (count_ > 1 && dd > 0.0) ? mean_ / dd : 0.0;
+    }
+
+private:
+    std::vector<double> samples_;
+    std::size_t head_;   // Oldest sample once full
+    std::size_t count_;
+    double mean_;
+    double m2_;          // Sum of squared deviations from the mean
+    double downside_sq_; // Sum of squared negative samples
+};
+
+/**
+ * @brief Peak-to-trough drawdown of an equity curve, O(1) per update
+ */
+class DrawdownTracker {
+public:
+    explicit DrawdownTracker(double initial_equity = 0.0) { reset(initial_equity); }
+
+    void reset(double initial_equity) {
+        peak_ = initial_equity;
+        current_ = 0.0;
+        max_ = 0.0;
+    }
+
+    void update(double equity) {
+        peak_ = std::max(peak_, equity);
+        current_ = peak_ > 0.0 ? (peak_ - equity) / peak_ : 0.0;
+        max_ = std::max(max_, current_);
+    }
+
+    double peak() const { return peak_; }
+    double current() const { return current_; }
+    double max() const { return max_; }
+
+private:
+    double peak_;
+    double current_;  // Fraction below the peak
+    double max_;
+};
+
+} // namespace trading
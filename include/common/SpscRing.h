@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace trading {
+
+/**
+ * @brief Bounded single-producer single-consumer queue
+ *
+ * Capacity is rounded up to a power of two and allocated in the
+ * constructor. Each side keeps a cached copy of the other side's index and
+ * reloads it only when the ring looks full or empty, so a push or pop is
+ * normally a copy plus one release store. Exactly one thread may push and
+ * one thread may pop.
+ */
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity)
+        : head_(0)
+        , cached_tail_(0)
+        , tail_(0)
+        , cached_head_(0)
+        , mask_(slotCount(capacity) - 1)
+        , slots_(slotCount(capacity))
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Append a value; producer only
+     * @return false if the ring is full
+     */
+    bool tryPush(const T& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest value; consumer only
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    static std::size_t slotCount(std::size_t capacity) {
+        std::size_t slots = 2;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        return slots;
+    }
+
+    // Consumer side
+    alignas(64) std::atomic<std::size_t> head_;
+    std::size_t cached_tail_;
+
+    // Producer side
+    alignas(64) std::atomic<std::size_t> tail_;
+    std::size_t cached_head_;
+
+    alignas(64) std::size_t mask_;
+    std::vector<T> slots_;
+};
+
+} // namespace trading
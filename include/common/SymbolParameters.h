@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "common/Config.h"
+#include "common/SymbolTable.h"
+
+namespace trading {
+
+/**
+ * @brief Trading parameters of one symbol
+ */
+struct SymbolParameters {
+    double theta;            // DC threshold the symbol's events are detected at
+    double leverage_factor;  // Multiplies each strategy's leverage for the symbol
+};
+
+/**
+ * @brief Immutable table of per-symbol parameters with a default row
+ *
+ * Built off the trading threads and published through RCU. Engines do not
+ * probe it per tick: they resolve a symbol's row once, when the symbol
+ * first appears or a new table is published, into their own arrays
+ * indexed by their symbol ids.
+ */
+class SymbolParameterTable {
+public:
+    explicit SymbolParameterTable(const SymbolParameters& defaults, std::size_t capacity = 16384)
+        : defaults_(defaults)
+        , symbols_(capacity)
+    {
+    }
+
+    /**
+     * @brief Add the configured symbols
+     * @param error Set to the first problem found
+     * @return false, adding nothing, if the defaults or a symbol's values
+     *         are out of range, a symbol is empty, too long or repeated, or
+     *         the table is full
+     */
+    bool load(const std::vector<Config::SymbolParameterConfig>& symbols, std::string& error);
+
+    /**
+     * @brief Override the default parameters for a symbol
+     * @return false if the table is full
+     */
+    bool set(const char* symbol, const SymbolParameters& parameters) {
+        SymbolId id = symbols_.findOrInsert(symbol);
+        if (id == kInvalidSymbolId) {
+            return false;
+        }
+        if (id >= parameters_.size()) {
+            parameters_.resize(id + 1);
+        }
+        parameters_[id] = parameters;
+        return true;
+    }
+
+    const SymbolParameters& lookup(const char* symbol) const {
+        SymbolId id = symbols_.find(symbol);
+        return id == kInvalidSymbolId ? defaults_ : parameters_[id];
+    }
+
+    const SymbolParameters& defaults() const { return defaults_; }
+
+    /**
+     * @brief Number of symbols with their own row
+     */
+    std::size_t size() const { return parameters_.size(); }
+
+private:
+    SymbolParameters defaults_;
+    SymbolTable symbols_;
+    std::vector<SymbolParameters> parameters_;
+};
+
+} // namespace trading
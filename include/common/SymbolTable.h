@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace trading {
+
+using SymbolId = std::uint32_t;
+constexpr SymbolId kInvalidSymbolId = 0xFFFFFFFFu;
+constexpr std::size_t kSymbolLength = 16;  // Matches the char[16] symbol fields in messages
+constexpr std::size_t kMaxSymbolNameLength = kSymbolLength - 1;  // Messages keep a terminating null
+
+/**
+ * @brief Maps fixed-width symbol names to dense ids
+ *
+ * Ids are assigned in insertion order starting at 0, so per-symbol state can
+ * live in plain arrays indexed by id. Lookup is an open-addressing probe over
+ * the 16-byte symbol compared as two 64-bit words; no allocation after
+ * construction. Not thread-safe: each engine owns its own table.
+ */
+class SymbolTable {
+public:
+    explicit SymbolTable(std::size_t capacity = 16384)
+        : mask_(slotCount(capacity) - 1)
+        , slots_(slotCount(capacity), kInvalidSymbolId)
+        , capacity_(capacity)
+    {
+        keys_.reserve(capacity);
+    }
+
+    /**
+     * @brief Find the id of a symbol
+     * @return Symbol id, or kInvalidSymbolId if unknown
+     */
+    SymbolId find(const char* symbol) const {
+        Key key = makeKey(symbol);
+        for (std::size_t slot = hash(key) & mask_;; slot = (slot + 1) & mask_) {
+            SymbolId id = slots_[slot];
+            if (id == kInvalidSymbolId || keys_[id] == key) {
+                return id;
+            }
+        }
+    }
+
+    /**
+     * @brief Find the id of a symbol, assigning the next id if unknown
+     * @return Symbol id, or kInvalidSymbolId if the table is full
+     */
+    SymbolId findOrInsert(const char* symbol) {
+        Key key = makeKey(symbol);
+        std::size_t slot = hash(key) & mask_;
+        for (;; slot = (slot + 1) & mask_) {
+            SymbolId id = slots_[slot];
+            if (id == kInvalidSymbolId) {
+                break;
+            }
+            if (keys_[id] == key) {
+                return id;
+            }
+        }
+
+        if (keys_.size() >= capacity_) {
+            return kInvalidSymbolId;
+        }
+
+        SymbolId id = static_cast<SymbolId>(keys_.size());
+        keys_.push_back(key);
+        slots_[slot] = id;
+        return id;
+    }
+
+    /**
+     * @brief Get the symbol name for an id
+     */
+    std::string name(SymbolId id) const {
+        if (id >= keys_.size()) {
+            return std::string();
+        }
+        char buffer[kSymbolLength + 1];
+        std::memcpy(buffer, keys_[id].words, kSymbolLength);
+        buffer[kSymbolLength] = '\0';
+        return std::string(buffer);
+    }
+
+    std::size_t size() const { return keys_.size(); }
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    struct Key {
+        std::uint64_t words[2];
+
+        bool operator==(const Key& other) const {
+            return words[0] == other.words[0] && words[1] == other.words[1];
+        }
+    };
+
+    std::size_t mask_;
+    std::vector<SymbolId> slots_;
+    std::vector<Key> keys_;
+    std::size_t capacity_;
+
+    static std::size_t slotCount(std::size_t capacity) {
+        // Keep the load factor at or below 0.5
+        std::size_t slots = 16;
+        while (slots < capacity * 2) {
+            slots <<= 1;
+        }
+        return slots;
+    }
+
+    static Key makeKey(const char* symbol) {
+        Key key{{0, 0}};
+        std::size_t length = strnlen(symbol, kSymbolLength);
+        std::memcpy(key.words, symbol, length);
+        return key;
+    }
+
+    static std::size_t hash(const Key& key) {
+        // Symbols differ mostly in their trailing characters, which land in the
+        // high bytes of each word; fold them down to the low bits used as the slot
+        std::uint64_t h = key.words[0] ^ (key.words[1] * 0x9E3779B97F4A7C15ull);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+};
+
+} // namespace trading
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace trading {
+
+/**
+ * @brief Hashed timing wheel over a preallocated entry pool
+ *
+ * Deadlines are bucketed into slots of tick_ns width; advance() walks only
+ * the slots between the last and the current time, firing entries whose
+ * deadline has passed and leaving later rotations in place. Entries in a slot
+ * fire in scheduling order, so the firing sequence is a pure function of the
+ * schedule() and advance() calls. No allocation after construction.
+ *
+ * @tparam T Payload copied into the wheel on schedule()
+ */
+template <typename T>
+class TimerWheel {
+public:
+    /**
+     * @param tick_ns Slot width in nanoseconds
+     * @param slot_count Number of slots (rounded up to a power of two)
+     * @param capacity Maximum number of pending entries
+     */
+    TimerWheel(std::int64_t tick_ns, std::size_t slot_count, std::size_t capacity)
+        : tick_ns_(tick_ns > 0 ? tick_ns : 1)
+        , current_tick_(0)
+        , started_(false)
+        , size_(0)
+    {
+        std::size_t slots = 1;
+        while (slots < slot_count) {
+            slots <<= 1;
+        }
+        mask_ = slots - 1;
+        slots_.assign(slots, Slot{kNull, kNull});
+
+        pool_.resize(capacity);
+        free_head_ = capacity > 0 ? 0 : kNull;
+        for (std::size_t i = 0; i < capacity; ++i) {
+            pool_[i].next = (i + 1 < capacity) ? static_cast<std::uint32_t>(i + 1) : kNull;
+        }
+    }
+
+    /**
+     * @brief Schedule a payload to fire at or after a deadline
+     * @return false if the pool is exhausted
+     */
+    bool schedule(std::int64_t deadline_ns, const T& payload) {
+        if (free_head_ == kNull) {
+            return false;
+        }
+
+        std::uint32_t index = free_head_;
+        Entry& entry = pool_[index];
+        free_head_ = entry.next;
+
+        entry.deadline_ns = deadline_ns;
+        entry.payload = payload;
+        entry.next = kNull;
+
+        // Deadlines already behind the wheel go into the slot walked next
+        std::int64_t tick = deadline_ns / tick_ns_;
+        if (started_ && tick < current_tick_) {
+            tick = current_tick_;
+        }
+
+        Slot& slot = slots_[static_cast<std::size_t>(tick) & mask_];
+        if (slot.tail == kNull) {
+            slot.head = index;
+        } else {
+            pool_[slot.tail].next = index;
+        }
+        slot.tail = index;
+        size_++;
+        return true;
+    }
+
+    /**
+     * @brief Fire every entry whose deadline is at or before now
+     * @param now_ns Current time on the wheel's clock
+     * @param handler Called as handler(deadline_ns, payload)
+     * @return Number of entries fired
+     */
+    template <typename Handler>
+    int advance(std::int64_t now_ns, Handler&& handler) {
+        std::int64_t target_tick = now_ns / tick_ns_;
+        if (!started_) {
+            // First advance: anything scheduled so far may sit in any slot
+            current_tick_ = target_tick - static_cast<std::int64_t>(mask_);
+            started_ = true;
+        }
+        if (size_ == 0 || target_tick < current_tick_) {
+            current_tick_ = std::max(current_tick_, target_tick);
+            return 0;
+        }
+
+        // The current slot is walked again since it may hold entries due later
+        // in the same tick; beyond that each slot is visited at most once
+        std::int64_t first_tick = current_tick_;
+        if (target_tick - first_tick > static_cast<std::int64_t>(mask_)) {
+            first_tick = target_tick - static_cast<std::int64_t>(mask_);
+        }
+        current_tick_ = target_tick;
+
+        int fired = 0;
+        for (std::int64_t tick = first_tick; tick <= target_tick && size_ > 0; ++tick) {
+            fired += fireSlot(slots_[static_cast<std::size_t>(tick) & mask_], now_ns, handler);
+        }
+        return fired;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return pool_.size(); }
+
+private:
+    static constexpr std::uint32_t kNull = 0xFFFFFFFFu;
+
+    struct Entry {
+        std::int64_t deadline_ns;
+        std::uint32_t next;
+        T payload;
+    };
+
+    struct Slot {
+        std::uint32_t head;
+        std::uint32_t tail;
+    };
+
+    std::int64_t tick_ns_;
+    std::int64_t current_tick_;  // Tick of the last advance()
+    bool started_;               // Set by the first advance()
+    std::size_t mask_;
+    std::size_t size_;
+    std::vector<Slot> slots_;
+    std::vector<Entry> pool_;
+    std::uint32_t free_head_;
+
+    template <typename Handler>
+    int fireSlot(Slot& slot, std::int64_t now_ns, Handler& handler) {
+        int fired = 0;
+        std::uint32_t prev = kNull;
+        std::uint32_t index = slot.head;
+
+        while (index != kNull) {
+            Entry& entry = pool_[index];
+            std::uint32_t next = entry.next;
+
+            if (entry.deadline_ns <= now_ns) {
+                // Unlink, fire, then return the entry to the free list
+                if (prev == kNull) {
+                    slot.head = next;
+                } else {
+                    pool_[prev].next = next;
+                }
+                if (slot.tail == index) {
+                    slot.tail = prev;
+                }
+                size_--;
+
+                handler(entry.deadline_ns, static_cast<const T&>(entry.payload));
+                fired++;
+
+                entry.next = free_head_;
+                free_head_ = index;
+            } else {
+                prev = index;  // Later rotation; leave in place
+            }
+            index = next;
+        }
+        return fired;
+    }
+};
+
+} // namespace trading
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace trading {
+
+/**
+ * @brief Rate and burst shared by any number of TokenBucket instances
+ */
+struct TokenBucketLimit {
+    std::uint64_t rate_per_second;  // Sustained rate; 0 means unlimited
+    std::uint64_t burst;            // Tokens available after an idle period
+};
+
+/**
+ * @brief Token bucket rate limiter in integer nanosecond arithmetic
+ *
+ * The level is kept in nano-tokens so refills need no division or floating
+ * point, and the limit is passed in rather than stored, so a bucket per
+ * symbol is 16 bytes. A new bucket starts full. Not thread-safe.
+ */
+class TokenBucket {
+public:
+    TokenBucket() : level_(0), last_ns_(0) {}
+
+    /**
+     * @brief Take one token if available
+     * @return false if the caller is over its rate
+     */
+    bool tryAcquire(const TokenBucketLimit& limit, std::int64_t now_ns) {
+        if (!available(limit, now_ns)) {
+            return false;
+        }
+        consume(limit);
+        return true;
+    }
+
+    /**
+     * @brief Refill and tell whether a token is available, without taking it
+     *
+     * Lets a caller check several buckets and take from each only if all
+     * of them have a token.
+     */
+    bool available(const TokenBucketLimit& limit, std::int64_t now_ns) {
+        if (limit.rate_per_second == 0) {
+            return true;
+        }
+
+        const std::uint64_t capacity = std::max<std::uint64_t>(limit.burst, 1) * kScale;
+        if (now_ns > last_ns_) {
+            // Past capacity / rate nanoseconds the bucket is full anyway, which also bounds the product
+            const std::uint64_t elapsed = static_cast<std::uint64_t>(now_ns - last_ns_);
+            const std::uint64_t refill = elapsed >= capacity / limit.rate_per_second ?
+                capacity : elapsed * limit.rate_per_second;
+            level_ = std::min(capacity, level_ + refill);
+            last_ns_ = now_ns;
+        }
+
+        return level_ >= kScale;
+    }
+
+    /**
+     * @brief Take the token available() reported
+     */
+    void consume(const TokenBucketLimit& limit) {
+        if (limit.rate_per_second != 0) {
+            level_ -= kScale;
+        }
+    }
+
+private:
+    static constexpr std::uint64_t kScale = 1000000000;  // Nano-tokens per token
+
+    std::uint64_t level_;
+    std::int64_t last_ns_;
+};
+
+} // namespace trading
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trading {
+
+/**
+ * @brief Thread pool with a task deque per worker and work stealing
+ *
+ * A worker runs its own tasks newest first and, once its deque is empty,
+ * steals the oldest task of another worker, so uneven tasks (one large
+ * symbol next to many small ones) still keep every thread busy. Tasks
+ * submitted from a worker go to that worker's deque; tasks from other
+ * threads are dealt round-robin. Meant for coarse batch work such as model
+ * training, not for the trading hot path.
+ */
+class WorkStealingPool {
+public:
+    struct Statistics {
+        std::uint64_t executed;
+        std::uint64_t stolen;
+    };
+
+    /**
+     * @param threads Worker count; 0 uses the hardware concurrency
+     */
+    explicit WorkStealingPool(std::size_t threads = 0)
+        : queues_(threads != 0 ? threads : std::max<std::size_t>(std::thread::hardware_concurrency(), 1))
+        , next_queue_(0)
+        , queued_(0)
+        , pending_(0)
+        , executed_(0)
+        , stolen_(0)
+        , stopping_(false)
+    {
+        for (std::size_t i = 0; i < queues_.size(); ++i) {
+            workers_.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::size_t threads() const { return queues_.size(); }
+
+    void submit(std::function<void()> task) {
+        const std::size_t index = current_pool_ == this ?
+            current_worker_ : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queues_[index].mutex);
+            queues_[index].tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            queued_++;
+        }
+        wake_.notify_one();
+    }
+
+    /**
+     * @brief Block until every submitted task, including tasks they submitted, has run
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        done_.wait(lock, [this]() { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+
+    Statistics getStatistics() const {
+        return Statistics{executed_.load(std::memory_order_relaxed), stolen_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool popOwn(std::size_t index, std::function<void()>& task) {
+        std::lock_guard<std::mutex> lock(queues_[index].mutex);
+        if (queues_[index].tasks.empty()) {
+            return false;
+        }
+        task = std::move(queues_[index].tasks.back());
+        queues_[index].tasks.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t thief, std::function<void()>& task) {
+        for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+            Queue& victim = queues_[(thief + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t index) {
+        current_pool_ = this;
+        current_worker_ = index;
+
+        std::function<void()> task;
+        for (;;) {
+            bool stolen = false;
+            if (!popOwn(index, task)) {
+                stolen = steal(index, task);
+                if (!stolen) {
+                    std::unique_lock<std::mutex> lock(wake_mutex_);
+                    wake_.wait(lock, [this]() { return queued_ > 0 || stopping_; });
+                    if (queued_ == 0 && stopping_) {
+                        return;
+                    }
+                    continue;
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                queued_--;
+            }
+            task();
+            task = nullptr;
+
+            executed_.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) {
+                stolen_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+
+    static thread_local WorkStealingPool* current_pool_;
+    static thread_local std::size_t current_worker_;
+
+    std::vector<Queue> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> next_queue_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::size_t queued_;                 // Tasks in any deque; guarded by wake_mutex_
+    std::atomic<std::size_t> pending_;   // Submitted and not yet finished
+    std::atomic<std::uint64_t> executed_;
+    std::atomic<std::uint64_t> stolen_;
+    bool stopping_;
+};
+
+inline thread_local WorkStealingPool* WorkStealingPool::current_pool_ = nullptr;
+inline thread_local std::size_t WorkStealingPool::current_worker_ = 0;
+
+} // namespace trading
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/DeterministicRng.h"
+#include "common/SymbolTable.h"
+#include "common/TimerWheel.h"
+#include "execution/ExecutionMessages.h"
+#include "execution/OrderBook.h"
+#include "market_data/MarketDataMessages.h"
+#include "strategy/StrategyMessages.h"
+
+namespace trading {
+
+/**
+ * @brief A fill produced by the simulated venue
+ */
+struct SimulatedFill {
+    OrderId order_id;              // Assigned by the caller on submit
+    std::int64_t submit_ns;        // Simulated time the order reached the venue
+    std::int64_t fill_ns;          // Simulated time of this fill
+    SignalType signal;
+    std::uint16_t strategy_id;     // From the order
+    double price;
+    double quantity;
+    ExecutionStatus status;        // PARTIALLY_FILLED for all but the last fill, CANCELLED if unfilled
+    char symbol[16];
+    HopTimestamps hops;            // Carried from the order
+};
+
+/**
+ * @brief Deterministic simulated venue
+ *
+ * Orders are acknowledged immediately and everything after that happens on
+ * a timer wheel in simulated time, advanced by the caller's duty cycle with
+ * poll(), so nothing on the execution thread ever sleeps. Two fill models:
+ *
+ * - Statistical (default): fills are scheduled after base + seeded jitter
+ *   latency at the order price moved by fixed, size-proportional and seeded
+ *   noise slippage, optionally split into several partial fills.
+ * - Order book (match_against_book): market data ticks from onMarketData()
+ *   are turned into quotes in a per-symbol price-time priority book, and
+ *   orders arrive at the book after the sampled latency as marketable limit
+ *   orders. They fill against the quotes level by level, rest in the queue
+ *   if not fully filled, fill later when the market trades through them and
+ *   are cancelled after resting_timeout_ns.
+ *
+ * Given the same seed, market data, orders and poll times, the fills are
+ * identical run to run.
+ */
+class ExchangeSimulator {
+public:
+    struct Settings {
+        std::uint64_t seed;
+        std::int64_t base_latency_ns;          // Order-to-fill latency floor
+        std::int64_t latency_jitter_ns;        // Uniform jitter added to the floor
+        double slippage_bps;                   // Fixed adverse slippage
+        double impact_bps_per_unit;            // Additional slippage per unit of quantity
+        double slippage_noise_bps;             // Uniform noise (+/-) on top
+        double partial_fill_probability;       // Share of orders filled in pieces
+        int max_partial_fills;                 // Upper bound on pieces per order
+        std::int64_t partial_fill_interval_ns; // Spacing between pieces
+        std::size_t max_pending_fills;         // Timer wheel capacity
+
+        // Order book model
+        bool match_against_book;               // Fill against quotes built from market data
+        double tick_size;                      // Book price increment
+        double quote_half_spread_bps;          // Quoted half spread around each tick
+        int quote_levels;                      // Levels quoted on each side per tick
+        double limit_slippage_bps;             // How far past its price an order may fill
+        std::int64_t resting_timeout_ns;       // Cancel unfilled remainders after this
+        std::size_t book_levels;               // Price levels per side per symbol
+        std::size_t max_working_orders;        // Simulated orders live at once
+
+        static Settings defaults();
+    };
+
+    struct Statistics {
+        std::uint64_t orders_submitted;
+        std::uint64_t orders_rejected;   // Timer wheel or working order pool full
+        std::uint64_t fills_generated;
+        std::uint64_t partial_fills;
+        std::size_t pending_fills;
+        std::uint64_t book_events;       // Quote adds and cancels applied to the books
+        std::uint64_t orders_expired;    // Cancelled after resting_timeout_ns
+        std::size_t working_orders;      // Resting in a book or on the way to one
+    };
+
+    explicit ExchangeSimulator(const Settings& settings = Settings::defaults());
+
+    /**
+     * @brief Reconfigure and reseed the venue; call before submitting orders
+     */
+    void configure(const Settings& settings);
+
+    /**
+     * @brief Submit an order at simulated time now_ns and schedule its fills
+     * @return false if the order was rejected because too many fills are pending
+     */
+    bool submitOrder(const TradingOrder& order, OrderId order_id, std::int64_t now_ns);
+
+    /**
+     * @brief Requote the symbol's book around a market data tick
+     *
+     * Only used by the order book model. Resting orders the new quotes trade
+     * through are filled; the fills are delivered by the next poll().
+     */
+    void onMarketData(const MarketDataMessage& message, std::int64_t now_ns);
+
+    /**
+     * @brief Process venue events due at or before now_ns and deliver fills
+     * @param handler Called with each SimulatedFill in deterministic order
+     * @return Number of fills delivered
+     */
+    template <typename Handler>
+    int poll(std::int64_t now_ns, Handler&& handler) {
+        pending_.advance(now_ns, [&](std::int64_t, const VenueEvent& event) {
+            onEvent(event, now_ns);
+        });
+
+        int fills = 0;
+        for (const SimulatedFill& fill : ready_fills_) {
+            handler(fill);
+            fills++;
+        }
+        ready_fills_.clear();
+        statistics_.fills_generated += static_cast<std::uint64_t>(fills);
+        return fills;
+    }
+
+    bool hasPendingFills() const { return !pending_.empty() || !ready_fills_.empty(); }
+
+    Statistics getStatistics() const;
+
+private:
+    struct VenueEvent {
+        enum class Kind : std::uint8_t { FILL, ARRIVAL, EXPIRY };
+        Kind kind;
+        std::uint32_t working_index;  // EXPIRY: slot in working_
+        SimulatedFill fill;           // FILL: the fill; ARRIVAL/EXPIRY: the order
+    };
+
+    // A simulated order between arrival and its final fill
+    struct WorkingOrder {
+        SimulatedFill order;          // price/quantity hold the order's limit and size
+        double remaining;
+        SymbolId symbol;
+        OrderBook::OrderHandle handle;
+        bool active;
+    };
+
+    struct SymbolBook {
+        OrderBook book;
+        std::vector<OrderBook::OrderHandle> quotes;  // Current market liquidity
+    };
+
+    Settings settings_;
+    DeterministicRng rng_;
+    TimerWheel<VenueEvent> pending_;
+    std::vector<SimulatedFill> ready_fills_;
+    Statistics statistics_;
+
+    SymbolTable symbols_;
+    std::vector<SymbolBook> books_;
+    std::vector<WorkingOrder> working_;
+    std::vector<std::uint32_t> free_working_;
+
+    std::int64_t sampleLatency();
+    double samplePrice(const TradingOrder& order);
+    std::int64_t toTicks(double price) const;
+
+    void onEvent(const VenueEvent& event, std::int64_t now_ns);
+    void onArrival(const SimulatedFill& order, std::int64_t now_ns);
+    void onExpiry(std::uint32_t working_index, OrderId order_id, std::int64_t now_ns);
+    void onMatch(SymbolBook& state, const OrderBook::Match& match, std::int64_t now_ns);
+    void emitWorkingFill(std::uint32_t working_index, double price, double quantity,
+                         ExecutionStatus status, std::int64_t now_ns);
+    SymbolBook* bookFor(const char* symbol, SymbolId& id);
+};
+
+} // namespace trading
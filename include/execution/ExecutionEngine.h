@@ -2,43 +2,28 @@
 
 #include <aeron/Aeron.h>
 #include <aeron/Subscription.h>
+#include <aeron/Publication.h>
+#include <aeron/FragmentAssembler.h>
 #include <memory>
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <vector>
 
-#include "strategy/StrategyEngine.h"
+#include "common/AdaptivePollLimit.h"
+#include "common/HopTimestamps.h"
+#include "common/RollingStatistics.h"
+#include "common/SymbolTable.h"
 #include "common/TimeUtils.h"
 #include "common/Logger.h"
+#include "strategy/StrategyEngine.h"
+#include "execution/ExecutionMessages.h"
+#include "execution/ExchangeSimulator.h"
+#include "execution/PositionKeeper.h"
+#include "execution/TradeJournal.h"
 
 namespace trading {
 
-/**
- * @brief Execution status
- */
-enum class ExecutionStatus {
-    PENDING,
-    FILLED,
-    PARTIALLY_FILLED,
-    REJECTED,
-    CANCELLED
-};
-
-/**
- * @brief Trade execution record
- */
-struct TradeExecution {
-    std::int64_t execution_timestamp;
-    std::string order_id;
-    SignalType signal;
-    double executed_price;
-    double executed_quantity;
-    ExecutionStatus status;
-    char symbol[16];
-    std::int64_t execution_latency_ns;  // Time from order to execution
-};
-
 /**
  * @brief Performance metrics
  */
@@ -49,10 +34,14 @@ struct PerformanceMetrics {
     std::uint64_t winning_trades;
     std::uint64_t losing_trades;
     double max_drawdown;
-    double sharpe_ratio;
+    double current_drawdown;
+    double sharpe_ratio;    // Over the last kReturnWindow fills
+    double sortino_ratio;   // Over the last kReturnWindow fills
     double avg_trade_pnl;
     std::int64_t avg_execution_latency_ns;
     std::int64_t max_execution_latency_ns;
+    std::uint64_t reports_published;
+    std::uint64_t reports_dropped;   // Not connected or back pressured
 };
 
 /**
@@ -60,6 +49,8 @@ struct PerformanceMetrics {
  */
 class ExecutionEngine {
 public:
+    static constexpr std::size_t kReturnWindow = 252;  // Fills in the rolling ratio window
+    
     ExecutionEngine();
     ~ExecutionEngine();
     
@@ -74,6 +65,24 @@ public:
                    const std::string& input_channel,
                    std::int32_t input_stream_id);
     
+    /**
+     * @brief Subscribe to market data for the simulated venue's books and mark-to-market
+     * @param market_data_channel Market data channel
+     * @param market_data_stream_id Market data stream ID
+     * @return true if successful; call after initialize() and before start()
+     */
+    bool subscribeMarketData(const std::string& market_data_channel,
+                            std::int32_t market_data_stream_id);
+    
+    /**
+     * @brief Publish an ExecutionReport for every execution
+     * @param report_channel Execution report channel
+     * @param report_stream_id Execution report stream ID
+     * @return true if successful; does not wait for a subscriber
+     */
+    bool publishExecutionReports(const std::string& report_channel,
+                                std::int32_t report_stream_id);
+    
     /**
      * @brief Start the execution engine
      */
@@ -101,13 +110,97 @@ public:
      */
     void setInitialCapital(double capital) { initial_capital_ = capital; }
     
+    /**
+     * @brief Mark open positions to the subscribed market data
+     *
+     * Unrealized PnL, exposure and drawdown then follow market prices rather
+     * than only moving on fills. Needs subscribeMarketData().
+     */
+    void setMarkToMarket(bool enable) { mark_to_market_ = enable; }
+    
+    /**
+     * @brief Open the trade journal, resuming it if it already exists
+     *
+     * Executions already in the journal are replayed into the performance
+     * metrics, so a restarted engine picks up its positions and PnL, and
+     * order ids continue in the session after the last journaled one.
+     * @param base_path Path prefix of the journal segment files
+     * @param segment_capacity Records per segment file
+     * @return true if successful; call before start()
+     */
+    bool openTradeJournal(const std::string& base_path,
+                          std::uint64_t segment_capacity = TradeJournal::kDefaultSegmentCapacity);
+    
+    /**
+     * @brief Configure the simulated venue (latency, slippage, partial fills, seed)
+     * @param settings Venue settings; call before start()
+     */
+    void configureSimulatedVenue(const ExchangeSimulator::Settings& settings) { exchange_.configure(settings); }
+    
+    /**
+     * @brief Set the engine and session packed into generated order ids
+     * @param engine_id Distinguishes execution engines sharing a venue
+     * @param session_id Distinguishes restarts; defaults to the startup time
+     *        in seconds modulo 65536, or to the session after the trade
+     *        journal's last order once openTradeJournal() has run
+     */
+    void setOrderIdSource(std::uint8_t engine_id, std::uint16_t session_id) {
+        engine_id_ = engine_id;
+        session_id_ = session_id;
+    }
+    
+    /**
+     * @brief Get simulated venue statistics
+     */
+    ExchangeSimulator::Statistics getVenueStatistics() const;
+    
     /**
      * @brief Get current performance metrics
      */
     PerformanceMetrics getPerformanceMetrics() const;
+
+    /**
+     * @brief Get portfolio totals (realized/unrealized PnL, exposure)
+     */
+    PortfolioSnapshot getPortfolio() const;
+    
+    /**
+     * @brief Get the signed position in a symbol
+     */
+    double getPosition(const std::string& symbol) const;
+    
+    /**
+     * @brief Set the fragment limit range used when polling trading orders
+     * @param min_limit Limit under light load
+     * @param max_limit Limit when backlogged (equal to min_limit for a fixed limit)
+     */
+    void setPollLimits(int min_limit, int max_limit) {
+        poll_limit_.setLimits(min_limit, max_limit);
+        market_data_poll_limit_.setLimits(min_limit, max_limit);
+    }
+    
+    /**
+     * @brief Get poll batch statistics (chosen limits and fragments per poll)
+     */
+    AdaptivePollLimit::Statistics getPollStatistics() const { return poll_limit_.getStatistics(); }
+    
+    /**
+     * @brief Get poll batch statistics for the venue market data subscription
+     */
+    AdaptivePollLimit::Statistics getMarketDataPollStatistics() const {
+        return market_data_poll_limit_.getStatistics();
+    }
+    
+    /**
+     * @brief Get tick-to-trade latency with its per-hop breakdown
+     */
+    LatencyBreakdown getLatencyBreakdown() const;
     
     /**
      * @brief Get trade history
+     *
+     * Reads the trade journal from the start without blocking the execution
+     * thread; cost grows with the journal, so use it for reports only.
      */
     std::vector<TradeExecution> getTradeHistory() const;
     
@@ -115,51 +208,98 @@ public:
      * @brief Reset performance tracking
      */
     void resetPerformanceTracking();
+    
+    // Processing steps. processLoop() calls these on the processing thread
+    // as fragments arrive; an engine that was never initialized can be
+    // driven through them directly.
+    
+    /**
+     * @brief Execute one decoded trading order
+     */
+    void handleOrder(const TradingOrder& order);
+    
+    /**
+     * @brief Requote the simulated venue and stage a mark for one tick
+     */
+    void handleMarketData(const MarketDataMessage& message, std::int64_t now_ns);
+    
+    /**
+     * @brief Deliver the simulated fills due by now_ns
+     * @return Fills delivered
+     */
+    int pollSimulatedVenue(std::int64_t now_ns);
+    
+    /**
+     * @brief Mark positions to the last staged price of each ticked symbol
+     */
+    void applyMarks();
 
 private:
     std::shared_ptr<aeron::Aeron> aeron_;
     std::shared_ptr<aeron::Subscription> input_subscription_;
+    std::shared_ptr<aeron::Subscription> market_data_subscription_;  // Venue books and marks
+    std::shared_ptr<aeron::Publication> report_publication_;
     
     std::atomic<bool> running_;
     std::unique_ptr<std::thread> processing_thread_;
+    AdaptivePollLimit poll_limit_;
+    AdaptivePollLimit market_data_poll_limit_;
     
     // Execution settings
     bool simulation_mode_;
     double initial_capital_;
     double current_capital_;
-    double current_position_;  // Current position size
+    bool mark_to_market_;
+    
+    // Simulated venue; only touched by the processing thread
+    ExchangeSimulator exchange_;
+    ExchangeSimulator::Statistics venue_statistics_;  // Snapshot, guarded by performance_mutex_
     
-    // Trade tracking
-    mutable std::mutex trades_mutex_;
-    std::vector<TradeExecution> trade_history_;
+    // Trade tracking; the journal is appended to by the processing thread only
+    TradeJournal trade_journal_;
     std::uint64_t order_counter_;
+    std::uint8_t engine_id_;
+    std::uint16_t session_id_;
     
     // Performance tracking
     mutable std::mutex performance_mutex_;
     PerformanceMetrics performance_metrics_;
-    std::vector<double> daily_returns_;
-    double peak_capital_;
+    LatencyBreakdown latency_breakdown_;
+    SymbolTable symbols_;
+    PositionKeeper positions_;         // Indexed by symbols_ ids
+    RollingStatistics trade_returns_;  // Per-fill return on initial capital
+    DrawdownTracker drawdown_;         // On equity: capital plus unrealized PnL
+    
+    // Latest price per symbol id seen this duty cycle; processing thread only
+    std::vector<double> pending_marks_;  // 0 when no mark is pending
+    std::vector<SymbolId> marked_symbols_;
+    
+    // Joins order batches Aeron split across MTU-sized fragments
+    aeron::FragmentAssembler order_assembler_;
     
     // Processing methods
     void processLoop();
     void processOrder(const aeron::concurrent::AtomicBuffer& buffer,
                      util::index_t offset,
                      util::index_t length);
+    void processMarketData(const aeron::concurrent::AtomicBuffer& buffer,
+                          util::index_t offset,
+                          util::index_t length);
     
     // Execution methods
-    TradeExecution executeOrder(const TradingOrder& order);
-    TradeExecution simulateExecution(const TradingOrder& order);
+    void submitSimulatedOrder(const TradingOrder& order);
+    void onSimulatedFill(const SimulatedFill& fill);
     TradeExecution executeLiveOrder(const TradingOrder& order);
+    void recordExecution(const TradeExecution& execution);
+    void publishExecutionReport(const TradeExecution& execution);
     
     // Performance calculation methods
     void updatePerformanceMetrics(const TradeExecution& execution);
-    double calculatePnL(const TradeExecution& execution) const;
-    void updateDrawdown(double current_pnl);
-    double calculateSharpeRatio() const;
+    void stageMark(const MarketDataMessage& message);
+    void updateEquity();  // Requires performance_mutex_
     
     // Utility methods
-    std::string generateOrderId();
-    double getMarketPrice(const std::string& symbol) const;  // For simulation
+    OrderId generateOrderId();
 };
 
 } // namespace trading 
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "common/HopTimestamps.h"
+#include "execution/OrderId.h"
+#include "strategy/StrategyMessages.h"
+
+namespace trading {
+
+/**
+ * @brief Execution status
+ */
+enum class ExecutionStatus {
+    PENDING,
+    FILLED,
+    PARTIALLY_FILLED,
+    REJECTED,
+    CANCELLED
+};
+
+/**
+ * @brief Trade execution record
+ *
+ * Trivially copyable so recording an execution is a plain copy; format the
+ * order id with formatOrderId() when reporting.
+ */
+struct TradeExecution {
+    std::int64_t execution_timestamp;
+    OrderId order_id;
+    SignalType signal;
+    std::uint16_t strategy_id;          // From the order
+    double executed_price;
+    double executed_quantity;
+    ExecutionStatus status;
+    char symbol[16];
+    std::int64_t execution_latency_ns;  // Time from order to execution
+    HopTimestamps hops;                 // Tick ingress through execution
+};
+
+static_assert(std::is_trivially_copyable<TradeExecution>::value,
+              "TradeExecution is copied on the execution path and must not own memory");
+
+/**
+ * @brief Execution report published back to the strategy
+ *
+ * One per execution record: every fill, reject and cancel. FILLED,
+ * REJECTED and CANCELLED end an order; PARTIALLY_FILLED and PENDING do not.
+ * Carries the engine's position after the execution, summed over every
+ * strategy's orders in the symbol. Fits in one cache line.
+ */
+struct ExecutionReport {
+    std::int64_t timestamp;
+    OrderId order_id;
+    double price;
+    double quantity;        // Executed in this report
+    double position;        // Signed position in the symbol after this report
+    char symbol[16];
+    SignalType signal;
+    std::uint8_t reserved;
+    std::uint16_t strategy_id;  // From the order, so each strategy sees its own executions
+    ExecutionStatus status;
+};
+
+static_assert(sizeof(ExecutionReport) == 64, "ExecutionReport should stay one cache line");
+
+} // namespace trading
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace trading {
+
+/**
+ * @brief Price-time priority limit order book for one instrument
+ *
+ * Prices are integer ticks. Each side is an array-indexed price ladder over
+ * a sliding window of 2^n ticks (a ring: level index = ticks & mask), and
+ * each level is an intrusive FIFO of orders threaded through a preallocated
+ * pool by 32-bit indices. A bitmap of non-empty levels per side finds the
+ * next best price a 64-level word at a time when a level empties, so adds,
+ * cancels and fills are O(1) apart from that scan and nothing allocates
+ * after construction.
+ *
+ * The window slides to follow the market as long as the levels it leaves
+ * behind are empty; an order that would need a non-empty level dropped is
+ * rejected instead. Not thread-safe.
+ */
+class OrderBook {
+public:
+    enum class Side : std::uint8_t { BUY, SELL };
+
+    using OrderHandle = std::uint32_t;
+    static constexpr OrderHandle kInvalidOrder = 0xFFFFFFFFu;
+    static constexpr std::int64_t kNoPrice = std::numeric_limits<std::int64_t>::min();
+
+    /**
+     * @brief One maker/taker fill
+     */
+    struct Match {
+        OrderHandle maker;
+        std::uint64_t maker_owner;
+        std::uint64_t taker_owner;
+        std::int64_t price_ticks;  // Maker's price
+        double quantity;
+        bool maker_done;           // Maker fully filled and removed from the book
+    };
+
+    struct AddResult {
+        OrderHandle handle;  // Resting order, or kInvalidOrder if none rests
+        double filled;       // Quantity matched on entry
+        bool rejected;       // Remainder could not rest (outside the window or pool full)
+    };
+
+    /**
+     * @param levels Price levels per side (rounded up to a power of two, at least 64)
+     * @param max_orders Resting orders the pool can hold
+     */
+    explicit OrderBook(std::size_t levels = 4096, std::size_t max_orders = 4096);
+
+    /**
+     * @brief Match against the opposite side, then rest any remainder
+     * @param owner Caller tag reported in matches (e.g. 0 for market liquidity)
+     * @param on_match Called as on_match(const Match&) for each fill, in priority order
+     */
+    template <typename Handler>
+    AddResult addLimit(Side side, std::int64_t price_ticks, double quantity,
+                       std::uint64_t owner, Handler&& on_match) {
+        AddResult result{kInvalidOrder, 0.0, false};
+        result.filled = match(side, price_ticks, quantity, owner, on_match);
+
+        double remaining = quantity - result.filled;
+        if (remaining > kQuantityEpsilon) {
+            result.handle = rest(side, price_ticks, remaining, owner);
+            result.rejected = (result.handle == kInvalidOrder);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Match against the opposite side up to a limit price; nothing rests
+     * @return Quantity filled
+     */
+    template <typename Handler>
+    double match(Side side, std::int64_t limit_ticks, double quantity,
+                 std::uint64_t owner, Handler&& on_match) {
+        Ladder& book = (side == Side::BUY) ? asks_ : bids_;
+        double filled = 0.0;
+
+        while (quantity - filled > kQuantityEpsilon && book.best != kNoPrice &&
+               (side == Side::BUY ? book.best <= limit_ticks : book.best >= limit_ticks)) {
+            const std::int64_t price = book.best;
+            Level& level = book.levels[levelIndex(price)];
+
+            while (level.head != kInvalidOrder && quantity - filled > kQuantityEpsilon) {
+                const OrderHandle maker = level.head;
+                Order& order = pool_[maker];
+                const double traded = (order.quantity < quantity - filled) ? order.quantity : quantity - filled;
+
+                order.quantity -= traded;
+                level.quantity -= traded;
+                filled += traded;
+
+                const bool done = order.quantity <= kQuantityEpsilon;
+                const std::uint64_t maker_owner = order.owner;
+                if (done) {
+                    unlink(level, maker);
+                }
+                on_match(Match{maker, maker_owner, owner, price, traded, done});
+            }
+
+            if (level.head == kInvalidOrder) {
+                clearLevel(book, price);
+            }
+        }
+        return filled;
+    }
+
+    /**
+     * @brief Remove a resting order
+     * @return false if the handle does not refer to a resting order
+     */
+    bool cancel(OrderHandle handle);
+
+    /**
+     * @brief Remove every resting order and forget the price window
+     */
+    void clear();
+
+    std::int64_t bestBid() const { return bids_.best; }
+    std::int64_t bestAsk() const { return asks_.best; }
+    double remaining(OrderHandle handle) const;
+    double depthAt(Side side, std::int64_t price_ticks) const;
+    std::size_t orderCount() const { return order_count_; }
+    std::size_t levelCount() const { return levels_; }
+
+private:
+    static constexpr double kQuantityEpsilon = 1e-9;
+
+    struct Order {
+        double quantity;
+        std::uint64_t owner;
+        std::int64_t price_ticks;
+        OrderHandle prev;
+        OrderHandle next;
+        Side side;
+        bool active;
+    };
+
+    struct Level {
+        OrderHandle head;
+        OrderHandle tail;
+        double quantity;
+    };
+
+    struct Ladder {
+        std::vector<Level> levels;
+        std::vector<std::uint64_t> occupied;  // Bit per level
+        std::int64_t best;
+    };
+
+    std::size_t levels_;
+    std::uint64_t mask_;
+    std::int64_t window_low_;
+    bool window_set_;
+    Ladder bids_;
+    Ladder asks_;
+    std::vector<Order> pool_;
+    OrderHandle free_head_;
+    std::size_t order_count_;
+
+    std::size_t levelIndex(std::int64_t price_ticks) const {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(price_ticks) & mask_);
+    }
+
+    bool inWindow(std::int64_t price_ticks) const {
+        return window_set_ && price_ticks >= window_low_ &&
+               price_ticks - window_low_ < static_cast<std::int64_t>(levels_);
+    }
+
+    OrderHandle rest(Side side, std::int64_t price_ticks, double quantity, std::uint64_t owner);
+    void unlink(Level& level, OrderHandle handle);
+    void clearLevel(Ladder& book, std::int64_t price_ticks);
+    bool slideWindowTo(std::int64_t price_ticks);
+    bool rangeOccupied(std::int64_t from_ticks, std::int64_t to_ticks) const;
+    std::int64_t scanUp(const Ladder& book, std::int64_t from_ticks, std::int64_t to_ticks) const;
+    std::int64_t scanDown(const Ladder& book, std::int64_t from_ticks, std::int64_t to_ticks) const;
+};
+
+} // namespace trading
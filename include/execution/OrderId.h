@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace trading {
+
+/**
+ * @brief Packed 64-bit order id: engine (8 bits) | session (16 bits) | sequence (40 bits)
+ *
+ * Built with a few shifts on the execution path; only turned into text by
+ * formatOrderId() when reporting. Sessions are unique for 65536 restarts
+ * of an engine that resumes its trade journal; without a journal the
+ * session is the startup time in seconds, which repeats every ~18.2 hours,
+ * so two runs 65536 s apart can produce the same ids.
+ */
+using OrderId = std::uint64_t;
+
+constexpr int kOrderIdSequenceBits = 40;
+constexpr int kOrderIdSessionBits = 16;
+constexpr std::uint64_t kOrderIdSequenceMask = (1ull << kOrderIdSequenceBits) - 1;
+constexpr std::uint64_t kOrderIdSessionMask = (1ull << kOrderIdSessionBits) - 1;
+
+constexpr OrderId makeOrderId(std::uint8_t engine_id, std::uint16_t session_id, std::uint64_t sequence) {
+    return (static_cast<std::uint64_t>(engine_id) << (kOrderIdSequenceBits + kOrderIdSessionBits)) |
+           (static_cast<std::uint64_t>(session_id) << kOrderIdSequenceBits) |
+           (sequence & kOrderIdSequenceMask);
+}
+
+constexpr std::uint8_t orderIdEngine(OrderId id) {
+    return static_cast<std::uint8_t>(id >> (kOrderIdSequenceBits + kOrderIdSessionBits));
+}
+
+constexpr std::uint16_t orderIdSession(OrderId id) {
+    return static_cast<std::uint16_t>((id >> kOrderIdSequenceBits) & kOrderIdSessionMask);
+}
+
+constexpr std::uint64_t orderIdSequence(OrderId id) {
+    return id & kOrderIdSequenceMask;
+}
+
+/**
+ * @brief Human-readable form for reports and logs: ORDER_<engine>_<session>_<sequence>
+ */
+inline std::string formatOrderId(OrderId id) {
+    return "ORDER_" + std::to_string(orderIdEngine(id)) + "_" +
+           std::to_string(orderIdSession(id)) + "_" +
+           std::to_string(orderIdSequence(id));
+}
+
+} // namespace trading
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "common/SymbolTable.h"
+
+namespace trading {
+
+/**
+ * @brief Portfolio-level totals maintained by PositionKeeper
+ */
+struct PortfolioSnapshot {
+    double realized_pnl;
+    double unrealized_pnl;
+    double gross_exposure;  // Sum of |position| * last price
+    double net_exposure;    // Sum of position * last price
+    std::size_t open_positions;
+};
+
+/**
+ * @brief Per-symbol positions and PnL in flat arrays indexed by symbol id
+ *
+ * Position, average cost, last price and realized/unrealized PnL are kept
+ * as separate arrays (structure of arrays) so that marking one symbol
+ * touches a handful of doubles. Average-cost accounting: fills that add to
+ * a position move the average cost, fills that reduce it realize
+ * (price - average cost) on the closed quantity. Portfolio totals are
+ * adjusted by each symbol's change on every fill and price update, so they
+ * never require a scan. Not thread-safe.
+ */
+class PositionKeeper {
+public:
+    explicit PositionKeeper(std::size_t expected_symbols = 64);
+
+    /**
+     * @brief Apply a fill
+     * @param id Symbol id
+     * @param quantity Signed quantity (positive buys, negative sells)
+     * @param price Fill price; also becomes the symbol's last price
+     * @return Realized PnL from this fill
+     */
+    double onFill(SymbolId id, double quantity, double price);
+
+    /**
+     * @brief Mark a symbol to a new price
+     */
+    void onPrice(SymbolId id, double price);
+
+    double position(SymbolId id) const { return id < size_ ? position_[id] : 0.0; }
+    double averageCost(SymbolId id) const { return id < size_ ? average_cost_[id] : 0.0; }
+    double lastPrice(SymbolId id) const { return id < size_ ? last_price_[id] : 0.0; }
+    double realizedPnl(SymbolId id) const { return id < size_ ? realized_[id] : 0.0; }
+    double unrealizedPnl(SymbolId id) const { return id < size_ ? unrealized_[id] : 0.0; }
+
+    const PortfolioSnapshot& portfolio() const { return portfolio_; }
+    std::size_t symbolCount() const { return size_; }
+
+    void reset();
+
+private:
+    std::size_t size_;
+    std::vector<double> position_;
+    std::vector<double> average_cost_;
+    std::vector<double> last_price_;
+    std::vector<double> realized_;
+    std::vector<double> unrealized_;
+    PortfolioSnapshot portfolio_;
+
+    void ensure(SymbolId id);
+
+    // Take the symbol's contribution out of the totals before changing it, then put it back
+    void removeFromTotals(SymbolId id);
+    void addToTotals(SymbolId id);
+};
+
+} // namespace trading
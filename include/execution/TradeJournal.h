@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "common/MappedFile.h"
+#include "execution/ExecutionMessages.h"
+
+namespace trading {
+
+/**
+ * @brief On-disk layout shared by the journal writer and readers
+ *
+ * A journal is a sequence of fixed-size segment files <base>.000000,
+ * <base>.000001, ... each holding a header and segment_capacity
+ * TradeExecution records. A segment appears under its final name only once
+ * its header is complete (it is created under a temporary name and renamed),
+ * and its record count is published with release semantics after each
+ * record is written.
+ */
+struct TradeJournalSegment {
+    static constexpr std::uint64_t kMagic = 0x4C4E524A5254ull;  // "TRJRNL"
+
+    struct Header {
+        std::uint64_t magic;
+        std::uint32_t record_size;
+        std::uint32_t reserved;
+        std::uint64_t capacity;
+        std::uint64_t segment_index;
+        std::uint64_t first_record;                    // Journal-wide index of record 0
+        alignas(64) std::atomic<std::uint64_t> count;  // Written by the appender only
+    };
+
+    static std::size_t recordsOffset() {
+        // Keep records cache-line aligned after the header
+        return (sizeof(Header) + 63) & ~static_cast<std::size_t>(63);
+    }
+
+    static std::size_t fileSize(std::uint64_t capacity) {
+        return recordsOffset() + capacity * sizeof(TradeExecution);
+    }
+
+    static std::string path(const std::string& base_path, std::uint64_t segment_index);
+};
+
+/**
+ * @brief Append-only memory-mapped journal of executions (single writer)
+ *
+ * append() is a record copy and a release store, with no locks or
+ * allocation until a segment fills and the next one is created. Only the
+ * current segment is mapped, and pages behind the tail are dropped from the
+ * resident set as the writer moves on, so resident memory stays bounded
+ * however long the session runs. open() resumes an existing journal at its
+ * tail; TradeJournalReader replays it from the start.
+ */
+class TradeJournal {
+public:
+    static constexpr std::uint64_t kDefaultSegmentCapacity = 1 << 18;  // ~30MB per segment
+
+    TradeJournal() = default;
+
+    /**
+     * @brief Open a journal for appending, resuming after the last record if it exists
+     * @param base_path Path prefix of the segment files
+     * @param segment_capacity Records per new segment
+     * @return true if successful
+     */
+    bool open(const std::string& base_path, std::uint64_t segment_capacity = kDefaultSegmentCapacity);
+
+    /**
+     * @brief Append an execution
+     * @return false if the journal is not open or the next segment could not be created
+     */
+    bool append(const TradeExecution& execution);
+
+    /**
+     * @brief Unmap the current segment
+     */
+    void close();
+
+    /**
+     * @brief Total records in the journal
+     */
+    std::uint64_t size() const;
+
+    bool isOpen() const { return header_ != nullptr; }
+    const std::string& basePath() const { return base_path_; }
+
+private:
+    static constexpr std::size_t kReleaseChunk = 1 << 20;  // Drop written pages 1MB at a time
+
+    std::string base_path_;
+    std::uint64_t segment_capacity_ = kDefaultSegmentCapacity;
+    MappedFile file_;
+    TradeJournalSegment::Header* header_ = nullptr;
+    TradeExecution* records_ = nullptr;
+    std::size_t released_bytes_ = 0;
+
+    bool createSegment(std::uint64_t segment_index, std::uint64_t first_record);
+    bool mapSegment(std::uint64_t segment_index);
+};
+
+/**
+ * @brief Follows a trade journal from the first record to the live tail
+ *
+ * poll() never blocks or waits for the writer: it copies whatever records
+ * have been published and returns. Like the writer it maps one segment at
+ * a time and drops pages it has read.
+ */
+class TradeJournalReader {
+public:
+    TradeJournalReader() = default;
+
+    /**
+     * @brief Start reading a journal from its first record
+     * @return true if the first segment exists
+     */
+    bool open(const std::string& base_path);
+
+    /**
+     * @brief Deliver records published since the last poll
+     * @param handler Called with each TradeExecution in journal order
+     * @param limit Maximum records to deliver
+     * @return Number of records delivered
+     */
+    template <typename Handler>
+    int poll(Handler&& handler, int limit) {
+        int delivered = 0;
+        while (header_ != nullptr && delivered < limit) {
+            const std::uint64_t count = header_->count.load(std::memory_order_acquire);
+            while (offset_ < count && delivered < limit) {
+                TradeExecution execution;
+                std::memcpy(&execution, &records_[offset_], sizeof(TradeExecution));
+                offset_++;
+                delivered++;
+                handler(static_cast<const TradeExecution&>(execution));
+            }
+            releaseRead();
+
+            // Move on only once this segment is complete and the next one exists
+            if (offset_ < header_->capacity || !nextSegment()) {
+                break;
+            }
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief Journal-wide index of the next record to be delivered
+     */
+    std::uint64_t position() const { return header_ ? header_->first_record + offset_ : 0; }
+
+    bool isOpen() const { return header_ != nullptr; }
+
+private:
+    static constexpr std::size_t kReleaseChunk = 1 << 20;
+
+    std::string base_path_;
+    std::uint64_t segment_index_ = 0;
+    MappedFile file_;
+    const TradeJournalSegment::Header* header_ = nullptr;
+    const TradeExecution* records_ = nullptr;
+    std::uint64_t offset_ = 0;
+    std::size_t released_bytes_ = 0;
+
+    bool mapSegment(std::uint64_t segment_index);
+    bool nextSegment();
+    void releaseRead();
+};
+
+} // namespace trading
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/DCIndicator.h"
+#include "common/HopTimestamps.h"
+
+namespace trading {
+
+/**
+ * @brief Market data message structure
+ */
+struct MarketDataMessage {
+    std::uint64_t sequence_number;  // Per-stream sequence, contiguous from 1
+    std::int64_t timestamp;
+    double price;
+    double volume;
+    char symbol[16];
+};
+
+/**
+ * @brief DC signal message structure for publishing
+ */
+struct DCSignalMessage {
+    std::int64_t timestamp;
+    DCEventType event_type;
+    std::uint8_t theta_index;  // Rung of the symbol's theta ladder, 0 for its configured theta
+    std::uint8_t synthetic;    // 1 when the symbol is a synthetic priced from its legs, not a tradable one
+    double price;
+    double tmv_ext;
+    std::int64_t duration;
+    double time_adjusted_return;
+    double theta;        // Configured DC threshold of the detector; an adaptive one varies around it
+    char symbol[16];
+    HopTimestamps hops;  // Feed receive, DC detected and signal published
+};
+
+} // namespace trading
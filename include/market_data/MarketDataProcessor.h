@@ -12,36 +12,22 @@
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <array>
+#include <vector>
 
 #include "common/DCIndicator.h"
+#include "common/AdaptivePollLimit.h"
+#include "common/Rcu.h"
+#include "common/SymbolParameters.h"
+#include "common/SymbolTable.h"
 #include "common/TimeUtils.h"
 #include "common/Logger.h"
+#include "market_data/MarketDataMessages.h"
+#include "market_data/MarketDataRecording.h"
+#include "market_data/SyntheticInstruments.h"
 
 namespace trading {
 
-/**
- * @brief Market data message structure
- */
-struct MarketDataMessage {
-    std::int64_t timestamp;
-    double price;
-    double volume;
-    char symbol[16];
-};
-
-/**
- * @brief DC signal message structure for publishing
- */
-struct DCSignalMessage {
-    std::int64_t timestamp;
-    DCEventType event_type;
-    double price;
-    double tmv_ext;
-    std::int64_t duration;
-    double time_adjusted_return;
-    char symbol[16];
-};
-
 /**
  * @brief Market Data Processor - receives market data and detects DC events
  */
@@ -82,11 +68,69 @@ public:
     bool isRunning() const { return running_.load(); }
     
     /**
-     * @brief Set DC threshold
-     * @param theta New threshold value
+     * @brief Set one DC threshold for every symbol
+     * @param theta New threshold value; replaces any per-symbol thresholds
      */
     void setDCThreshold(double theta);
     
+    /**
+     * @brief Set per-symbol DC thresholds
+     *
+     * Safe while running: the processing thread applies the new thresholds
+     * to every symbol at the top of its next duty cycle, and this call
+     * returns once the old table is no longer in use. Symbols seen later
+     * take their threshold from the table when they first tick.
+     */
+    void setSymbolParameters(std::unique_ptr<SymbolParameterTable> parameters);
+    
+    /**
+     * @brief Let each symbol's threshold follow its realized volatility
+     *
+     * Bounds are multiples of the symbol's configured theta. Signals keep
+     * carrying the configured theta, so strategies' theta subsets still
+     * match. Set before start().
+     */
+    void setAdaptiveTheta(const AdaptiveThetaSettings& settings) { adaptive_theta_ = settings; }
+    
+    /**
+     * @brief Detect DC events at several multiples of each symbol's theta
+     *
+     * Each symbol runs one indicator per scale, at its configured theta
+     * times the scale. Signals carry the rung's theta and its index in the
+     * ladder, which the strategy engine's theta ensemble votes over. With
+     * an adaptive threshold each rung targets the event interval times its
+     * scale squared. Set before start().
+     * @param scales Multiples of the symbol's theta; the default is {1.0}
+     * @return false if there are no or more than kMaxThetaLadder scales, or
+     *         one is not positive
+     */
+    bool setThetaLadder(const std::vector<double>& scales);
+    
+    static constexpr std::size_t kMaxThetaLadder = 64;
+    
+    /**
+     * @brief Detect DC events on spreads, ratios and baskets of traded symbols
+     *
+     * A synthetic is repriced whenever one of its legs ticks and runs
+     * through the theta ladder like a traded symbol, taking its theta from
+     * the symbol parameters under its name and publishing signals under it
+     * with the leg's timestamp. Thresholds are relative, so values at or
+     * below zero are skipped: give spreads and baskets an offset that
+     * keeps them positive. Set before start().
+     * @param error Set to the first problem found
+     * @return false, keeping the current synthetics, if running or a
+     *         definition is invalid
+     */
+    bool setSyntheticInstruments(const std::vector<Config::SyntheticConfig>& synthetics, std::string& error);
+    
+    /**
+     * @brief Enable replay of sequence gaps from a local recording
+     * @param recording_file Recording written by the feed publisher
+     * @param max_replay_per_cycle Recorded messages replayed per duty cycle, so
+     *        recovery never holds up live ticks for more than one bounded slice
+     */
+    void enableGapRecovery(const std::string& recording_file, int max_replay_per_cycle);
+    
     /**
      * @brief Get processing statistics
      */
@@ -95,19 +139,76 @@ public:
         std::uint64_t dc_events_detected;
         std::int64_t avg_processing_latency_ns;
         std::int64_t max_processing_latency_ns;
+        std::uint64_t sequence_gaps;           // Gaps detected on the stream
+        std::uint64_t messages_lost;           // Messages missing from those gaps
+        std::uint64_t messages_recovered;      // Missing messages replayed from the recording
+        std::uint64_t late_extremes_applied;   // Replayed ticks that corrected a symbol's extreme
+        std::uint64_t unrecoverable_messages;  // Missing messages the recording could not supply
+        std::uint64_t duplicate_messages;      // Messages at or below the expected sequence
+        std::uint64_t sequence_resets;         // Backward jumps taken as a publisher restart
+        std::uint64_t synthetic_ticks;         // Synthetic values run through DC detection
+        std::uint64_t synthetic_ticks_skipped; // Synthetic values at or below zero
     };
     
     Statistics getStatistics() const;
 
+    /**
+     * @brief Set the fragment limit range used when polling market data
+     * @param min_limit Limit under light load
+     * @param max_limit Limit when backlogged (equal to min_limit for a fixed limit)
+     */
+    void setPollLimits(int min_limit, int max_limit) { poll_limit_.setLimits(min_limit, max_limit); }
+    
+    /**
+     * @brief Get poll batch statistics (chosen limits and fragments per poll)
+     */
+    AdaptivePollLimit::Statistics getPollStatistics() const { return poll_limit_.getStatistics(); }
+
 private:
     std::shared_ptr<aeron::Aeron> aeron_;
     std::shared_ptr<aeron::Subscription> input_subscription_;
     std::shared_ptr<aeron::Publication> output_publication_;
     
-    std::unique_ptr<DCIndicator> dc_indicator_;
+    // Per-symbol DC state, indexed by symbol id; the indicators of a symbol
+    // are contiguous, one per rung of the theta ladder
+    SymbolTable symbols_;
+    std::vector<double> theta_scales_;
+    std::vector<DCIndicator> dc_indicators_;
+    std::vector<std::uint64_t> last_sequence_;  // Last sequence applied per symbol
+    SyntheticInstruments synthetics_;           // Share the per-symbol state under their own ids
+    
+    // Parameters published by setSymbolParameters(); the processing thread is
+    // the only reader and copies each symbol's theta into its indicator, so
+    // ticks never look the table up
+    RcuDomain rcu_;
+    RcuDomain::ReaderId rcu_reader_;
+    RcuPointer<SymbolParameterTable> parameters_;
+    std::atomic<std::uint64_t> parameters_version_;  // Bumped after each table is published
+    std::uint64_t applied_version_;                  // Processing thread only
+    AdaptiveThetaSettings adaptive_theta_;
+    
+    // Sequence tracking and gap recovery
+    struct GapRange {
+        std::uint64_t next_sequence;  // Next missing sequence to replay
+        std::uint64_t last_sequence;  // Last missing sequence (inclusive)
+        std::int64_t detected_ns;
+    };
+    static constexpr std::size_t kMaxPendingGaps = 64;
+    static constexpr std::uint64_t kMaxDuplicateDistance = 4096;  // Further back is a restarted publisher
+    static constexpr std::int64_t kRecoveryTimeoutNs = 1000000000;  // Wait 1s for the recorder
+    
+    std::uint64_t expected_sequence_;  // 0 until the first message
+    std::array<GapRange, kMaxPendingGaps> pending_gaps_;
+    std::size_t gap_head_;
+    std::size_t gap_count_;
+    bool gap_recovery_enabled_;
+    std::string recording_file_;
+    int max_replay_per_cycle_;
+    MarketDataRecording recording_;
     
     std::atomic<bool> running_;
     std::unique_ptr<std::thread> processing_thread_;
+    AdaptivePollLimit poll_limit_;
     
     // Statistics
     mutable std::mutex stats_mutex_;
@@ -115,11 +216,26 @@ private:
     
     // Processing methods
     void processLoop();
+    void applyParameters(const SymbolParameterTable& parameters);
     void processMarketData(const aeron::concurrent::AtomicBuffer& buffer, 
                           util::index_t offset, 
                           util::index_t length);
+    void processTick(const MarketDataMessage& market_data, std::int64_t feed_receive_ns);
+    void processSyntheticTick(SymbolId symbol_id, const MarketDataPoint& data_point, std::int64_t feed_receive_ns);
+    std::uint64_t detectDCEvents(SymbolId symbol_id, const MarketDataPoint& data_point);
+    void publishDCEvents(SymbolId symbol_id, std::uint64_t detected, const HopTimestamps& hops);
+    SymbolId symbolIdFor(const char* symbol);
+    void addSymbolState();
+    
+    // Gap detection and recovery
+    bool checkSequence(std::uint64_t sequence_number);
+    void recordGap(std::uint64_t first_missing, std::uint64_t last_missing);
+    void resetSequence(std::uint64_t sequence_number);
+    int replayGaps();
+    void applyRecoveredTick(const MarketDataMessage& market_data);
     
-    bool publishDCSignal(const DCEvent& dc_event, const std::string& symbol);
+    bool publishDCSignal(const DCEvent& dc_event, const std::string& symbol, double theta, std::uint8_t theta_index,
+                         bool synthetic, HopTimestamps hops);
     
     // Latency tracking
     void updateLatencyStats(std::int64_t latency_ns);
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "common/MappedFile.h"
+#include "market_data/MarketDataMessages.h"
+
+namespace trading {
+
+/**
+ * @brief Local recording of a market data stream, indexed by sequence number
+ *
+ * Fixed-size records in a memory-mapped file: the record for sequence s lives
+ * at slot s - first_sequence, so a missing range is replayed with direct
+ * indexing. One process appends (the feed publisher or a recorder), any number
+ * of processes read; the record count is published with release semantics
+ * after each record is written.
+ */
+class MarketDataRecording {
+public:
+    MarketDataRecording() = default;
+
+    /**
+     * @brief Create a new recording for writing
+     * @param path Recording file path
+     * @param capacity Maximum number of records
+     * @return true if successful
+     */
+    bool create(const std::string& path, std::uint64_t capacity);
+
+    /**
+     * @brief Open an existing recording for reading
+     * @param path Recording file path
+     * @return true if successful
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Append a message; sequence numbers must be contiguous
+     * @return false if the recording is full or the sequence is out of order
+     */
+    bool append(const MarketDataMessage& message);
+
+    /**
+     * @brief Read the record for a sequence number
+     * @param sequence_number Sequence to read
+     * @param message Output message
+     * @return false if the sequence has not been recorded (yet)
+     */
+    bool read(std::uint64_t sequence_number, MarketDataMessage& message) const;
+
+    /**
+     * @brief Highest sequence number recorded so far (0 if empty)
+     */
+    std::uint64_t lastSequence() const;
+
+    bool isOpen() const { return header_ != nullptr; }
+    std::uint64_t capacity() const { return header_ ? header_->capacity : 0; }
+
+private:
+    static constexpr std::uint64_t kMagic = 0x4D4452454331ull;  // "MDREC1"
+
+    struct Header {
+        std::uint64_t magic;
+        std::uint32_t record_size;
+        std::uint32_t reserved;
+        std::uint64_t capacity;
+        std::atomic<std::uint64_t> first_sequence;
+        alignas(64) std::atomic<std::uint64_t> count;  // Written by the appender only
+    };
+
+    MappedFile file_;
+    Header* header_ = nullptr;
+    MarketDataMessage* records_ = nullptr;
+
+    static std::size_t recordsOffset();
+};
+
+} // namespace trading
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/Config.h"
+#include "common/SymbolTable.h"
+
+namespace trading {
+
+/**
+ * @brief Spreads, ratios and baskets priced from the ticks of their legs
+ *
+ * A spread is w0 * p0 - w1 * p1 + offset, a basket sum(wi * pi) + offset
+ * and a ratio (w0 * p0) / (w1 * p1). Each synthetic keeps a running sum
+ * that a leg's tick moves by its weighted change (ratios in log space), so
+ * an update costs the same however many legs there are. The synthetics
+ * that depend on a symbol are one contiguous slice found through an
+ * offsets array indexed by symbol id: a tick touches only those and
+ * allocates nothing. Every kRefreshInterval updates a synthetic is summed
+ * again from all its legs, so rounding does not build up. Processing
+ * thread only.
+ */
+class SyntheticInstruments {
+public:
+    static constexpr std::size_t kMaxLegs = 16;
+    static constexpr std::uint32_t kRefreshInterval = 1024;
+
+    SyntheticInstruments();
+
+    /**
+     * @brief Resolve the configured synthetics against the processor's symbol ids
+     *
+     * Synthetic names and leg symbols are added to the symbol table, so a
+     * synthetic's DC state is keyed like any traded symbol's.
+     * @param error Set to the first problem found
+     * @return false, keeping the current synthetics and adding no symbols,
+     *         if a name or leg symbol is empty or too long, a name is repeated
+     *         or used as a leg, the type is unknown, a spread or ratio does
+     *         not have two legs, a basket has none or more than kMaxLegs, a
+     *         leg is repeated, a weight is zero (or negative for a spread or
+     *         ratio), a ratio has an offset, or the symbol table is full
+     */
+    bool configure(const std::vector<Config::SyntheticConfig>& synthetics, SymbolTable& symbols, std::string& error);
+
+    /**
+     * @brief Apply a tick of a leg to the synthetics that depend on it
+     * @param on_value Called as on_value(synthetic symbol id, value) for each
+     *        dependent synthetic whose legs have all been priced
+     */
+    template <typename OnValue>
+    void onTick(SymbolId symbol_id, double price, OnValue&& on_value) {
+        if (symbol_id >= last_price_.size() || !(price > 0.0) || !std::isfinite(price)) {
+            return;
+        }
+        const double previous = last_price_[symbol_id];
+        last_price_[symbol_id] = price;
+        const double linear_change = price - previous;
+        const double log_change = previous > 0.0 ? std::log(price / previous) : std::log(price);
+
+        for (std::uint32_t i = dependency_offsets_[symbol_id]; i < dependency_offsets_[symbol_id + 1]; ++i) {
+            const Dependency& dependency = dependencies_[i];
+            Synthetic& synthetic = synthetics_[dependency.synthetic];
+            synthetic.sum += dependency.coefficient * (synthetic.ratio ? log_change : linear_change);
+            if (previous == 0.0) {
+                synthetic.unpriced_legs--;
+            }
+            if (synthetic.unpriced_legs != 0) {
+                continue;
+            }
+            if (++synthetic.updates == kRefreshInterval) {
+                refresh(synthetic);
+            }
+            on_value(synthetic.symbol_id, valueOf(synthetic));
+        }
+    }
+
+    /**
+     * @brief Whether a symbol id names a synthetic rather than a traded symbol
+     */
+    bool isSynthetic(SymbolId symbol_id) const {
+        return symbol_id < is_synthetic_.size() && is_synthetic_[symbol_id];
+    }
+
+    std::size_t size() const { return synthetics_.size(); }
+    SymbolId symbolId(std::size_t index) const { return synthetics_[index].symbol_id; }
+
+    /**
+     * @brief Whether every leg of a synthetic has been priced
+     */
+    bool priced(std::size_t index) const { return synthetics_[index].unpriced_legs == 0; }
+
+    /**
+     * @brief Current value from the running sum; only meaningful once priced
+     */
+    double value(std::size_t index) const { return valueOf(synthetics_[index]); }
+
+    /**
+     * @brief Value summed from the last price of every leg
+     */
+    double recompute(std::size_t index) const;
+
+    /**
+     * @brief Synthetics a symbol is a leg of
+     */
+    std::size_t dependents(SymbolId symbol_id) const {
+        return symbol_id < last_price_.size() ?
+            dependency_offsets_[symbol_id + 1] - dependency_offsets_[symbol_id] : 0;
+    }
+
+private:
+    struct Leg {
+        SymbolId symbol_id;
+        double coefficient;   // Weight, signed; +1 or -1 on a ratio's log price
+    };
+
+    struct Dependency {
+        std::uint32_t synthetic;
+        double coefficient;
+    };
+
+    struct Synthetic {
+        SymbolId symbol_id;
+        bool ratio;              // Sum of log prices, value exp(constant + sum)
+        std::uint32_t unpriced_legs;
+        std::uint32_t updates;   // Since the sum was last refreshed
+        double constant;         // Offset, or log(w0 / w1) for a ratio
+        double sum;
+        std::uint32_t first_leg; // legs_[first_leg, last_leg)
+        std::uint32_t last_leg;
+    };
+
+    std::vector<Synthetic> synthetics_;
+    std::vector<Leg> legs_;
+
+    // Indexed by symbol id, up to the largest leg symbol
+    std::vector<double> last_price_;               // 0 until the symbol first ticks
+    std::vector<std::uint32_t> dependency_offsets_; // Leg s feeds dependencies_[offsets[s], offsets[s + 1])
+    std::vector<Dependency> dependencies_;          // Sorted by leg symbol
+    std::vector<bool> is_synthetic_;               // Indexed by symbol id, up to the largest synthetic
+
+    static double valueOf(const Synthetic& synthetic) {
+        return synthetic.ratio ? std::exp(synthetic.constant + synthetic.sum) : synthetic.constant + synthetic.sum;
+    }
+
+    void refresh(Synthetic& synthetic) const;
+};
+
+} // namespace trading
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <variant>
+
+#include "common/DCIndicator.h"
+#include "common/Logger.h"
+#include "market_data/MarketDataMessages.h"
+#include "strategy/RuleTable.h"
+#include "strategy/StrategyContext.h"
+#include "strategy/StrategyMessages.h"
+
+namespace trading {
+
+/**
+ * @brief CRTP base of the DC strategies compiled into the engine
+ *
+ * A strategy derives from DCStrategy<Self> and provides
+ *
+ *     SignalType signalFor(const DCSignalMessage&, const StrategyContext&) const;
+ *     double regimeLeverage(MarketState) const;
+ *
+ * and may hide baseQuantity(), maxNotional() or sizeFactor(), which by
+ * default scales by regimeLeverage(). Calls resolve at compile time, so
+ * each strategy inlines into the engine's visit of StrategyVariant with
+ * no virtual dispatch. To add a strategy, define it here, add it to
+ * StrategyVariant and give it a name in makeStrategy().
+ */
+template <typename Derived>
+class DCStrategy {
+public:
+    SignalType generateSignal(const DCSignalMessage& dc_signal, const StrategyContext& context) const {
+        return self().signalFor(dc_signal, context);
+    }
+
+    /**
+     * @brief Target position size for a signal at its price
+     */
+    double orderQuantity(const DCSignalMessage& dc_signal, const StrategyContext& context) const {
+        double quantity = self().baseQuantity() * context.leverage_factor *
+                          self().sizeFactor(dc_signal, context);
+
+        // Higher price, smaller quantity
+        if (dc_signal.price > 0.0) {
+            quantity = std::min(quantity, self().maxNotional() / dc_signal.price);
+        }
+        return std::max(1.0, quantity);  // Minimum 1 unit
+    }
+
+    double baseQuantity() const { return 100.0; }
+    double maxNotional() const { return 10000.0; }  // Per trade
+
+    double sizeFactor(const DCSignalMessage& /*dc_signal*/, const StrategyContext& context) const {
+        return self().regimeLeverage(context.market_state);
+    }
+
+private:
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+/**
+ * @brief Trend following: trade in the direction of a confirmed DC event
+ *
+ * Buys on upturns and sells on downturns when the time-adjusted return
+ * agrees, with more size in calm regimes and less in volatile ones.
+ */
+class DCTrendStrategy : public DCStrategy<DCTrendStrategy> {
+public:
+    static constexpr const char* kName = "DC_Strategy_v1";
+
+    SignalType signalFor(const DCSignalMessage& dc_signal, const StrategyContext& context) const {
+        switch (dc_signal.event_type) {
+            case DCEventType::UPTURN:
+                if (dc_signal.time_adjusted_return > 0.0) {
+                    // Stronger signal if HMM indicates low volatility
+                    if (context.market_state == MarketState::LOW_VOLATILITY) {
+                        LOG_DEBUG_STRATEGY("Strong BUY signal in low volatility state");
+                    }
+                    return SignalType::BUY;
+                }
+                break;
+
+            case DCEventType::DOWNTURN:
+                if (dc_signal.time_adjusted_return < 0.0) {
+                    if (context.market_state == MarketState::LOW_VOLATILITY) {
+                        LOG_DEBUG_STRATEGY("Strong SELL signal in low volatility state");
+                    }
+                    return SignalType::SELL;
+                }
+                break;
+
+            default:
+                break;
+        }
+        return SignalType::NONE;
+    }
+
+    double regimeLeverage(MarketState state) const {
+        switch (state) {
+            case MarketState::LOW_VOLATILITY:
+                return 1.5;  // Increase leverage in low volatility
+            case MarketState::HIGH_VOLATILITY:
+                return 0.5;  // Reduce leverage in high volatility
+            default:
+                return 1.0;
+        }
+    }
+};
+
+/**
+ * @brief Mean reversion: fade a DC event once the move is confirmed
+ *
+ * Sells into upturns and buys into downturns. Overshoots revert least
+ * reliably in volatile regimes, so it stands aside there.
+ */
+class DCContrarianStrategy : public DCStrategy<DCContrarianStrategy> {
+public:
+    static constexpr const char* kName = "DC_Contrarian_v1";
+
+    SignalType signalFor(const DCSignalMessage& dc_signal, const StrategyContext& context) const {
+        if (context.market_state == MarketState::HIGH_VOLATILITY) {
+            return SignalType::NONE;
+        }
+        switch (dc_signal.event_type) {
+            case DCEventType::UPTURN:
+                return SignalType::SELL;
+            case DCEventType::DOWNTURN:
+                return SignalType::BUY;
+            default:
+                return SignalType::NONE;
+        }
+    }
+
+    double regimeLeverage(MarketState state) const {
+        return state == MarketState::LOW_VOLATILITY ? 1.0 : 0.5;
+    }
+
+    double baseQuantity() const { return 50.0; }
+};
+
+/**
+ * @brief Configured rules: signal and size come from a compiled RuleTable
+ *
+ * The rules are loaded from the strategy settings and compiled once at
+ * startup, so a rule change needs a restart but no release. Each signal
+ * costs one table lookup for the side and one for the size.
+ */
+class DCRuleStrategy : public DCStrategy<DCRuleStrategy> {
+public:
+    static constexpr const char* kName = "DC_Rules_v1";
+
+    explicit DCRuleStrategy(std::shared_ptr<const RuleTable> rules) : rules_(std::move(rules)) {}
+
+    SignalType signalFor(const DCSignalMessage& dc_signal, const StrategyContext& context) const {
+        return rules_->lookup(dc_signal, context).signal;
+    }
+
+    double sizeFactor(const DCSignalMessage& dc_signal, const StrategyContext& context) const {
+        return rules_->lookup(dc_signal, context).size;
+    }
+
+private:
+    std::shared_ptr<const RuleTable> rules_;  // Shared by copies, never modified
+};
+
+using StrategyVariant = std::variant<DCTrendStrategy, DCContrarianStrategy, DCRuleStrategy>;
+
+/**
+ * @brief Names accepted by makeStrategy(), in StrategyVariant order
+ */
+inline const std::array<const char*, std::variant_size_v<StrategyVariant>>& strategyNames() {
+    static const std::array<const char*, std::variant_size_v<StrategyVariant>> names = {
+        DCTrendStrategy::kName, DCContrarianStrategy::kName, DCRuleStrategy::kName};
+    return names;
+}
+
+/**
+ * @brief Select a strategy by its configured name
+ * @param rules Compiled rules, required by DC_Rules_v1 and ignored by the others
+ * @return false if no compiled-in strategy has that name, or DC_Rules_v1 has no rules
+ */
+inline bool makeStrategy(const std::string& name, StrategyVariant& strategy,
+                         std::shared_ptr<const RuleTable> rules = nullptr) {
+    if (name == DCTrendStrategy::kName) {
+        strategy = DCTrendStrategy();
+    } else if (name == DCContrarianStrategy::kName) {
+        strategy = DCContrarianStrategy();
+    } else if (name == DCRuleStrategy::kName && rules) {
+        strategy = DCRuleStrategy(std::move(rules));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace trading
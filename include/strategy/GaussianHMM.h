@@ -0,0 +1,443 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace trading {
+
+/**
+ * @brief Features the regime model sees per DC event: log |TMV| and log duration in seconds
+ */
+constexpr std::size_t kRegimeFeatures = 2;
+using RegimeObservation = std::array<double, kRegimeFeatures>;
+
+inline RegimeObservation regimeFeatures(double tmv_ext, std::int64_t duration_ns) {
+    // Floors keep a zero move or an instant event finite
+    return RegimeObservation{std::log(std::max(std::fabs(tmv_ext), 1e-12)),
+                             std::log(std::max(static_cast<double>(duration_ns) * 1e-9, 1e-6))};
+}
+
+/**
+ * @brief Parameters of a K-state HMM with diagonal Gaussian emissions over D features
+ */
+template <std::size_t K, std::size_t D>
+struct HmmParameters {
+    std::array<double, K> initial;
+    std::array<std::array<double, K>, K> transition;  // transition[i][j] = P(next j | i)
+    std::array<std::array<double, D>, K> mean;
+    std::array<std::array<double, D>, K> variance;
+};
+
+/**
+ * @brief Gaussian HMM with the state count fixed at compile time
+ *
+ * The filter state is the predicted distribution of the next hidden state,
+ * K doubles owned by the caller, so one model serves any number of
+ * symbols. update() folds in one observation in O(K^2) with no allocation;
+ * emissions are evaluated in log space and shifted by their maximum, so
+ * observations far in any tail cannot underflow the belief to zero.
+ */
+template <std::size_t K, std::size_t D>
+class GaussianHMM {
+public:
+    using Parameters = HmmParameters<K, D>;
+    using Observation = std::array<double, D>;
+    static constexpr std::size_t kStates = K;
+
+    explicit GaussianHMM(const Parameters& parameters) : parameters_(parameters) {
+        constexpr double kTwoPi = 6.283185307179586;
+        for (std::size_t k = 0; k < K; ++k) {
+            double log_norm = 0.0;
+            for (std::size_t d = 0; d < D; ++d) {
+                inverse_variance_[k][d] = 1.0 / parameters_.variance[k][d];
+                log_norm -= 0.5 * std::log(kTwoPi * parameters_.variance[k][d]);
+            }
+            log_norm_[k] = log_norm;
+        }
+    }
+
+    const Parameters& parameters() const { return parameters_; }
+
+    /**
+     * @brief Start a belief from the initial state distribution
+     * @param predicted K doubles
+     */
+    void reset(double* predicted) const {
+        for (std::size_t k = 0; k < K; ++k) {
+            predicted[k] = parameters_.initial[k];
+        }
+    }
+
+    /**
+     * @brief Fold in one observation
+     * @param predicted K doubles: P(state | earlier observations), advanced in place
+     * @param filtered Optional K doubles receiving P(state | observations so far)
+     * @return Most likely current state
+     */
+    std::size_t update(double* predicted, const Observation& x, double* filtered = nullptr) const {
+        std::array<double, K> emission;
+        scaledEmissions(x, emission);
+
+        std::array<double, K> posterior;
+        double total = 0.0;
+        for (std::size_t k = 0; k < K; ++k) {
+            posterior[k] = emission[k] * predicted[k];
+            total += posterior[k];
+        }
+        if (!(total > 0.0)) {
+            // Belief collapsed onto states that cannot emit x; start over
+            reset(predicted);
+            total = 0.0;
+            for (std::size_t k = 0; k < K; ++k) {
+                posterior[k] = emission[k] * predicted[k];
+                total += posterior[k];
+            }
+            if (!(total > 0.0)) {
+                return 0;  // Not a usable observation
+            }
+        }
+
+        std::size_t best = 0;
+        const double inverse_total = 1.0 / total;
+        for (std::size_t k = 0; k < K; ++k) {
+            posterior[k] *= inverse_total;
+            best = posterior[k] > posterior[best] ? k : best;
+        }
+
+        for (std::size_t j = 0; j < K; ++j) {
+            predicted[j] = 0.0;
+        }
+        for (std::size_t i = 0; i < K; ++i) {
+            for (std::size_t j = 0; j < K; ++j) {
+                predicted[j] += posterior[i] * parameters_.transition[i][j];
+            }
+        }
+
+        if (filtered != nullptr) {
+            std::copy(posterior.begin(), posterior.end(), filtered);
+        }
+        return best;
+    }
+
+    double logEmission(std::size_t k, const Observation& x) const {
+        double log_density = log_norm_[k];
+        for (std::size_t d = 0; d < D; ++d) {
+            const double delta = x[d] - parameters_.mean[k][d];
+            log_density -= 0.5 * delta * delta * inverse_variance_[k][d];
+        }
+        return log_density;
+    }
+
+    /**
+     * @brief Emission densities divided by the largest one
+     * @return Log of the divisor
+     */
+    double scaledEmissions(const Observation& x, std::array<double, K>& emission) const {
+        double max_log = -std::numeric_limits<double>::infinity();
+        for (std::size_t k = 0; k < K; ++k) {
+            emission[k] = logEmission(k, x);
+            max_log = std::max(max_log, emission[k]);
+        }
+        for (std::size_t k = 0; k < K; ++k) {
+            emission[k] = std::exp(emission[k] - max_log);
+        }
+        return max_log;
+    }
+
+private:
+    Parameters parameters_;
+    std::array<std::array<double, D>, K> inverse_variance_;
+    std::array<double, K> log_norm_;
+};
+
+/**
+ * @brief Outcome of trainBaumWelch()
+ */
+template <std::size_t K, std::size_t D>
+struct HmmTrainingResult {
+    HmmParameters<K, D> parameters;
+    double log_likelihood;
+    int iterations;
+    bool converged;
+};
+
+namespace hmm_detail {
+
+constexpr double kMinVariance = 1e-4;
+constexpr double kMinProbability = 1e-6;
+
+// Volatility of a state: log TMV per second
+template <std::size_t K, std::size_t D>
+double volatilityKey(const HmmParameters<K, D>& parameters, std::size_t k) {
+    return D >= 2 ? parameters.mean[k][0] - parameters.mean[k][1] : parameters.mean[k][0];
+}
+
+template <std::size_t K>
+void normalize(std::array<double, K>& row) {
+    double total = 0.0;
+    for (double& p : row) {
+        p = std::max(p, kMinProbability);
+        total += p;
+    }
+    for (double& p : row) {
+        p /= total;
+    }
+}
+
+} // namespace hmm_detail
+
+/**
+ * @brief Renumber states by ascending volatility
+ *
+ * State 0 is then the calmest regime and state K-1 the most volatile, which
+ * is what the strategy maps to its low and high volatility market states.
+ */
+template <std::size_t K, std::size_t D>
+HmmParameters<K, D> orderStatesByVolatility(const HmmParameters<K, D>& parameters) {
+    std::array<std::size_t, K> order;
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return hmm_detail::volatilityKey(parameters, a) < hmm_detail::volatilityKey(parameters, b);
+    });
+
+    HmmParameters<K, D> ordered;
+    for (std::size_t i = 0; i < K; ++i) {
+        ordered.initial[i] = parameters.initial[order[i]];
+        ordered.mean[i] = parameters.mean[order[i]];
+        ordered.variance[i] = parameters.variance[order[i]];
+        for (std::size_t j = 0; j < K; ++j) {
+            ordered.transition[i][j] = parameters.transition[order[i]][order[j]];
+        }
+    }
+    return ordered;
+}
+
+/**
+ * @brief Starting point for Baum-Welch: observations split into K volatility quantiles
+ */
+template <std::size_t K, std::size_t D>
+HmmParameters<K, D> initialHmmParameters(const std::vector<std::vector<std::array<double, D>>>& sequences) {
+    std::vector<std::array<double, D>> all;
+    for (const auto& sequence : sequences) {
+        all.insert(all.end(), sequence.begin(), sequence.end());
+    }
+    auto key = [](const std::array<double, D>& x) { return D >= 2 ? x[0] - x[1] : x[0]; };
+    std::sort(all.begin(), all.end(), [&](const auto& a, const auto& b) { return key(a) < key(b); });
+
+    HmmParameters<K, D> parameters;
+    for (std::size_t k = 0; k < K; ++k) {
+        parameters.initial[k] = 1.0 / K;
+        for (std::size_t j = 0; j < K; ++j) {
+            parameters.transition[k][j] = k == j ? 0.9 : 0.1 / (K - 1);
+        }
+
+        const std::size_t begin = all.size() * k / K;
+        const std::size_t end = std::max(all.size() * (k + 1) / K, begin + 1);
+        for (std::size_t d = 0; d < D; ++d) {
+            double sum = 0.0;
+            double sum_squares = 0.0;
+            std::size_t n = 0;
+            for (std::size_t t = begin; t < end && t < all.size(); ++t, ++n) {
+                sum += all[t][d];
+                sum_squares += all[t][d] * all[t][d];
+            }
+            const double mean = n > 0 ? sum / n : 0.0;
+            parameters.mean[k][d] = mean;
+            parameters.variance[k][d] = std::max(n > 0 ? sum_squares / n - mean * mean : 1.0, hmm_detail::kMinVariance);
+        }
+    }
+    return parameters;
+}
+
+/**
+ * @brief Fit an HMM to independent observation sequences with Baum-Welch
+ *
+ * Runs scaled forward-backward EM from the given parameters until the
+ * log-likelihood gains less than tolerance per observation in an
+ * iteration, or max_iterations is reached. Variances and probabilities are
+ * floored so a state cannot collapse onto a single point. The result has
+ * its states ordered by volatility.
+ */
+template <std::size_t K, std::size_t D>
+HmmTrainingResult<K, D> trainBaumWelch(const std::vector<std::vector<std::array<double, D>>>& sequences,
+                                       const HmmParameters<K, D>& initial,
+                                       int max_iterations,
+                                       double tolerance = 1e-6) {
+    using Row = std::array<double, K>;
+
+    std::size_t observations = 0;
+    std::size_t longest = 0;
+    for (const auto& sequence : sequences) {
+        observations += sequence.size();
+        longest = std::max(longest, sequence.size());
+    }
+
+    HmmTrainingResult<K, D> result{initial, -std::numeric_limits<double>::infinity(), 0, false};
+    if (observations == 0) {
+        return result;
+    }
+
+    // Per-time-step storage for the longest sequence; beta only needs one step
+    std::vector<Row> alpha(longest);
+    std::vector<Row> emission(longest);
+    std::vector<double> inverse_scale(longest);
+
+    for (int iteration = 0; iteration < max_iterations; ++iteration) {
+        const HmmParameters<K, D>& current = result.parameters;
+
+        // Emission parameters feature-major, so every inner loop below runs
+        // over the K states with unit stride and vectorizes
+        std::array<Row, D> mean;
+        std::array<Row, D> precision;
+        Row log_norm;
+        log_norm.fill(0.0);
+        for (std::size_t k = 0; k < K; ++k) {
+            for (std::size_t d = 0; d < D; ++d) {
+                mean[d][k] = current.mean[k][d];
+                precision[d][k] = 1.0 / current.variance[k][d];
+                log_norm[k] -= 0.5 * std::log(6.283185307179586 * current.variance[k][d]);
+            }
+        }
+
+        // Expected counts accumulated over all sequences
+        Row initial_counts{};
+        std::array<Row, K> transition_counts{};
+        Row occupancy{};
+        std::array<Row, D> sum{};
+        std::array<Row, D> sum_squares{};
+        double log_likelihood = 0.0;
+
+        for (const auto& x : sequences) {
+            const std::size_t T = x.size();
+            if (T == 0) {
+                continue;
+            }
+
+            // Emission densities, scaled by their per-step maximum
+            for (std::size_t t = 0; t < T; ++t) {
+                Row log_density = log_norm;
+                for (std::size_t d = 0; d < D; ++d) {
+                    for (std::size_t k = 0; k < K; ++k) {
+                        const double delta = x[t][d] - mean[d][k];
+                        log_density[k] -= 0.5 * delta * delta * precision[d][k];
+                    }
+                }
+                const double shift = *std::max_element(log_density.begin(), log_density.end());
+                for (std::size_t k = 0; k < K; ++k) {
+                    emission[t][k] = std::exp(log_density[k] - shift);
+                }
+                log_likelihood += shift;
+            }
+
+            // Forward pass, each step normalized to sum to one
+            for (std::size_t t = 0; t < T; ++t) {
+                Row predicted;
+                if (t == 0) {
+                    predicted = current.initial;
+                } else {
+                    predicted.fill(0.0);
+                    for (std::size_t i = 0; i < K; ++i) {
+                        const double a = alpha[t - 1][i];
+                        for (std::size_t j = 0; j < K; ++j) {
+                            predicted[j] += a * current.transition[i][j];
+                        }
+                    }
+                }
+
+                double total = 0.0;
+                for (std::size_t j = 0; j < K; ++j) {
+                    alpha[t][j] = predicted[j] * emission[t][j];
+                    total += alpha[t][j];
+                }
+                total = std::max(total, std::numeric_limits<double>::min());
+                inverse_scale[t] = 1.0 / total;
+                for (std::size_t j = 0; j < K; ++j) {
+                    alpha[t][j] *= inverse_scale[t];
+                }
+                log_likelihood += std::log(total);
+            }
+
+            // Backward pass with the forward scale factors, accumulating the
+            // expected state occupancy and transitions as it goes
+            Row beta;
+            beta.fill(1.0);
+            for (std::size_t t = T; t-- > 0;) {
+                if (t + 1 < T) {
+                    Row weight;
+                    for (std::size_t j = 0; j < K; ++j) {
+                        weight[j] = emission[t + 1][j] * beta[j] * inverse_scale[t + 1];
+                    }
+                    for (std::size_t i = 0; i < K; ++i) {
+                        const double a = alpha[t][i];
+                        double value = 0.0;
+                        for (std::size_t j = 0; j < K; ++j) {
+                            const double step = current.transition[i][j] * weight[j];
+                            transition_counts[i][j] += a * step;
+                            value += step;
+                        }
+                        beta[i] = value;
+                    }
+                }
+
+                Row gamma;
+                for (std::size_t k = 0; k < K; ++k) {
+                    gamma[k] = alpha[t][k] * beta[k];
+                    occupancy[k] += gamma[k];
+                }
+                for (std::size_t d = 0; d < D; ++d) {
+                    const double value = x[t][d];
+                    for (std::size_t k = 0; k < K; ++k) {
+                        sum[d][k] += gamma[k] * value;
+                        sum_squares[d][k] += gamma[k] * value * value;
+                    }
+                }
+                if (t == 0) {
+                    for (std::size_t k = 0; k < K; ++k) {
+                        initial_counts[k] += gamma[k];
+                    }
+                }
+            }
+        }
+
+        // Re-estimate
+        HmmParameters<K, D> next;
+        next.initial = initial_counts;
+        hmm_detail::normalize(next.initial);
+        for (std::size_t k = 0; k < K; ++k) {
+            next.transition[k] = transition_counts[k];
+            hmm_detail::normalize(next.transition[k]);
+            for (std::size_t d = 0; d < D; ++d) {
+                if (occupancy[k] > 0.0) {
+                    const double state_mean = sum[d][k] / occupancy[k];
+                    next.mean[k][d] = state_mean;
+                    next.variance[k][d] = std::max(sum_squares[d][k] / occupancy[k] - state_mean * state_mean,
+                                                   hmm_detail::kMinVariance);
+                } else {
+                    next.mean[k][d] = current.mean[k][d];
+                    next.variance[k][d] = current.variance[k][d];
+                }
+            }
+        }
+
+        // log_likelihood belongs to the parameters this iteration started from
+        const double gain = log_likelihood - result.log_likelihood;
+        result.parameters = next;
+        result.log_likelihood = log_likelihood;
+        result.iterations = iteration + 1;
+        if (iteration > 0 && gain < tolerance * static_cast<double>(observations)) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    result.parameters = orderStatesByVolatility(result.parameters);
+    return result;
+}
+
+} // namespace trading
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/Config.h"
+#include "common/DCIndicator.h"
+#include "common/SymbolTable.h"
+#include "strategy/StrategyContext.h"
+
+namespace trading {
+
+/**
+ * @brief Settings of the lead-lag statistics
+ */
+struct LeadLagSettings {
+    std::int64_t max_lag_ns;       // Follower events later than this after the leader's are not matched
+    std::uint32_t half_life_events; // EWMA half-life of each pair's statistics, in matched events
+    std::uint32_t min_samples;     // Matched events before a pair is offered as a feature
+};
+
+/**
+ * @brief Streaming lead-lag statistics over configured symbol pairs
+ *
+ * Keeps each symbol's last DC event time and direction, and for every
+ * (leader, follower) pair an EWMA of the lag from the leader's last DC
+ * event to the follower's, its spread, and how often the follower turned
+ * the way the leader last did. Pairs are stored sorted by follower, so a
+ * symbol's pairs are one contiguous slice found through an offsets array
+ * indexed by symbol id: a DC event touches only that slice and allocates
+ * nothing. Engine thread only.
+ */
+class LeadLagTable {
+public:
+    /**
+     * @brief Statistics of one pair
+     */
+    struct PairStatistics {
+        SymbolId leader;
+        std::uint32_t samples;   // Matched follower events
+        double mean_lag_ns;
+        double lag_variance;     // ns^2
+        double agreement;        // EWMA of follower direction == leader's last direction
+    };
+
+    LeadLagTable();
+
+    /**
+     * @brief Resolve the configured pairs against the engine's symbol ids
+     *
+     * Pair symbols are added to the symbol table, so their ids are known
+     * before they first trade.
+     * @param error Set to the first problem found
+     * @return false, keeping the current pairs and adding no symbols, if a
+     *         symbol is empty or too long, a symbol leads itself, a pair is
+     *         repeated, the symbol table is full or the settings are out of
+     *         range
+     */
+    bool configure(const std::vector<Config::LeadLagPairConfig>& pairs, const LeadLagSettings& settings,
+                   SymbolTable& symbols, std::string& error);
+
+    /**
+     * @brief Record a DC event and update the pairs it follows in
+     */
+    void onEvent(SymbolId symbol_id, std::int64_t timestamp, DCEventType type) {
+        if (symbol_id >= last_event_ns_.size()) {
+            return;
+        }
+        const int trend = type == DCEventType::UPTURN ? 1 : -1;
+        for (std::uint32_t i = follower_offsets_[symbol_id]; i < follower_offsets_[symbol_id + 1]; ++i) {
+            PairStatistics& pair = pairs_[i];
+            const std::int64_t lag = timestamp - last_event_ns_[pair.leader];
+            if (last_trend_[pair.leader] == 0 || lag < 0 || lag > settings_.max_lag_ns) {
+                continue;
+            }
+            update(pair, static_cast<double>(lag), last_trend_[pair.leader] == trend ? 1.0 : 0.0);
+        }
+        last_event_ns_[symbol_id] = timestamp;
+        last_trend_[symbol_id] = static_cast<std::int8_t>(trend);
+    }
+
+    /**
+     * @brief Features of a symbol against its most agreeing leader
+     * @param timestamp Time of the signal, for the time since the leader's event
+     * @return No leader if the symbol follows none with min_samples matches
+     */
+    LeadLagFeatures features(SymbolId symbol_id, std::int64_t timestamp) const;
+
+    std::size_t pairs() const { return pairs_.size(); }
+    const PairStatistics& pair(std::size_t index) const { return pairs_[index]; }
+
+    /**
+     * @brief Index of a pair in pair(), or pairs() if it is not configured
+     */
+    std::size_t find(SymbolId leader, SymbolId follower) const;
+
+private:
+    LeadLagSettings settings_;
+    double alpha_;                              // EWMA weight of a new match
+
+    // Indexed by symbol id, up to the largest pair symbol
+    std::vector<std::int64_t> last_event_ns_;
+    std::vector<std::int8_t> last_trend_;       // 1 up, -1 down, 0 no DC event yet
+    std::vector<std::uint32_t> follower_offsets_; // Follower s has pairs_[offsets[s], offsets[s + 1])
+
+    std::vector<PairStatistics> pairs_;         // Sorted by follower
+
+    void update(PairStatistics& pair, double lag_ns, double agreed) const {
+        if (pair.samples++ == 0) {
+            pair.mean_lag_ns = lag_ns;
+            pair.lag_variance = 0.0;
+            pair.agreement = agreed;
+            return;
+        }
+        // Exponentially weighted mean and variance in one pass
+        const double difference = lag_ns - pair.mean_lag_ns;
+        const double increment = alpha_ * difference;
+        pair.mean_lag_ns += increment;
+        pair.lag_variance = (1.0 - alpha_) * (pair.lag_variance + difference * increment);
+        pair.agreement += alpha_ * (agreed - pair.agreement);
+    }
+};
+
+} // namespace trading
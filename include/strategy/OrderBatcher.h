@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/SymbolTable.h"
+#include "strategy/StrategyMessages.h"
+
+namespace trading {
+
+/**
+ * @brief Nets orders per symbol and packs them into one batch message
+ *
+ * Orders added between two build() calls are netted per symbol: buys and
+ * sells add up to one signed quantity, sent as a single order priced at
+ * the latest order and carrying the first order's hop timestamps, so
+ * tick-to-trade still measures from the earliest tick. Symbols that net
+ * to zero are dropped. All storage is sized in the constructor. Not
+ * thread-safe.
+ */
+class OrderBatcher {
+public:
+    /**
+     * @brief Result of build(); valid until the next add() or build()
+     */
+    struct Batch {
+        const std::uint8_t* data;    // Header followed by count orders
+        std::size_t length;
+        const TradingOrder* orders;
+        const SymbolId* symbols;     // Symbol id of each order
+        std::uint32_t count;
+        std::uint32_t netted;        // Orders not sent because an opposite order cancelled them
+    };
+
+    /**
+     * @param max_orders Distinct symbols per batch (capped at kMaxOrdersPerBatch)
+     * @param max_symbols Largest symbol id + 1 that will be added
+     */
+    explicit OrderBatcher(std::size_t max_orders = kMaxOrdersPerBatch, std::size_t max_symbols = 16384);
+
+    /**
+     * @brief Add an order to the open batch
+     * @return false if the batch already holds max_orders symbols; build() first
+     */
+    bool add(SymbolId symbol_id, const TradingOrder& order);
+
+    /**
+     * @brief Net the open batch into a message and start a new batch
+     */
+    Batch build();
+
+    std::size_t pending() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    std::size_t capacity() const { return max_orders_; }
+
+private:
+    struct Entry {
+        SymbolId symbol_id;
+        double net_quantity;   // Signed: buys positive
+        TradingOrder order;    // First order, with the latest price
+        std::uint32_t orders;  // Orders added for the symbol
+        bool opposed;          // Both buys and sells were added
+    };
+
+    static constexpr std::uint32_t kNoEntry = 0xFFFFFFFFu;
+
+    std::size_t max_orders_;
+    std::vector<std::uint32_t> entry_of_symbol_;  // Index into entries_, or kNoEntry
+    std::vector<Entry> entries_;
+
+    // Message buffer; 64-bit words keep the orders aligned
+    std::vector<std::uint64_t> message_;
+    std::vector<SymbolId> message_symbols_;
+};
+
+} // namespace trading
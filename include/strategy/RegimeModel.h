@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "strategy/GaussianHMM.h"
+
+namespace trading {
+
+constexpr std::size_t kMinRegimeStates = 2;
+constexpr std::size_t kMaxRegimeStates = 4;
+
+/**
+ * @brief Per-symbol filter state; only the first states() entries are used
+ */
+using RegimeBelief = std::array<double, kMaxRegimeStates>;
+
+/**
+ * @brief Regime HMM with its state count chosen at runtime
+ *
+ * Holds one GaussianHMM specialization for 2 to 4 states, so every update
+ * runs the fixed-size loops of its specialization after one variant
+ * dispatch. States are ordered by volatility: 0 is the calmest regime and
+ * states() - 1 the most volatile.
+ */
+class RegimeModel {
+public:
+    RegimeModel() = default;
+
+    template <std::size_t K>
+    explicit RegimeModel(const HmmParameters<K, kRegimeFeatures>& parameters)
+        : model_(GaussianHMM<K, kRegimeFeatures>(parameters)) {}
+
+    bool loaded() const { return model_.index() != 0; }
+
+    /**
+     * @brief Number of hidden states, 0 if no model is loaded
+     */
+    std::size_t states() const;
+
+    /**
+     * @brief Start a symbol's belief from the initial distribution
+     */
+    void reset(RegimeBelief& belief) const;
+
+    /**
+     * @brief Fold in one DC event in O(K^2)
+     * @return Most likely current state, 0 if no model is loaded
+     */
+    std::size_t update(RegimeBelief& belief, const RegimeObservation& x) const {
+        return std::visit([&](const auto& model) -> std::size_t {
+            if constexpr (std::is_same_v<std::decay_t<decltype(model)>, std::monostate>) {
+                return 0;
+            } else {
+                return model.update(belief.data(), x);
+            }
+        }, model_);
+    }
+
+    /**
+     * @brief Append the parameters as doubles: initial, transition, mean, variance
+     */
+    void serialize(std::vector<double>& values) const;
+
+    /**
+     * @brief Build a k-state model from serialize() output
+     * @return false if k is unsupported or the values are not usable
+     */
+    bool deserialize(std::size_t k, const double* values);
+
+    static std::size_t serializedSize(std::size_t k) { return k + k * k + 2 * k * kRegimeFeatures; }
+
+private:
+    std::variant<std::monostate,
+                 GaussianHMM<2, kRegimeFeatures>,
+                 GaussianHMM<3, kRegimeFeatures>,
+                 GaussianHMM<4, kRegimeFeatures>> model_;
+};
+
+/**
+ * @brief Regime models per symbol plus a default, as written by hmm_trainer
+ *
+ * Symbols without a model of their own (too little history to train one)
+ * use the default model, trained on every symbol's events. All models in a
+ * set have the same state count.
+ *
+ * The file is a 16-byte header (magic, version, states, features, model
+ * count) followed by one record per model: a 16-byte symbol, empty for the
+ * default, and the parameters as doubles.
+ */
+class RegimeModelSet {
+public:
+    /**
+     * @brief Load a model file
+     * @return false if the file is missing or malformed; the set is left unchanged
+     */
+    bool load(const std::string& path, std::string& error);
+
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Set the default model; clears per-symbol models with another state count
+     */
+    void setDefault(RegimeModel model);
+
+    /**
+     * @brief Set a symbol's own model
+     * @return false if its state count differs from the default's
+     */
+    bool set(const std::string& symbol, RegimeModel model);
+
+    /**
+     * @brief The symbol's own model, else the default (which may be unloaded)
+     */
+    const RegimeModel& lookup(const char* symbol) const;
+
+    bool loaded() const { return default_model_.loaded(); }
+    std::size_t states() const { return default_model_.states(); }
+    std::size_t symbolModels() const { return symbol_models_.size(); }
+
+private:
+    RegimeModel default_model_;
+    std::unordered_map<std::string, RegimeModel> symbol_models_;
+};
+
+} // namespace trading
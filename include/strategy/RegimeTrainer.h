@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "strategy/GaussianHMM.h"
+#include "strategy/RegimeModel.h"
+
+namespace trading {
+
+/**
+ * @brief Settings for RegimeTrainer::train()
+ */
+struct RegimeTrainingOptions {
+    std::size_t states;          // 2 to kMaxRegimeStates
+    int max_iterations;          // EM iterations per restart
+    double tolerance;            // Convergence: log-likelihood gain per observation
+    int restarts;                // EM runs per model; the most likely one is kept
+    std::size_t min_events;      // Fewer DC events than this and a symbol uses the default model
+    std::size_t threads;         // Worker threads; 0 uses the hardware concurrency
+    std::uint64_t seed;          // Restart perturbations; results do not depend on threads
+};
+
+/**
+ * @brief Summary of a training run
+ */
+struct RegimeTrainingReport {
+    std::size_t symbols;         // Symbols with events
+    std::size_t symbol_models;   // Symbols that got their own model
+    std::size_t events;
+    std::size_t jobs;            // EM runs, restarts included
+    std::size_t converged_jobs;
+    std::uint64_t iterations;    // Summed over all jobs
+    std::uint64_t stolen_jobs;   // Jobs a worker took from another worker's queue
+    double default_log_likelihood;
+};
+
+/**
+ * @brief Offline Baum-Welch training of per-symbol regime models
+ *
+ * Every symbol with at least min_events DC events gets its own model, and
+ * a default model is trained on all symbols together. Each model is fitted
+ * restarts times, the first from volatility quantiles and the others from
+ * randomly perturbed starts, and the most likely fit is kept. The EM runs
+ * are independent jobs on a work-stealing pool, the pooled default first
+ * since it is the largest.
+ */
+class RegimeTrainer {
+public:
+    /**
+     * @brief Add a symbol's DC features in event order
+     */
+    void addSequence(const std::string& symbol, std::vector<RegimeObservation> sequence);
+
+    /**
+     * @return false if the options are invalid or there are no events
+     */
+    bool train(const RegimeTrainingOptions& options, RegimeModelSet& models, RegimeTrainingReport& report) const;
+
+private:
+    template <std::size_t K>
+    bool trainStates(const RegimeTrainingOptions& options, RegimeModelSet& models,
+                     RegimeTrainingReport& report) const;
+
+    std::vector<std::string> symbols_;
+    std::vector<std::vector<std::vector<RegimeObservation>>> sequences_;  // One single-sequence set per symbol
+};
+
+} // namespace trading
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/Rcu.h"
+#include "common/SymbolTable.h"
+
+namespace trading {
+
+/**
+ * @brief Pre-trade limits for one symbol; 0 disables a limit
+ */
+struct RiskLimits {
+    double max_position;                 // Absolute position after the order, in units
+    double max_notional;                 // Quantity * price of a single order
+    std::uint32_t max_orders_per_second; // Orders accepted per one-second window
+    double price_band_bps;               // Allowed distance from the reference price
+};
+
+/**
+ * @brief Immutable table of per-symbol limits with a default row
+ *
+ * Built off the trading thread, then published to a RiskGate, which never
+ * modifies it. Lookup is one SymbolTable probe.
+ */
+class RiskLimitTable {
+public:
+    explicit RiskLimitTable(const RiskLimits& defaults, std::size_t capacity = 1024)
+        : defaults_(defaults)
+        , symbols_(capacity)
+    {
+    }
+
+    /**
+     * @brief Override the default limits for a symbol
+     * @return false if the table is full
+     */
+    bool set(const char* symbol, const RiskLimits& limits) {
+        SymbolId id = symbols_.findOrInsert(symbol);
+        if (id == kInvalidSymbolId) {
+            return false;
+        }
+        if (id >= limits_.size()) {
+            limits_.resize(id + 1);
+        }
+        limits_[id] = limits;
+        return true;
+    }
+
+    const RiskLimits& lookup(const char* symbol) const {
+        SymbolId id = symbols_.find(symbol);
+        return id == kInvalidSymbolId ? defaults_ : limits_[id];
+    }
+
+    const RiskLimits& defaults() const { return defaults_; }
+
+private:
+    RiskLimits defaults_;
+    SymbolTable symbols_;
+    std::vector<RiskLimits> limits_;
+};
+
+/**
+ * @brief Outcome of a pre-trade check
+ */
+enum class RiskCheckResult : std::uint8_t {
+    ACCEPTED,
+    MAX_POSITION,
+    MAX_NOTIONAL,
+    ORDER_RATE,
+    PRICE_BAND
+};
+
+/**
+ * @brief Inline pre-trade risk gate
+ *
+ * Each check is O(1): one limit-table probe plus a few comparisons against
+ * per-symbol state held in a flat array indexed by the caller's symbol id.
+ * An accepted order is added to the symbol's projected position and rate
+ * window straight away; execution reports correct the position through
+ * onPosition(). The limit table is read through an RcuPointer, so
+ * updateLimits() can swap it from another thread while orders flow; the
+ * checking thread must be a reader of the domain. Statistics are relaxed
+ * counters any thread may read. Everything else is checking-thread only.
+ */
+class RiskGate {
+public:
+    struct Statistics {
+        std::uint64_t checks;
+        std::uint64_t rejected_position;
+        std::uint64_t rejected_notional;
+        std::uint64_t rejected_rate;
+        std::uint64_t rejected_price_band;
+    };
+
+    /**
+     * @param max_symbols Symbol ids the per-symbol state is reserved for
+     */
+    RiskGate(RcuDomain& domain, const RiskLimits& defaults, std::size_t max_symbols = 1024);
+
+    /**
+     * @brief Publish a new limit table; blocks for one grace period
+     */
+    void updateLimits(std::unique_ptr<RiskLimitTable> limits) { limits_.update(std::move(limits)); }
+
+    /**
+     * @brief Check an order and, if accepted, account for it
+     * @param id Caller's symbol id
+     * @param symbol Symbol name, used for the limit table lookup
+     * @param quantity Signed quantity (positive buys)
+     * @param price Order price
+     * @param now_ns Current time
+     */
+    RiskCheckResult check(SymbolId id, const char* symbol, double quantity, double price, std::int64_t now_ns);
+
+    /**
+     * @brief Replace the projected position with a reported one
+     */
+    void onPosition(SymbolId id, double position) { state(id).position = position; }
+
+    /**
+     * @brief Set the price the fat-finger band is measured from
+     */
+    void onReferencePrice(SymbolId id, double price) { state(id).reference_price = price; }
+
+    double position(SymbolId id) const { return id < symbols_.size() ? symbols_[id].position : 0.0; }
+
+    Statistics getStatistics() const;
+
+private:
+    struct SymbolRisk {
+        double position;            // Reported position plus accepted orders since
+        double reference_price;
+        std::int64_t window_start_ns;
+        std::uint32_t window_orders;
+    };
+
+    RcuPointer<RiskLimitTable> limits_;
+    std::vector<SymbolRisk> symbols_;
+
+    std::atomic<std::uint64_t> checks_;
+    std::atomic<std::uint64_t> rejected_position_;
+    std::atomic<std::uint64_t> rejected_notional_;
+    std::atomic<std::uint64_t> rejected_rate_;
+    std::atomic<std::uint64_t> rejected_price_band_;
+
+    SymbolRisk& state(SymbolId id) {
+        if (id >= symbols_.size()) {
+            symbols_.resize(id + 1, SymbolRisk{0.0, 0.0, 0, 0});
+        }
+        return symbols_[id];
+    }
+};
+
+/**
+ * @brief Name of a check result for logs
+ */
+const char* riskCheckResultName(RiskCheckResult result);
+
+} // namespace trading
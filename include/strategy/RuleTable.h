@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/Config.h"
+#include "market_data/MarketDataMessages.h"
+#include "strategy/StrategyContext.h"
+#include "strategy/StrategyMessages.h"
+
+namespace trading {
+
+/**
+ * @brief Trading rules compiled into a flat decision table
+ *
+ * Rules are matched in order over the DC event type, regime, position
+ * (flat, long or short) and ranges of the time-adjusted return and |TMV|.
+ * compile() splits each numeric feature at every bound any rule uses, so
+ * every bucket between two bounds is either wholly inside a rule's range
+ * or wholly outside, and resolves the first matching rule for every
+ * combination of buckets ahead of time. A lookup is then a short
+ * count of bounds below each feature plus one array index, with no
+ * per-rule work. Cells no rule matches do not trade.
+ */
+class RuleTable {
+public:
+    struct Decision {
+        SignalType signal;
+        float size;  // Multiplies the strategy's base quantity
+    };
+
+    static constexpr std::size_t kMaxBounds = 15;  // Distinct bounds per numeric feature
+
+    RuleTable();
+
+    /**
+     * @brief Replace the table with one compiled from rules
+     * @param error Set to the first problem found
+     * @return false, leaving the table unchanged, if a rule is malformed or
+     *         the rules use more than kMaxBounds bounds on one feature
+     */
+    bool compile(const std::vector<Config::TradingRuleConfig>& rules, std::string& error);
+
+    const Decision& lookup(const DCSignalMessage& dc_signal, const StrategyContext& context) const {
+        // Anything but a known event type reads the never-trading NONE row
+        const std::size_t event = static_cast<std::size_t>(dc_signal.event_type) < kEvents ?
+            static_cast<std::size_t>(dc_signal.event_type) : 0;
+        const std::size_t position = (context.position >= 1.0) + 2 * (context.position <= -1.0);
+        const std::size_t row = (event * kRegimes + static_cast<std::size_t>(context.market_state)) * kPositions +
+                                position;
+        return cells_[(row * return_axis_.buckets() + return_axis_.bucket(dc_signal.time_adjusted_return)) *
+                          tmv_axis_.buckets() +
+                      tmv_axis_.bucket(std::fabs(dc_signal.tmv_ext))];
+    }
+
+    std::size_t rules() const { return rules_; }
+    std::size_t cells() const { return cells_.size(); }
+
+private:
+    static constexpr std::size_t kEvents = 3;     // DCEventType
+    static constexpr std::size_t kRegimes = 4;    // MarketState
+    static constexpr std::size_t kPositions = 3;  // Flat, long, short
+
+    struct Axis {
+        std::array<double, kMaxBounds> bounds;  // Ascending, count of them used
+        std::size_t count;
+
+        std::size_t buckets() const { return count + 1; }
+
+        // Bucket b holds values in [bounds[b - 1], bounds[b])
+        std::size_t bucket(double value) const {
+            std::size_t below = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                below += value >= bounds[i];
+            }
+            return below;
+        }
+
+        double lower(std::size_t b) const;
+        double upper(std::size_t b) const;
+    };
+
+    Axis return_axis_;
+    Axis tmv_axis_;
+    std::vector<Decision> cells_;
+    std::size_t rules_;
+};
+
+} // namespace trading
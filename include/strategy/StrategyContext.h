@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trading {
+
+/**
+ * @brief HMM state for market regime detection
+ *
+ * The calmest regime of the model is LOW_VOLATILITY and the most volatile
+ * HIGH_VOLATILITY; with more than two regimes the ones in between are
+ * NORMAL_VOLATILITY.
+ */
+enum class MarketState {
+    UNKNOWN,
+    LOW_VOLATILITY,
+    HIGH_VOLATILITY,
+    NORMAL_VOLATILITY
+};
+
+/**
+ * @brief The signal's symbol against the leader it has agreed with most
+ *
+ * Filled by the engine from the configured lead-lag pairs in which the
+ * symbol follows; has_leader is false when it follows none with enough
+ * matched events.
+ */
+struct LeadLagFeatures {
+    bool has_leader;
+    std::uint32_t leader;          // Engine symbol id
+    int leader_trend;              // Direction of the leader's last DC event: 1 up, -1 down
+    std::int64_t since_leader_ns;  // From the leader's last DC event to this signal
+    double mean_lag_ns;            // EWMA of the lag from the leader's DC events to the symbol's
+    double lag_stddev_ns;
+    double agreement;              // EWMA share of the symbol's DC events in the leader's direction
+    std::uint32_t samples;
+};
+
+/**
+ * @brief Engine state a strategy may use when handling a DC signal
+ */
+struct StrategyContext {
+    MarketState market_state;   // UNKNOWN when HMM regime detection is off
+    double leverage_factor;
+    double position;            // Strategy's signed position in the symbol, including batched orders
+    LeadLagFeatures lead_lag{}; // No leader unless lead-lag pairs are configured
+};
+
+} // namespace trading
@@ -7,48 +7,40 @@
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <vector>
 
 #include "common/DCIndicator.h"
+#include "common/AdaptivePollLimit.h"
+#include "common/Rcu.h"
+#include "common/SpscRing.h"
+#include "common/SymbolParameters.h"
+#include "common/TokenBucket.h"
+#include "common/SymbolTable.h"
 #include "common/TimeUtils.h"
 #include "common/Logger.h"
+#include "market_data/MarketDataProcessor.h"
+#include "strategy/StrategyMessages.h"
+#include "strategy/LeadLagTable.h"
+#include "strategy/RegimeModel.h"
+#include "strategy/StrategyInstance.h"
+#include "strategy/ThetaEnsemble.h"
+#include "execution/ExecutionMessages.h"
 
 namespace trading {
 
-/**
- * @brief Trading signal types
- */
-enum class SignalType {
-    NONE,
-    BUY,
-    SELL,
-    HOLD
-};
-
-/**
- * @brief Trading order structure
- */
-struct TradingOrder {
-    std::int64_t timestamp;
-    SignalType signal;
-    double price;
-    double quantity;
-    char symbol[16];
-    std::int64_t strategy_latency_ns;  // Time from DC event to order generation
-};
-
-/**
- * @brief HMM state for market regime detection
- */
-enum class MarketState {
-    UNKNOWN,
-    LOW_VOLATILITY,
-    HIGH_VOLATILITY
-};
-
 /**
  * @brief Strategy Engine - processes DC signals and generates trading orders
+ *
+ * Hosts one or more strategy instances over a single decode of the DC
+ * signal stream. The engine thread decodes each signal once, resolves its
+ * symbol id and regime once, and hands it to every instance; each
+ * instance keeps its own positions, throttles, risk gate, batches and
+ * statistics, and tags its orders with its id so execution reports come
+ * back to it. With worker threads the instances are split round-robin
+ * across them and fed through SPSC rings; without, they run on the engine
+ * thread.
  */
-class StrategyEngine {
+class StrategyEngine : private OrderPublisher {
 public:
     StrategyEngine();
     ~StrategyEngine();
@@ -68,6 +60,137 @@ public:
                    const std::string& output_channel,
                    std::int32_t output_stream_id);
     
+    /**
+     * @brief Consume execution reports to track positions and working orders
+     *
+     * Orders are always sized to move the symbol's position to the signal's
+     * target. With reports that position is the reported one, or with
+     * several strategies each one's own fills, and signals are also held
+     * back while the symbol still has an order of that strategy working;
+     * without, it assumes every published order fills.
+     *
+     * @param report_channel Execution report channel
+     * @param report_stream_id Execution report stream ID
+     * @return true if successful; call after the execution engine publishes reports
+     */
+    bool subscribeExecutionReports(const std::string& report_channel,
+                                  std::int32_t report_stream_id);
+    
+    /**
+     * @brief Add a strategy instance
+     *
+     * Its orders carry strategy id N for the Nth instance added, counting
+     * from 0. If none is added before start(), the engine runs
+     * DC_Strategy_v1 at leverage 1 on its own. Call before start().
+     * @return false if the name is unknown, DC_Rules_v1 comes without
+     *         rules, or kMaxStrategies are hosted
+     */
+    bool addStrategy(const StrategyInstanceSettings& settings);
+    
+    /**
+     * @brief Run the strategy instances on worker threads
+     * @param threads 0 runs them on the engine thread; capped at the
+     *        number of instances and kMaxStrategyWorkers. Set before start().
+     */
+    void setWorkerThreads(std::size_t threads) { worker_threads_ = threads; }
+    
+    /**
+     * @brief Set how long an order may go without a final report
+     *
+     * A symbol with a working order older than this is released again, so a
+     * lost report cannot block it for good. Set before start().
+     */
+    void setWorkingOrderTimeout(std::int64_t timeout_ns) { working_order_timeout_ns_ = timeout_ns; }
+    
+    /**
+     * @brief Limit each strategy's order rate per symbol and across all symbols
+     *
+     * Orders over either rate are dropped and counted as throttled. A rate
+     * of 0 disables that bucket. Set before start().
+     */
+    void setOrderThrottle(const TokenBucketLimit& per_symbol, const TokenBucketLimit& global) {
+        symbol_throttle_ = per_symbol;
+        global_throttle_limit_ = global;
+    }
+    
+    /**
+     * @brief Net each strategy's orders per symbol and publish them as one batch message
+     * @param enable false publishes every order as it is generated
+     * @param window_ns How long a batch stays open; 0 flushes once per poll batch
+     *
+     * Set before start().
+     */
+    void enableOrderBatching(bool enable, std::int64_t window_ns) {
+        batching_enabled_ = enable;
+        batch_window_ns_ = window_ns;
+    }
+    
+    /**
+     * @brief Check every order against pre-trade limits before publishing
+     * @param enable false publishes orders unchecked; set before start()
+     */
+    void enableRiskChecks(bool enable) { risk_checks_enabled_ = enable; }
+    
+    /**
+     * @brief Replace the pre-trade limit table
+     *
+     * Every strategy checks its own orders against its own copy of the
+     * table. Safe while the engine is running: the threads pick the new
+     * table up at their next duty cycle, and this call returns once the old
+     * tables are no longer in use. Do not call from an engine thread.
+     */
+    void setRiskLimits(std::unique_ptr<RiskLimitTable> limits);
+    
+    /**
+     * @brief Change a hosted strategy's leverage, regime use, thetas or rules
+     *
+     * Safe while the engine is running: the new parameters are published as
+     * one immutable block, the strategy's thread picks them up with its next
+     * signal, and this call returns once the old block is no longer in use.
+     * The strategy itself cannot change. Do not call from an engine thread.
+     * @return false if the id is unknown, the name differs or DC_Rules_v1
+     *         comes without rules
+     */
+    bool updateStrategy(std::size_t strategy_id, const StrategyInstanceSettings& settings);
+    
+    /**
+     * @brief Set per-symbol leverage factors
+     *
+     * Each strategy's leverage is multiplied by the symbol's factor. Safe
+     * while the engine is running: the engine thread resolves the new
+     * factors for every known symbol at the top of its next duty cycle, and
+     * this call returns once the old table is no longer in use. Do not call
+     * from an engine thread.
+     */
+    void setSymbolParameters(std::unique_ptr<SymbolParameterTable> parameters);
+    
+    /**
+     * @brief Trade the consensus of a symbol's thetas instead of each of them
+     *
+     * With the market data processor running a theta ladder, a symbol's
+     * trend at each rung is kept as one bit; a signal at a voting rung is
+     * handed to the strategies only if it moves the weighted vote over the
+     * quorum in its direction, and is otherwise counted as outvoted.
+     * Signals at rungs without a weight pass through as before. Strategies'
+     * theta subsets still apply to the signals that get through. Call
+     * before start().
+     * @param weights Weight of each rung of the ladder, by theta index
+     * @param quorum Weighted votes a direction needs; 0 for a strict majority
+     * @return false if the weights or the quorum are invalid
+     */
+    bool setThetaEnsemble(const std::vector<std::uint32_t>& weights, std::uint32_t quorum);
+    
+    /**
+     * @brief Track lead-lag statistics over symbol pairs as strategy features
+     *
+     * The engine thread records each symbol's DC events at its own theta
+     * (ladder rung 0) and updates the pairs the symbol follows in; every
+     * signal then carries the symbol's features against the leader it has
+     * agreed with most, in StrategyContext::lead_lag. Call before start().
+     * @return false if a pair or the settings are invalid
+     */
+    bool setLeadLagPairs(const std::vector<Config::LeadLagPairConfig>& pairs, const LeadLagSettings& settings);
+    
     /**
      * @brief Start the strategy engine
      */
@@ -85,64 +208,196 @@ public:
     
     /**
      * @brief Enable/disable HMM regime detection
-     * @param enable true to enable HMM
+     * @param enable true to enable HMM; has no effect until a regime model is
+     *        loaded, and only strategies with enable_hmm use the regime.
+     *        Safe while running.
      */
-    void enableHMM(bool enable) { hmm_enabled_ = enable; }
+    void enableHMM(bool enable) { hmm_enabled_.store(enable, std::memory_order_relaxed); }
     
     /**
-     * @brief Set leverage factor
-     * @param leverage New leverage factor
+     * @brief Load the regime HMMs written by hmm_trainer
+     *
+     * Each symbol runs its own forward filter, updated once per DC event,
+     * over its own model or the default one if it had too little history
+     * to train. Call before start().
+     * @return false if the file is missing or malformed
      */
-    void setLeverageFactor(double leverage) { leverage_factor_ = leverage; }
+    bool loadRegimeModel(const std::string& path);
     
     /**
      * @brief Get strategy statistics
+     *
+     * Signal and report counts are the engine's; order counts are summed
+     * over the strategies and latencies are the worst strategy's.
      */
-    struct Statistics {
-        std::uint64_t signals_processed;
-        std::uint64_t orders_generated;
-        std::uint64_t buy_signals;
-        std::uint64_t sell_signals;
-        std::int64_t avg_strategy_latency_ns;
-        std::int64_t max_strategy_latency_ns;
-        MarketState current_market_state;
-    };
+    using Statistics = StrategyStatistics;
     
     Statistics getStatistics() const;
+    
+    /**
+     * @brief Number of hosted strategies; fixed once started
+     */
+    std::size_t strategyCount() const { return strategies_.size(); }
+    
+    /**
+     * @brief Name of a hosted strategy, by strategy id
+     */
+    const std::string& strategyName(std::size_t strategy_id) const { return strategies_[strategy_id]->name(); }
+    
+    /**
+     * @brief Statistics of one hosted strategy, by strategy id
+     */
+    Statistics getStrategyStatistics(std::size_t strategy_id) const {
+        return strategies_[strategy_id]->getStatistics();
+    }
+    
+    /**
+     * @brief Get pre-trade check counts by outcome, summed over the strategies
+     */
+    RiskGate::Statistics getRiskStatistics() const;
+
+    /**
+     * @brief Set the fragment limit range used when polling DC signals
+     * @param min_limit Limit under light load
+     * @param max_limit Limit when backlogged (equal to min_limit for a fixed limit)
+     */
+    void setPollLimits(int min_limit, int max_limit) {
+        poll_limit_.setLimits(min_limit, max_limit);
+        report_poll_limit_.setLimits(min_limit, max_limit);
+    }
+    
+    /**
+     * @brief Get poll batch statistics (chosen limits and fragments per poll)
+     */
+    AdaptivePollLimit::Statistics getPollStatistics() const { return poll_limit_.getStatistics(); }
+    
+    /**
+     * @brief Get poll batch statistics for the execution report subscription
+     */
+    AdaptivePollLimit::Statistics getReportPollStatistics() const { return report_poll_limit_.getStatistics(); }
+
+    static constexpr std::size_t kMaxStrategies = 64;
+    static constexpr std::size_t kMaxStrategyWorkers = 16;
 
 private:
     std::shared_ptr<aeron::Aeron> aeron_;
     std::shared_ptr<aeron::Subscription> input_subscription_;
     std::shared_ptr<aeron::Publication> output_publication_;
+    std::shared_ptr<aeron::Subscription> report_subscription_;
     
     std::atomic<bool> running_;
+    std::atomic<bool> workers_running_;   // Cleared once the engine thread has stopped feeding them
     std::unique_ptr<std::thread> processing_thread_;
+    AdaptivePollLimit poll_limit_;
+    AdaptivePollLimit report_poll_limit_;
+    
+    // Regime detection, shared by every strategy that uses it
+    std::atomic<bool> hmm_enabled_;
+    std::atomic<bool> regime_wanted_;    // Some strategy uses the regime
+    MarketState current_market_state_;   // Regime of the symbol of the latest signal
+    RegimeModelSet regime_models_;
+    
+    // Per-symbol regime, indexed by symbols_ ids; engine thread only. Only
+    // events at the symbol's own theta (ladder rung 0), which the models are
+    // trained on, update it; other rungs read it.
+    struct SymbolRegime {
+        const RegimeModel* regime_model;  // Resolved on the symbol's first DC event
+        RegimeBelief regime_belief;       // Forward filter over regime_model
+        MarketState market_state;
+    };
+    SymbolTable symbols_;
+    std::vector<SymbolRegime> symbol_regimes_;
     
-    // Strategy parameters
-    bool hmm_enabled_;
-    double leverage_factor_;
-    MarketState current_market_state_;
+    // Settings applied to every strategy at start()
+    std::int64_t working_order_timeout_ns_;
+    TokenBucketLimit symbol_throttle_;
+    TokenBucketLimit global_throttle_limit_;
+    bool batching_enabled_;
+    std::int64_t batch_window_ns_;
+    bool risk_checks_enabled_;
+    std::unique_ptr<RiskLimitTable> risk_limits_;  // Copied into each strategy's gate
+    
+    // Strategy instances; each is an RCU reader through the thread running it.
+    // The engine thread reads through rcu_reader_.
+    RcuDomain rcu_;
+    RcuDomain::ReaderId rcu_reader_;
+    std::vector<std::unique_ptr<StrategyInstance>> strategies_;
+    
+    // Per-symbol leverage resolved from the published table, indexed by
+    // symbols_ ids; engine thread only, so a signal costs one indexed load
+    RcuPointer<SymbolParameterTable> symbol_parameters_;
+    std::atomic<std::uint64_t> symbol_parameters_version_;  // Bumped after each table is published
+    std::uint64_t applied_symbol_parameters_version_;
+    std::vector<double> symbol_leverage_;
+    
+    // Lead-lag pairs over symbols_ ids; engine thread only
+    bool lead_lag_enabled_;
+    LeadLagTable lead_lag_;
+    
+    // Theta ensemble; votes indexed by symbols_ ids, engine thread only
+    bool ensemble_enabled_;
+    ThetaEnsemble theta_ensemble_;
+    std::vector<ThetaEnsemble::Votes> symbol_votes_;
+    
+    // Decoded work for a worker thread
+    struct StrategyEvent {
+        enum class Kind : std::uint8_t { SIGNAL, REPORT };
+        Kind kind;
+        MarketState market_state;
+        SymbolId symbol_id;
+        double symbol_leverage;
+        LeadLagFeatures lead_lag;
+        StrategyInstance* strategy;   // Report target
+        std::int64_t received_ns;
+        DCSignalMessage signal;
+        ExecutionReport report;
+    };
+    
+    // A set of strategies run by one thread; without worker threads a
+    // single Worker holds every strategy and the engine thread runs it
+    struct Worker {
+        Worker(std::size_t capacity, RcuDomain::ReaderId reader) : events(capacity), rcu_reader(reader) {}
+        SpscRing<StrategyEvent> events;
+        std::vector<StrategyInstance*> strategies;
+        RcuDomain::ReaderId rcu_reader;
+        std::thread thread;
+    };
+    std::size_t worker_threads_;
+    std::vector<RcuDomain::ReaderId> worker_readers_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    bool threaded_;
+    std::vector<std::size_t> worker_of_strategy_;  // Indexed by strategy id
     
     // Statistics
     mutable std::mutex stats_mutex_;
-    Statistics statistics_;
+    std::uint64_t signals_processed_;
+    std::uint64_t signals_outvoted_;
+    std::uint64_t execution_reports_;
     
     // Processing methods
     void processLoop();
+    void workerLoop(Worker& worker);
     void processDCSignal(const aeron::concurrent::AtomicBuffer& buffer,
                         util::index_t offset,
                         util::index_t length);
+    void processExecutionReport(const aeron::concurrent::AtomicBuffer& buffer,
+                               util::index_t offset,
+                               util::index_t length);
+    void dispatch(Worker& worker, const StrategyEvent& event);
+    void run(Worker& worker, const StrategyEvent& event);
+    bool flushDueBatches(Worker& worker, std::int64_t now_ns);
     
-    SignalType generateTradingSignal(const DCSignalMessage& dc_signal);
-    double calculateOrderQuantity(SignalType signal, double price);
-    bool publishTradingOrder(const TradingOrder& order);
+    // Order publication shared by the strategies
+    bool publish(const std::uint8_t* data, std::size_t length) override;
     
-    // HMM-related methods
-    void updateMarketState(const DCSignalMessage& dc_signal);
-    double getVolatilityAdjustedLeverage() const;
+    // Per-symbol parameters
+    void applySymbolParameters();
+    double symbolLeverage(SymbolId symbol_id);
+    bool outvoted(const DCSignalMessage& dc_signal, SymbolId symbol_id);
     
-    // Latency tracking
-    void updateLatencyStats(std::int64_t latency_ns);
+    // HMM-related methods
+    MarketState updateMarketState(const DCSignalMessage& dc_signal, SymbolId symbol_id);
+    MarketState symbolMarketState(SymbolId symbol_id) const;
 };
 
-} // namespace trading 
\ No newline at end of file
+} // namespace trading 
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/Rcu.h"
+#include "common/SymbolTable.h"
+#include "common/TokenBucket.h"
+#include "market_data/MarketDataMessages.h"
+#include "strategy/DCStrategies.h"
+#include "strategy/OrderBatcher.h"
+#include "strategy/RiskGate.h"
+#include "strategy/StrategyMessages.h"
+#include "execution/ExecutionMessages.h"
+
+namespace trading {
+
+/**
+ * @brief One strategy hosted by the StrategyEngine
+ */
+struct StrategyInstanceSettings {
+    std::string name;            // One of strategyNames()
+    double leverage_factor;
+    bool enable_hmm;             // Size by the symbol's regime when the engine detects one
+    std::vector<double> thetas;  // DC thresholds it trades; empty trades every signal
+    std::shared_ptr<const RuleTable> rules;  // Compiled rules, DC_Rules_v1 only
+    bool trade_synthetics;       // Also order on signals of synthetic instruments, which have no venue of their own
+};
+
+/**
+ * @brief The parameters of a running strategy instance
+ *
+ * Immutable once published; a change builds a new block and swaps it in
+ * through RCU, so the instance's thread never sees a half-written one.
+ */
+struct StrategyParameters {
+    StrategyVariant strategy;    // Carries the compiled rules of DC_Rules_v1
+    double leverage_factor;
+    bool use_regime;
+    std::vector<double> thetas;
+    bool trade_synthetics;
+};
+
+/**
+ * @brief Strategy statistics
+ */
+struct StrategyStatistics {
+    std::uint64_t signals_processed;
+    std::uint64_t signals_outvoted;    // Left out by the theta ensemble; engine only
+    std::uint64_t orders_generated;
+    std::uint64_t orders_suppressed;   // Already at target or order still working
+    std::uint64_t orders_throttled;
+    std::uint64_t orders_netted;       // Batched orders cancelled out by an opposite order
+    std::uint64_t order_batches;
+    std::uint64_t orders_risk_rejected;
+    std::uint64_t execution_reports;
+    std::uint64_t buy_signals;
+    std::uint64_t sell_signals;
+    std::int64_t avg_strategy_latency_ns;
+    std::int64_t max_strategy_latency_ns;
+    MarketState current_market_state;
+};
+
+/**
+ * @brief Where a strategy instance sends its orders
+ *
+ * Called from the instance's thread; with several worker threads the
+ * implementation must accept concurrent calls.
+ */
+class OrderPublisher {
+public:
+    virtual ~OrderPublisher() = default;
+
+    /**
+     * @brief Send a bare TradingOrder or an order batch message
+     * @return false if the message was not sent
+     */
+    virtual bool publish(const std::uint8_t* data, std::size_t length) = 0;
+};
+
+/**
+ * @brief A strategy and all of its order state
+ *
+ * Turns decoded DC signals into orders tagged with the instance's id:
+ * sizes them against its own per-symbol position, throttles, runs the
+ * pre-trade checks and optionally nets them into batches. Symbol ids and
+ * regimes come from the engine, which resolves them once per signal for
+ * every instance. Everything except getStatistics(), getRiskStatistics(),
+ * setRiskLimits() and updateParameters() must be called from the thread
+ * that owns the instance, which must also be a reader of the RCU domain.
+ */
+class StrategyInstance {
+public:
+    StrategyInstance(std::uint16_t id, const StrategyVariant& strategy, const StrategyInstanceSettings& settings,
+                     RcuDomain& rcu, OrderPublisher& publisher, std::size_t max_symbols);
+
+    std::uint16_t id() const { return id_; }
+    const std::string& name() const { return name_; }
+    bool usesRegime() const { return parameters_.read()->use_regime; }
+
+    /**
+     * @brief Whether the instance trades signals detected at a threshold
+     */
+    bool tradesTheta(double theta) const;
+
+    /**
+     * @brief Whether the instance trades a signal: its threshold, and a
+     *        synthetic instrument's only when it opted in
+     */
+    bool tradesSignal(const DCSignalMessage& dc_signal) const;
+
+    /**
+     * @brief How positions are learnt from execution reports
+     * @param reports false assumes every published order fills
+     * @param own_fills true builds the position from this instance's fills,
+     *        for when other strategies trade the same symbols; false takes
+     *        the reported position
+     */
+    void setReportMode(bool reports, bool own_fills) {
+        reports_ = reports;
+        own_fills_ = own_fills;
+    }
+
+    void setWorkingOrderTimeout(std::int64_t timeout_ns) { working_order_timeout_ns_ = timeout_ns; }
+
+    void setOrderThrottle(const TokenBucketLimit& per_symbol, const TokenBucketLimit& global) {
+        symbol_throttle_ = per_symbol;
+        global_throttle_limit_ = global;
+    }
+
+    void enableOrderBatching(bool enable, std::int64_t window_ns) {
+        batching_enabled_ = enable;
+        batch_window_ns_ = window_ns;
+    }
+
+    void enableRiskChecks(bool enable) { risk_checks_enabled_ = enable; }
+
+    /**
+     * @brief Replace the pre-trade limit table; blocks for one grace period
+     */
+    void setRiskLimits(std::unique_ptr<RiskLimitTable> limits) { risk_gate_.updateLimits(std::move(limits)); }
+
+    /**
+     * @brief Replace leverage, regime use, thetas and rules while running
+     *
+     * The owning thread picks the new parameters up with its next signal.
+     * Blocks for one grace period; never call from a reader of the domain.
+     * @return false if the settings name another strategy or DC_Rules_v1
+     *         comes without rules; the current parameters are kept
+     */
+    bool updateParameters(const StrategyInstanceSettings& settings);
+
+    /**
+     * @brief Handle a DC signal
+     * @param symbol_id Engine symbol id, kInvalidSymbolId if the table is full
+     * @param market_state Symbol's regime, UNKNOWN when the engine detects none
+     * @param symbol_leverage Symbol's leverage factor, applied on top of the strategy's
+     * @param received_ns When the engine decoded the signal, for latency
+     * @param lead_lag Symbol's lead-lag features, passed on in the strategy context
+     */
+    void onSignal(const DCSignalMessage& dc_signal, SymbolId symbol_id, MarketState market_state,
+                  double symbol_leverage, std::int64_t received_ns, const LeadLagFeatures& lead_lag = LeadLagFeatures{});
+
+    /**
+     * @brief Apply an execution report for one of this instance's orders
+     */
+    void onExecutionReport(const ExecutionReport& report, SymbolId symbol_id);
+
+    /**
+     * @brief Publish the open batch if its window has passed
+     * @return true while a batch is still open
+     */
+    bool flushDue(std::int64_t now_ns);
+
+    /**
+     * @brief Publish the open batch now
+     */
+    void flush();
+
+    StrategyStatistics getStatistics() const;
+    RiskGate::Statistics getRiskStatistics() const;
+
+private:
+    // Per-symbol order state, indexed by engine symbol ids
+    struct SymbolState {
+        double position;              // Own or reported position, or the assumed one without reports
+        double batched_quantity;      // Signed quantity waiting in the open batch
+        std::uint32_t working_orders; // Published, no final report yet
+        std::int64_t last_order_ns;
+        TokenBucket throttle;
+    };
+
+    std::uint16_t id_;
+    std::string name_;
+    RcuPointer<StrategyParameters> parameters_;
+    OrderPublisher& publisher_;
+
+    std::vector<SymbolState> symbol_states_;
+    bool reports_;
+    bool own_fills_;
+    std::int64_t working_order_timeout_ns_;
+    TokenBucketLimit symbol_throttle_;
+    TokenBucketLimit global_throttle_limit_;
+    TokenBucket global_throttle_;
+
+    // Order netting
+    OrderBatcher order_batcher_;
+    bool batching_enabled_;
+    std::int64_t batch_window_ns_;
+    std::int64_t batch_opened_ns_;
+
+    RiskGate risk_gate_;
+    bool risk_checks_enabled_;
+
+    mutable std::mutex stats_mutex_;
+    StrategyStatistics statistics_;
+
+    // Bumped on signals that send nothing, so those stay lock-free
+    std::atomic<std::uint64_t> orders_suppressed_;
+    std::atomic<std::uint64_t> orders_throttled_;
+
+    SymbolState* symbolState(SymbolId symbol_id);
+    bool sizeAgainstPosition(SymbolState& state, SignalType signal, double& quantity, std::int64_t now_ns);
+    void onOrderPublished(SymbolState* state, const TradingOrder& order);
+    void updateLatencyStats(std::int64_t latency_ns);
+};
+
+} // namespace trading
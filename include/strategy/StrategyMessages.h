@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "common/HopTimestamps.h"
+
+namespace trading {
+
+/**
+ * @brief Trading signal types
+ *
+ * One byte wide so messages can carry a strategy tag in the padding after it.
+ */
+enum class SignalType : std::uint8_t {
+    NONE,
+    BUY,
+    SELL,
+    HOLD
+};
+
+/**
+ * @brief Trading order structure
+ */
+struct TradingOrder {
+    std::int64_t timestamp;
+    SignalType signal;
+    std::uint16_t strategy_id;         // Engine strategy that generated the order
+    double price;
+    double quantity;
+    char symbol[16];
+    std::int64_t strategy_latency_ns;  // Time from DC event to order generation
+    HopTimestamps hops;                // Carried from the DC signal, plus order creation
+};
+
+/**
+ * @brief Header of a batched order message
+ *
+ * A batch message is this header followed by count TradingOrder records,
+ * at most one per symbol. Single orders are still sent as a bare
+ * TradingOrder; receivers tell the two apart by length and magic.
+ */
+struct TradingOrderBatchHeader {
+    std::uint32_t magic;
+    std::uint32_t count;
+};
+
+constexpr std::uint32_t kTradingOrderBatchMagic = 0x4254524F;  // "ORTB"
+constexpr std::uint32_t kMaxOrdersPerBatch = 256;
+
+/**
+ * @brief Decode a bare order or a whole batch message
+ *
+ * A batch is larger than one MTU once it holds more than a handful of
+ * orders, so it must reach this reassembled; a fragment of one matches
+ * neither layout and is refused rather than read as orders.
+ * @param on_order Called with each order, in message order
+ * @return false, delivering nothing, if the message is neither
+ */
+template <typename OnOrder>
+bool decodeOrderMessage(const std::uint8_t* data, std::size_t length, OnOrder&& on_order) {
+    TradingOrder order;
+    if (length == sizeof(TradingOrder)) {
+        std::memcpy(&order, data, sizeof(order));
+        on_order(order);
+        return true;
+    }
+    
+    TradingOrderBatchHeader header;
+    if (length < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kTradingOrderBatchMagic || header.count > kMaxOrdersPerBatch ||
+        length != sizeof(header) + header.count * sizeof(TradingOrder)) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < header.count; ++i) {
+        std::memcpy(&order, data + sizeof(header) + i * sizeof(TradingOrder), sizeof(order));
+        on_order(order);
+    }
+    return true;
+}
+
+} // namespace trading
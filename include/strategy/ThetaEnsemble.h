@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/DCIndicator.h"
+
+namespace trading {
+
+/**
+ * @brief Weighted vote over a symbol's trends at several DC thresholds
+ *
+ * Each symbol keeps one bit per theta of its ladder: whether that theta
+ * has reported a trend yet, and whether the trend is up. A DC event sets
+ * or clears its theta's bit; the weighted votes for up and down are then
+ * popcounts of the masks against the bit planes of the weights, so an
+ * event costs the same however many thetas vote. A signal is traded only
+ * when it moves the consensus to its own direction.
+ */
+class ThetaEnsemble {
+public:
+    static constexpr std::size_t kMaxThetas = 64;
+    static constexpr std::uint32_t kMaxWeight = 255;
+
+    /**
+     * @brief One symbol's trends, bit i for theta index i
+     */
+    struct Votes {
+        std::uint64_t known;   // Theta has seen a DC event
+        std::uint64_t up;      // Its latest event was an upturn
+        DCEventType consensus; // NONE until a side reaches the quorum
+    };
+
+    static constexpr Votes kNoVotes{0, 0, DCEventType::NONE};
+
+    ThetaEnsemble();
+
+    /**
+     * @brief Set the weights of the theta ladder and the quorum
+     * @param weights Weight of theta index i, 0 to kMaxWeight; signals at
+     *        indices past the list are not voted on
+     * @param quorum Weighted votes a side needs; 0 asks for a strict majority
+     * @param error Set to the first problem found
+     * @return false, keeping the current settings, if there are no or more
+     *         than kMaxThetas weights, a weight is out of range, or the quorum
+     *         is not above half of the total weight, so both sides could win
+     */
+    bool configure(const std::vector<std::uint32_t>& weights, std::uint32_t quorum, std::string& error);
+
+    /**
+     * @brief Whether signals at a theta index take part in the vote
+     */
+    bool votesOn(std::uint8_t theta_index) const { return theta_index < thetas_; }
+
+    /**
+     * @brief Apply a DC event at a voting theta
+     * @return true if the event moved the consensus to its direction
+     */
+    bool vote(Votes& votes, std::uint8_t theta_index, DCEventType event) const {
+        // Branch-free: event directions are unpredictable
+        const std::uint64_t bit = std::uint64_t(1) << theta_index;
+        const std::uint64_t up_bit = event == DCEventType::UPTURN ? bit : 0;
+        votes.known |= bit;
+        votes.up = (votes.up & ~bit) | up_bit;
+
+        // The quorum is a strict majority, so at most one side reaches it
+        const int up = weight(votes.up) >= quorum_;
+        const int down = weight(votes.known & ~votes.up) >= quorum_;
+        const DCEventType consensus = static_cast<DCEventType>(up * static_cast<int>(DCEventType::UPTURN) +
+                                                               down * static_cast<int>(DCEventType::DOWNTURN));
+        const bool moved = (consensus == event) & (consensus != votes.consensus);
+        votes.consensus = consensus;
+        return moved;
+    }
+
+    /**
+     * @brief Weighted votes of the thetas in a mask
+     */
+    std::uint32_t weight(std::uint64_t mask) const {
+        std::uint32_t total = 0;
+        for (std::size_t plane = 0; plane < planes_; ++plane) {
+            total += static_cast<std::uint32_t>(__builtin_popcountll(mask & weight_planes_[plane])) << plane;
+        }
+        return total;
+    }
+
+    std::size_t thetas() const { return thetas_; }
+    std::uint32_t quorum() const { return quorum_; }
+    std::uint32_t totalWeight() const { return total_weight_; }
+
+private:
+    // Bit i of plane p is bit p of theta i's weight; equal weights need one plane
+    std::array<std::uint64_t, 8> weight_planes_;
+    std::size_t planes_;
+    std::size_t thetas_;
+    std::uint32_t quorum_;
+    std::uint32_t total_weight_;
+};
+
+} // namespace trading
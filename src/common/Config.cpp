@@ -1,15 +1,44 @@
 #include "common/Config.h"
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <utility>
 
 namespace trading {
 
+namespace {
+
+// Absent bounds leave that side of a range open
+std::vector<Config::TradingRuleConfig> loadTradingRules(const nlohmann::json& rules) {
+    constexpr double kInfinity = std::numeric_limits<double>::infinity();
+    std::vector<Config::TradingRuleConfig> loaded;
+    for (auto& rule : rules) {
+        Config::TradingRuleConfig rule_config;
+        rule_config.event = rule.value("event", "any");
+        rule_config.regime = rule.value("regime", "any");
+        rule_config.position = rule.value("position", "any");
+        rule_config.min_return = rule.value("min_return", -kInfinity);
+        rule_config.max_return = rule.value("max_return", kInfinity);
+        rule_config.min_tmv = rule.value("min_tmv", -kInfinity);
+        rule_config.max_tmv = rule.value("max_tmv", kInfinity);
+        rule_config.action = rule.value("action", "none");
+        rule_config.size = rule.value("size", 1.0);
+        loaded.push_back(rule_config);
+    }
+    return loaded;
+}
+
+} // namespace
+
 Config& Config::getInstance() {
     static Config instance;
     return instance;
 }
 
 bool Config::loadConfig(const std::string& config_file) {
+    // Start from defaults so sections missing from the file stay valid
+    setDefaults();
+    
     try {
         std::ifstream file(config_file);
         if (!file.is_open()) {
@@ -48,6 +77,14 @@ bool Config::loadConfig(const std::string& config_file) {
                 execution_config_.directory = exec_config.value("directory", "/tmp/aeron");
                 execution_config_.timeout_ms = exec_config.value("timeout_ms", 5000);
             }
+            
+            if (aeron_config.contains("execution_reports")) {
+                auto& report_config = aeron_config["execution_reports"];
+                execution_report_config_.channel = report_config.value("channel", "aeron:ipc");
+                execution_report_config_.stream_id = report_config.value("stream_id", 1004);
+                execution_report_config_.directory = report_config.value("directory", "/tmp/aeron");
+                execution_report_config_.timeout_ms = report_config.value("timeout_ms", 5000);
+            }
         }
         
         // Load DC strategy configuration
@@ -56,6 +93,28 @@ bool Config::loadConfig(const std::string& config_file) {
             dc_config_.theta = dc_config.value("theta", 0.004);
             dc_config_.enable_tmv_calculation = dc_config.value("enable_tmv_calculation", true);
             dc_config_.enable_time_adjustment = dc_config.value("enable_time_adjustment", true);
+            
+            if (dc_config.contains("adaptive_theta")) {
+                auto& adaptive_config = dc_config["adaptive_theta"];
+                dc_config_.adaptive_theta.enabled = adaptive_config.value("enabled", false);
+                dc_config_.adaptive_theta.event_interval_s = adaptive_config.value("event_interval_s", 60.0);
+                dc_config_.adaptive_theta.half_life_ticks = adaptive_config.value("half_life_ticks", 500);
+                dc_config_.adaptive_theta.min_scale = adaptive_config.value("min_scale", 0.25);
+                dc_config_.adaptive_theta.max_scale = adaptive_config.value("max_scale", 4.0);
+            }
+            dc_config_.theta_scales = dc_config.value("theta_scales", std::vector<double>{1.0});
+        }
+        
+        // Per-symbol parameters fall back to the global ones
+        symbol_parameters_.clear();
+        if (json_config.contains("symbols")) {
+            for (auto& [symbol, parameters] : json_config["symbols"].items()) {
+                SymbolParameterConfig symbol_config;
+                symbol_config.symbol = symbol;
+                symbol_config.theta = parameters.value("theta", dc_config_.theta);
+                symbol_config.leverage_factor = parameters.value("leverage_factor", 1.0);
+                symbol_parameters_.push_back(symbol_config);
+            }
         }
         
         // Load strategy settings
@@ -65,7 +124,176 @@ bool Config::loadConfig(const std::string& config_file) {
             strategy_settings_.enable_hmm = strategy_settings.value("enable_hmm", false);
             strategy_settings_.hmm_states = strategy_settings.value("hmm_states", 2);
             strategy_settings_.hmm_max_iterations = strategy_settings.value("hmm_max_iterations", 200);
+            strategy_settings_.hmm_model_file = strategy_settings.value("hmm_model_file", "regime_model.rhmm");
+            strategy_settings_.hmm_restarts = strategy_settings.value("hmm_restarts", 4);
+            strategy_settings_.hmm_trainer_threads = strategy_settings.value("hmm_trainer_threads", 0);
+            strategy_settings_.hmm_min_symbol_events = strategy_settings.value("hmm_min_symbol_events", 200);
             strategy_settings_.leverage_factor = strategy_settings.value("leverage_factor", 1.0);
+            strategy_settings_.trade_synthetics = strategy_settings.value("trade_synthetics", false);
+            strategy_settings_.worker_threads = strategy_settings.value("worker_threads", 0);
+            if (strategy_settings.contains("theta_ensemble")) {
+                auto& ensemble_config = strategy_settings["theta_ensemble"];
+                strategy_settings_.theta_ensemble.enabled = ensemble_config.value("enabled", false);
+                strategy_settings_.theta_ensemble.weights =
+                    ensemble_config.value("weights", std::vector<std::uint32_t>());
+                strategy_settings_.theta_ensemble.quorum = ensemble_config.value("quorum", 0u);
+            }
+            strategy_settings_.rules.clear();
+            if (strategy_settings.contains("rules")) {
+                strategy_settings_.rules = loadTradingRules(strategy_settings["rules"]);
+            }
+            
+            // Instances fall back to the section's settings
+            strategy_settings_.instances.clear();
+            if (strategy_settings.contains("instances")) {
+                for (auto& instance : strategy_settings["instances"]) {
+                    StrategyInstanceConfig instance_config;
+                    instance_config.name = instance.value("name", strategy_settings_.name);
+                    instance_config.leverage_factor =
+                        instance.value("leverage_factor", strategy_settings_.leverage_factor);
+                    instance_config.enable_hmm = instance.value("enable_hmm", strategy_settings_.enable_hmm);
+                    instance_config.thetas = instance.value("thetas", std::vector<double>());
+                    instance_config.trade_synthetics =
+                        instance.value("trade_synthetics", strategy_settings_.trade_synthetics);
+                    instance_config.rules = instance.contains("rules") ?
+                        loadTradingRules(instance["rules"]) : strategy_settings_.rules;
+                    strategy_settings_.instances.push_back(instance_config);
+                }
+            }
+        }
+        
+        // Load lead-lag pair configuration
+        if (json_config.contains("lead_lag")) {
+            auto& lead_lag_config = json_config["lead_lag"];
+            lead_lag_config_.enabled = lead_lag_config.value("enabled", false);
+            lead_lag_config_.max_lag_ns = lead_lag_config.value("max_lag_ns", 100000000ll);
+            lead_lag_config_.half_life_events = lead_lag_config.value("half_life_events", 100);
+            lead_lag_config_.min_samples = lead_lag_config.value("min_samples", 20);
+            lead_lag_config_.pairs.clear();
+            if (lead_lag_config.contains("pairs")) {
+                for (auto& pair : lead_lag_config["pairs"]) {
+                    lead_lag_config_.pairs.push_back({pair.value("leader", ""), pair.value("follower", "")});
+                }
+            }
+        }
+        
+        // Synthetic instruments are keyed by the name their signals carry
+        synthetic_config_.clear();
+        if (json_config.contains("synthetics")) {
+            for (auto& [name, definition] : json_config["synthetics"].items()) {
+                SyntheticConfig synthetic;
+                synthetic.name = name;
+                synthetic.type = definition.value("type", "spread");
+                synthetic.offset = definition.value("offset", 0.0);
+                if (definition.contains("legs")) {
+                    for (auto& leg : definition["legs"]) {
+                        synthetic.legs.push_back({leg.value("symbol", ""), leg.value("weight", 1.0)});
+                    }
+                }
+                synthetic_config_.push_back(synthetic);
+            }
+        }
+        
+        // Load pre-trade risk configuration
+        if (json_config.contains("risk")) {
+            auto& risk_config = json_config["risk"];
+            risk_config_.enabled = risk_config.value("enabled", true);
+            risk_config_.max_position = risk_config.value("max_position", 10000.0);
+            risk_config_.max_notional = risk_config.value("max_notional", 25000.0);
+            risk_config_.max_orders_per_second = risk_config.value("max_orders_per_second", 100u);
+            risk_config_.price_band_bps = risk_config.value("price_band_bps", 500.0);
+            
+            // Per-symbol overrides fall back to the section's limits
+            risk_config_.symbols.clear();
+            if (risk_config.contains("symbols")) {
+                for (auto& [symbol, limits] : risk_config["symbols"].items()) {
+                    RiskSymbolConfig symbol_config;
+                    symbol_config.symbol = symbol;
+                    symbol_config.max_position = limits.value("max_position", risk_config_.max_position);
+                    symbol_config.max_notional = limits.value("max_notional", risk_config_.max_notional);
+                    symbol_config.max_orders_per_second =
+                        limits.value("max_orders_per_second", risk_config_.max_orders_per_second);
+                    symbol_config.price_band_bps = limits.value("price_band_bps", risk_config_.price_band_bps);
+                    risk_config_.symbols.push_back(symbol_config);
+                }
+            }
+        }
+        
+        // Load order throttle configuration
+        if (json_config.contains("order_throttle")) {
+            auto& throttle_config = json_config["order_throttle"];
+            throttle_config_.symbol_orders_per_second = throttle_config.value("symbol_orders_per_second", 10ull);
+            throttle_config_.symbol_burst = throttle_config.value("symbol_burst", 5ull);
+            throttle_config_.global_orders_per_second = throttle_config.value("global_orders_per_second", 200ull);
+            throttle_config_.global_burst = throttle_config.value("global_burst", 50ull);
+        }
+        
+        // Load order batching configuration
+        if (json_config.contains("order_batching")) {
+            auto& batching_config = json_config["order_batching"];
+            order_batching_config_.enabled = batching_config.value("enabled", false);
+            order_batching_config_.window_ns = batching_config.value("window_ns", 0ll);
+        }
+        
+        // Load market data recovery configuration
+        if (json_config.contains("market_data_recovery")) {
+            auto& recovery_config = json_config["market_data_recovery"];
+            recovery_config_.enable_gap_recovery = recovery_config.value("enable_gap_recovery", true);
+            recovery_config_.recording_file = recovery_config.value("recording_file", "market_data.rec");
+            recovery_config_.recording_capacity = recovery_config.value("recording_capacity", 1000000ull);
+            recovery_config_.max_replay_per_cycle = recovery_config.value("max_replay_per_cycle", 64);
+        }
+        
+        // Load simulated venue configuration
+        if (json_config.contains("simulated_venue")) {
+            auto& venue_config = json_config["simulated_venue"];
+            simulated_venue_config_.seed = venue_config.value("seed", 42ull);
+            simulated_venue_config_.base_latency_ns = venue_config.value("base_latency_ns", 10000ll);
+            simulated_venue_config_.latency_jitter_ns = venue_config.value("latency_jitter_ns", 90000ll);
+            simulated_venue_config_.slippage_bps = venue_config.value("slippage_bps", 0.0);
+            simulated_venue_config_.impact_bps_per_unit = venue_config.value("impact_bps_per_unit", 0.0);
+            simulated_venue_config_.slippage_noise_bps = venue_config.value("slippage_noise_bps", 1.0);
+            simulated_venue_config_.partial_fill_probability = venue_config.value("partial_fill_probability", 0.0);
+            simulated_venue_config_.max_partial_fills = venue_config.value("max_partial_fills", 4);
+            simulated_venue_config_.partial_fill_interval_ns = venue_config.value("partial_fill_interval_ns", 5000ll);
+            simulated_venue_config_.max_pending_fills = venue_config.value("max_pending_fills", static_cast<std::size_t>(65536));
+            simulated_venue_config_.match_against_book = venue_config.value("match_against_book", false);
+            simulated_venue_config_.tick_size = venue_config.value("tick_size", 0.00001);
+            simulated_venue_config_.quote_half_spread_bps = venue_config.value("quote_half_spread_bps", 0.5);
+            simulated_venue_config_.quote_levels = venue_config.value("quote_levels", 5);
+            simulated_venue_config_.limit_slippage_bps = venue_config.value("limit_slippage_bps", 5.0);
+            simulated_venue_config_.resting_timeout_ns = venue_config.value("resting_timeout_ns", 1000000000ll);
+            simulated_venue_config_.book_levels = venue_config.value("book_levels", static_cast<std::size_t>(4096));
+            simulated_venue_config_.max_working_orders = venue_config.value("max_working_orders", static_cast<std::size_t>(4096));
+        }
+        
+        // Load trade journal configuration
+        if (json_config.contains("trade_journal")) {
+            auto& journal_config = json_config["trade_journal"];
+            trade_journal_config_.enabled = journal_config.value("enabled", true);
+            trade_journal_config_.path = journal_config.value("path", "trades.journal");
+            trade_journal_config_.segment_capacity = journal_config.value("segment_capacity", 262144ull);
+        }
+        
+        // Load mark-to-market configuration
+        if (json_config.contains("mark_to_market")) {
+            auto& mark_config = json_config["mark_to_market"];
+            mark_to_market_config_.enabled = mark_config.value("enabled", true);
+        }
+        
+        // Load polling configuration
+        if (json_config.contains("polling")) {
+            auto& polling_config = json_config["polling"];
+            polling_config_.adaptive_fragment_limit = polling_config.value("adaptive_fragment_limit", true);
+            polling_config_.fragment_limit = polling_config.value("fragment_limit", 10);
+            polling_config_.min_fragment_limit = polling_config.value("min_fragment_limit", 8);
+            polling_config_.max_fragment_limit = polling_config.value("max_fragment_limit", 256);
+        }
+        
+        // Load hot reload configuration
+        if (json_config.contains("hot_reload")) {
+            auto& reload_config = json_config["hot_reload"];
+            hot_reload_config_.enabled = reload_config.value("enabled", true);
         }
         
         // Load performance configuration
@@ -86,6 +314,16 @@ bool Config::loadConfig(const std::string& config_file) {
     }
 }
 
+bool Config::reloadConfig(const std::string& config_file) {
+    // Load into a copy so a broken edit cannot reset the running configuration
+    Config reloaded;
+    if (!reloaded.loadConfig(config_file)) {
+        return false;
+    }
+    *this = std::move(reloaded);
+    return true;
+}
+
 void Config::setDefaults() {
     // Set default Aeron configurations
     market_data_config_.channel = "aeron:ipc";
@@ -103,17 +341,108 @@ void Config::setDefaults() {
     execution_config_.directory = "/tmp/aeron";
     execution_config_.timeout_ms = 5000;
     
+    execution_report_config_.channel = "aeron:ipc";
+    execution_report_config_.stream_id = 1004;
+    execution_report_config_.directory = "/tmp/aeron";
+    execution_report_config_.timeout_ms = 5000;
+    
     // Set default DC configuration
     dc_config_.theta = 0.004;  // 0.4%
     dc_config_.enable_tmv_calculation = true;
     dc_config_.enable_time_adjustment = true;
+    dc_config_.adaptive_theta.enabled = false;
+    dc_config_.adaptive_theta.event_interval_s = 60.0;
+    dc_config_.adaptive_theta.half_life_ticks = 500;
+    dc_config_.adaptive_theta.min_scale = 0.25;
+    dc_config_.adaptive_theta.max_scale = 4.0;
+    dc_config_.theta_scales = {1.0};
+    symbol_parameters_.clear();
     
     // Set default strategy settings
     strategy_settings_.name = "DC_Strategy_v1";
     strategy_settings_.enable_hmm = false;
     strategy_settings_.hmm_states = 2;
     strategy_settings_.hmm_max_iterations = 200;
+    strategy_settings_.hmm_model_file = "regime_model.rhmm";
+    strategy_settings_.hmm_restarts = 4;
+    strategy_settings_.hmm_trainer_threads = 0;
+    strategy_settings_.hmm_min_symbol_events = 200;
     strategy_settings_.leverage_factor = 1.0;
+    strategy_settings_.trade_synthetics = false;
+    strategy_settings_.rules.clear();
+    strategy_settings_.instances.clear();
+    strategy_settings_.worker_threads = 0;
+    strategy_settings_.theta_ensemble.enabled = false;
+    strategy_settings_.theta_ensemble.weights.clear();
+    strategy_settings_.theta_ensemble.quorum = 0;
+    
+    // Set default lead-lag configuration
+    lead_lag_config_.enabled = false;
+    lead_lag_config_.max_lag_ns = 100000000;  // 100ms
+    lead_lag_config_.half_life_events = 100;
+    lead_lag_config_.min_samples = 20;
+    lead_lag_config_.pairs.clear();
+    synthetic_config_.clear();
+    
+    // Set default pre-trade risk configuration
+    risk_config_.enabled = true;
+    risk_config_.max_position = 10000.0;
+    risk_config_.max_notional = 25000.0;
+    risk_config_.max_orders_per_second = 100;
+    risk_config_.price_band_bps = 500.0;
+    risk_config_.symbols.clear();
+    
+    // Set default order throttle configuration
+    throttle_config_.symbol_orders_per_second = 10;
+    throttle_config_.symbol_burst = 5;
+    throttle_config_.global_orders_per_second = 200;
+    throttle_config_.global_burst = 50;
+    
+    // Set default order batching configuration
+    order_batching_config_.enabled = false;
+    order_batching_config_.window_ns = 0;
+    
+    // Set default market data recovery configuration
+    recovery_config_.enable_gap_recovery = true;
+    recovery_config_.recording_file = "market_data.rec";
+    recovery_config_.recording_capacity = 1000000;
+    recovery_config_.max_replay_per_cycle = 64;
+    
+    // Set default simulated venue configuration
+    simulated_venue_config_.seed = 42;
+    simulated_venue_config_.base_latency_ns = 10000;
+    simulated_venue_config_.latency_jitter_ns = 90000;
+    simulated_venue_config_.slippage_bps = 0.0;
+    simulated_venue_config_.impact_bps_per_unit = 0.0;
+    simulated_venue_config_.slippage_noise_bps = 1.0;
+    simulated_venue_config_.partial_fill_probability = 0.0;
+    simulated_venue_config_.max_partial_fills = 4;
+    simulated_venue_config_.partial_fill_interval_ns = 5000;
+    simulated_venue_config_.max_pending_fills = 65536;
+    simulated_venue_config_.match_against_book = false;
+    simulated_venue_config_.tick_size = 0.00001;
+    simulated_venue_config_.quote_half_spread_bps = 0.5;
+    simulated_venue_config_.quote_levels = 5;
+    simulated_venue_config_.limit_slippage_bps = 5.0;
+    simulated_venue_config_.resting_timeout_ns = 1000000000;
+    simulated_venue_config_.book_levels = 4096;
+    simulated_venue_config_.max_working_orders = 4096;
+    
+    // Set default trade journal configuration
+    trade_journal_config_.enabled = true;
+    trade_journal_config_.path = "trades.journal";
+    trade_journal_config_.segment_capacity = 262144;
+    
+    // Set default mark-to-market configuration
+    mark_to_market_config_.enabled = true;
+    
+    // Set default polling configuration
+    polling_config_.adaptive_fragment_limit = true;
+    polling_config_.fragment_limit = 10;
+    polling_config_.min_fragment_limit = 8;
+    polling_config_.max_fragment_limit = 256;
+    
+    hot_reload_config_.enabled = true;
     
     // Set default performance configuration
     performance_config_.enable_latency_tracking = true;
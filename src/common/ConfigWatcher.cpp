@@ -0,0 +1,69 @@
+#include "common/ConfigWatcher.h"
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace trading {
+
+ConfigWatcher::~ConfigWatcher() {
+    close();
+}
+
+bool ConfigWatcher::watch(const std::string& path) {
+    close();
+
+    const std::size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : path.substr(0, std::max<std::size_t>(slash, 1));
+    file_name_ = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    if (::inotify_add_watch(fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ConfigWatcher::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool ConfigWatcher::changed() {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    // Large enough for many events at once; the directory may be busy
+    alignas(struct inotify_event) char buffer[4096];
+    bool file_changed = false;
+    for (;;) {
+        const ssize_t length = ::read(fd_, buffer, sizeof(buffer));
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length <= 0) {
+            break;  // EAGAIN: every pending event has been read
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            if (event->len > 0 && file_name_ == event->name) {
+                file_changed = true;
+            }
+            offset += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return file_changed;
+}
+
+} // namespace trading
@@ -1,4 +1,5 @@
 #include "common/DCIndicator.h"
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -6,17 +7,72 @@ namespace trading {
 
 DCIndicator::DCIndicator(double theta) 
     : theta_(theta)
+    , base_theta_(theta)
     , current_trend_(0)
     , extreme_price_(std::numeric_limits<double>::quiet_NaN())
     , extreme_timestamp_(0)
     , last_dc_price_(std::numeric_limits<double>::quiet_NaN())
     , last_dc_timestamp_(0)
+    , adaptive_{false, 60.0, 500, 0.25, 4.0}
+    , ewma_alpha_(0.0)
+    , last_price_(0.0)
+    , last_timestamp_(0)
+    , ewma_squared_return_(0.0)
+    , ewma_interval_s_(0.0)
+    , volatility_samples_(0)
 {
 }
 
+void DCIndicator::setTheta(double theta) {
+    base_theta_ = theta;
+    theta_ = adaptive_.enabled ? adaptedTheta() : theta;
+}
+
+void DCIndicator::setAdaptiveTheta(const AdaptiveThetaSettings& settings) {
+    adaptive_ = settings;
+    adaptive_.half_life_ticks = std::max<std::uint32_t>(settings.half_life_ticks, 1);
+    adaptive_.max_scale = std::max(settings.max_scale, settings.min_scale);
+    ewma_alpha_ = 1.0 - std::exp2(-1.0 / adaptive_.half_life_ticks);
+    theta_ = adaptive_.enabled ? adaptedTheta() : base_theta_;
+}
+
+double DCIndicator::getVolatility() const {
+    if (volatility_samples_ < adaptive_.half_life_ticks || ewma_interval_s_ <= 0.0) {
+        return 0.0;
+    }
+    return std::sqrt(ewma_squared_return_ / ewma_interval_s_);
+}
+
+void DCIndicator::updateVolatility(const MarketDataPoint& data_point) {
+    if (last_price_ > 0.0) {
+        const double tick_return = (data_point.price - last_price_) / last_price_;
+        const double interval_s = static_cast<double>(data_point.timestamp - last_timestamp_) * 1e-9;
+        ewma_squared_return_ += ewma_alpha_ * (tick_return * tick_return - ewma_squared_return_);
+        ewma_interval_s_ += ewma_alpha_ * (std::max(interval_s, 0.0) - ewma_interval_s_);
+        volatility_samples_ = volatility_samples_ < adaptive_.half_life_ticks ? volatility_samples_ + 1
+                                                                              : volatility_samples_;
+    }
+    last_price_ = data_point.price;
+    last_timestamp_ = data_point.timestamp;
+    theta_ = adaptedTheta();
+}
+
+double DCIndicator::adaptedTheta() const {
+    const double volatility = getVolatility();
+    if (volatility <= 0.0) {
+        return base_theta_;  // Warming up, or no time has passed between ticks
+    }
+    return std::clamp(volatility * std::sqrt(adaptive_.event_interval_s),
+                      base_theta_ * adaptive_.min_scale, base_theta_ * adaptive_.max_scale);
+}
+
 DCEvent DCIndicator::processDataPoint(const MarketDataPoint& data_point) {
     DCEvent event;
     
+    if (adaptive_.enabled) {
+        updateVolatility(data_point);
+    }
+    
     // Initialize on first data point
     if (std::isnan(extreme_price_)) {
         extreme_price_ = data_point.price;
@@ -77,6 +133,22 @@ DCEvent DCIndicator::processDataPoint(const MarketDataPoint& data_point) {
     return event;
 }
 
+bool DCIndicator::processLateDataPoint(const MarketDataPoint& data_point) {
+    // Points before the last DC event belong to an already-closed trend
+    if (std::isnan(extreme_price_) || data_point.timestamp < last_dc_event_.timestamp) {
+        return false;
+    }
+    
+    bool new_extreme = (current_trend_ >= 0) ? data_point.price > extreme_price_
+                                             : data_point.price < extreme_price_;
+    if (new_extreme) {
+        extreme_price_ = data_point.price;
+        extreme_timestamp_ = data_point.timestamp;
+    }
+    
+    return new_extreme;
+}
+
 void DCIndicator::reset() {
     current_trend_ = 0;
     extreme_price_ = std::numeric_limits<double>::quiet_NaN();
@@ -84,6 +156,13 @@ void DCIndicator::reset() {
     last_dc_price_ = std::numeric_limits<double>::quiet_NaN();
     last_dc_timestamp_ = 0;
     last_dc_event_ = DCEvent();
+    
+    last_price_ = 0.0;
+    last_timestamp_ = 0;
+    ewma_squared_return_ = 0.0;
+    ewma_interval_s_ = 0.0;
+    volatility_samples_ = 0;
+    theta_ = base_theta_;
 }
 
 double DCIndicator::calculateTMV(double current_price, double previous_extreme) const {
@@ -0,0 +1,126 @@
+#include "common/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <utility>
+
+namespace trading {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , fd_(std::exchange(other.fd_, -1))
+    , path_(std::move(other.path_))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        fd_ = std::exchange(other.fd_, -1);
+        path_ = std::move(other.path_);
+    }
+    return *this;
+}
+
+bool MappedFile::create(const std::string& path, std::size_t size) {
+    close();
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        close();
+        return false;
+    }
+
+    size_ = size;
+    path_ = path;
+    return map(true);
+}
+
+bool MappedFile::open(const std::string& path, bool writable) {
+    close();
+
+    fd_ = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0 || st.st_size <= 0) {
+        close();
+        return false;
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    path_ = path;
+    return map(writable);
+}
+
+void MappedFile::close() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    size_ = 0;
+}
+
+void MappedFile::sync(std::size_t offset, std::size_t length) {
+    if (data_ == nullptr || offset >= size_) {
+        return;
+    }
+    std::size_t start = pageAlignDown(offset);
+    length = std::min(length + (offset - start), size_ - start);
+    ::msync(data_ + start, length, MS_ASYNC);
+}
+
+void MappedFile::release(std::size_t offset, std::size_t length) {
+    if (data_ == nullptr || offset >= size_) {
+        return;
+    }
+    // Only whole pages inside the range can be dropped
+    std::size_t start = pageAlignDown(offset + static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) - 1);
+    std::size_t end = pageAlignDown(std::min(offset + length, size_));
+    if (end > start) {
+        ::madvise(data_ + start, end - start, MADV_DONTNEED);
+    }
+}
+
+bool MappedFile::exists(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0;
+}
+
+bool MappedFile::map(bool writable) {
+    int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* addr = ::mmap(nullptr, size_, prot, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) {
+        close();
+        return false;
+    }
+    data_ = static_cast<std::uint8_t*>(addr);
+    return true;
+}
+
+std::size_t MappedFile::pageAlignDown(std::size_t offset) {
+    static const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return offset & ~(page_size - 1);
+}
+
+} // namespace trading
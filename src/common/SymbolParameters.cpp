@@ -0,0 +1,62 @@
+#include "common/SymbolParameters.h"
+#include <cmath>
+
+namespace trading {
+
+namespace {
+
+bool validTheta(double theta) {
+    return theta > 0.0 && theta < 1.0;
+}
+
+bool validLeverage(double leverage_factor) {
+    return leverage_factor > 0.0 && std::isfinite(leverage_factor);
+}
+
+} // namespace
+
+bool SymbolParameterTable::load(const std::vector<Config::SymbolParameterConfig>& symbols, std::string& error) {
+    if (!validTheta(defaults_.theta) || !validLeverage(defaults_.leverage_factor)) {
+        error = "default theta must be in (0, 1) and leverage_factor positive";
+        return false;
+    }
+
+    // Resolve into a scratch list with its own name table; symbols_ changes only once every row passes
+    std::vector<SymbolParameters> resolved;
+    SymbolTable seen(symbols.size() + 1);
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        const Config::SymbolParameterConfig& symbol = symbols[i];
+        const std::string where = "symbol " + std::to_string(i) + " (" + symbol.symbol + "): ";
+        if (symbol.symbol.empty() || symbol.symbol.size() > kMaxSymbolNameLength) {
+            error = where + "name must be 1 to " + std::to_string(kMaxSymbolNameLength) + " characters";
+            return false;
+        }
+        const std::size_t before = seen.size();
+        if (seen.findOrInsert(symbol.symbol.c_str()) < before) {
+            error = where + "listed twice";
+            return false;
+        }
+
+        const SymbolParameters parameters{symbol.theta, symbol.leverage_factor};
+        if (!validTheta(parameters.theta)) {
+            error = where + "theta must be in (0, 1)";
+            return false;
+        }
+        if (!validLeverage(parameters.leverage_factor)) {
+            error = where + "leverage_factor must be positive";
+            return false;
+        }
+        resolved.push_back(parameters);
+    }
+
+    if (symbols_.size() + symbols.size() > symbols_.capacity()) {
+        error = "more than " + std::to_string(symbols_.capacity()) + " symbols";
+        return false;
+    }
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        set(symbols[i].symbol.c_str(), resolved[i]);
+    }
+    return true;
+}
+
+} // namespace trading
@@ -0,0 +1,344 @@
+#include "execution/ExchangeSimulator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace trading {
+
+namespace {
+constexpr std::int64_t kWheelTickNs = 1000;   // 1us slots
+constexpr std::size_t kWheelSlots = 4096;     // ~4ms per rotation
+}
+
+ExchangeSimulator::Settings ExchangeSimulator::Settings::defaults() {
+    Settings settings;
+    settings.seed = 42;
+    settings.base_latency_ns = 10000;         // 10us
+    settings.latency_jitter_ns = 90000;       // up to 100us total, as before
+    settings.slippage_bps = 0.0;
+    settings.impact_bps_per_unit = 0.0;
+    settings.slippage_noise_bps = 1.0;        // +/-0.01%, as before
+    settings.partial_fill_probability = 0.0;
+    settings.max_partial_fills = 4;
+    settings.partial_fill_interval_ns = 5000;
+    settings.max_pending_fills = 65536;
+    settings.match_against_book = false;
+    settings.tick_size = 0.00001;
+    settings.quote_half_spread_bps = 0.5;
+    settings.quote_levels = 5;
+    settings.limit_slippage_bps = 5.0;
+    settings.resting_timeout_ns = 1000000000;  // 1s
+    settings.book_levels = 4096;
+    settings.max_working_orders = 4096;
+    return settings;
+}
+
+ExchangeSimulator::ExchangeSimulator(const Settings& settings)
+    : settings_(settings)
+    , rng_(settings.seed)
+    , pending_(kWheelTickNs, kWheelSlots, settings.max_pending_fills)
+    , statistics_{}
+{
+    configure(settings);
+}
+
+void ExchangeSimulator::configure(const Settings& settings) {
+    settings_ = settings;
+    rng_.seed(settings.seed);
+    pending_ = TimerWheel<VenueEvent>(kWheelTickNs, kWheelSlots, settings.max_pending_fills);
+    ready_fills_.clear();
+    ready_fills_.reserve(settings.max_pending_fills);
+    statistics_ = {};
+
+    symbols_ = SymbolTable();
+    books_.clear();
+    working_.assign(settings.match_against_book ? settings.max_working_orders : 0, WorkingOrder{});
+    free_working_.clear();
+    for (std::size_t i = working_.size(); i > 0; --i) {
+        free_working_.push_back(static_cast<std::uint32_t>(i - 1));
+    }
+}
+
+bool ExchangeSimulator::submitOrder(const TradingOrder& order, OrderId order_id, std::int64_t now_ns) {
+    if (settings_.match_against_book) {
+        // The order reaches the book after the sampled latency and matches there
+        VenueEvent event;
+        event.kind = VenueEvent::Kind::ARRIVAL;
+        event.working_index = 0;
+        event.fill.order_id = order_id;
+        event.fill.submit_ns = now_ns;
+        event.fill.fill_ns = now_ns + sampleLatency();
+        event.fill.signal = order.signal;
+        event.fill.strategy_id = order.strategy_id;
+        event.fill.price = order.price;
+        event.fill.quantity = order.quantity;
+        event.fill.status = ExecutionStatus::PENDING;
+        std::memcpy(event.fill.symbol, order.symbol, sizeof(event.fill.symbol));
+        event.fill.symbol[sizeof(event.fill.symbol) - 1] = '\0';
+        event.fill.hops = order.hops;
+
+        if (!pending_.schedule(event.fill.fill_ns, event)) {
+            statistics_.orders_rejected++;
+            return false;
+        }
+        statistics_.orders_submitted++;
+        return true;
+    }
+
+    int pieces = 1;
+    if (settings_.max_partial_fills > 1 && rng_.uniform() < settings_.partial_fill_probability) {
+        pieces = static_cast<int>(rng_.uniformInt(2, settings_.max_partial_fills));
+    }
+
+    if (pending_.size() + static_cast<std::size_t>(pieces) > pending_.capacity()) {
+        statistics_.orders_rejected++;
+        return false;
+    }
+
+    VenueEvent event;
+    event.kind = VenueEvent::Kind::FILL;
+    event.working_index = 0;
+
+    SimulatedFill& fill = event.fill;
+    fill.order_id = order_id;
+    fill.submit_ns = now_ns;
+    fill.signal = order.signal;
+    fill.strategy_id = order.strategy_id;
+    std::memcpy(fill.symbol, order.symbol, sizeof(fill.symbol));
+    fill.symbol[sizeof(fill.symbol) - 1] = '\0';
+    fill.hops = order.hops;
+
+    const std::int64_t first_fill_ns = now_ns + sampleLatency();
+    const double piece_quantity = order.quantity / pieces;
+    double remaining = order.quantity;
+
+    for (int i = 0; i < pieces; ++i) {
+        bool last = (i == pieces - 1);
+        fill.fill_ns = first_fill_ns + i * settings_.partial_fill_interval_ns;
+        fill.quantity = last ? remaining : piece_quantity;
+        fill.price = samplePrice(order);
+        fill.status = last ? ExecutionStatus::FILLED : ExecutionStatus::PARTIALLY_FILLED;
+        remaining -= fill.quantity;
+
+        pending_.schedule(fill.fill_ns, event);
+    }
+
+    statistics_.orders_submitted++;
+    if (pieces > 1) {
+        statistics_.partial_fills += static_cast<std::uint64_t>(pieces - 1);
+    }
+    return true;
+}
+
+void ExchangeSimulator::onMarketData(const MarketDataMessage& message, std::int64_t now_ns) {
+    if (!settings_.match_against_book || message.price <= 0.0) {
+        return;
+    }
+
+    SymbolId id;
+    SymbolBook* state = bookFor(message.symbol, id);
+    if (state == nullptr) {
+        return;
+    }
+
+    // Replace the previous quotes with a ladder around the new tick
+    for (OrderBook::OrderHandle handle : state->quotes) {
+        state->book.cancel(handle);
+    }
+    statistics_.book_events += state->quotes.size();
+    state->quotes.clear();
+
+    const std::int64_t mid = toTicks(message.price);
+    const std::int64_t half_spread = std::max<std::int64_t>(1,
+        toTicks(message.price * settings_.quote_half_spread_bps / 10000.0));
+    const double quantity = message.volume > 0.0 ? message.volume : 1.0;
+    auto on_match = [&](const OrderBook::Match& match) { onMatch(*state, match, now_ns); };
+
+    for (int level = 0; level < settings_.quote_levels; ++level) {
+        // Quotes that trade through resting simulated orders fill them first
+        OrderBook::AddResult bid = state->book.addLimit(
+            OrderBook::Side::BUY, mid - half_spread - level, quantity, 0, on_match);
+        OrderBook::AddResult ask = state->book.addLimit(
+            OrderBook::Side::SELL, mid + half_spread + level, quantity, 0, on_match);
+
+        if (bid.handle != OrderBook::kInvalidOrder) {
+            state->quotes.push_back(bid.handle);
+        }
+        if (ask.handle != OrderBook::kInvalidOrder) {
+            state->quotes.push_back(ask.handle);
+        }
+    }
+    statistics_.book_events += 2 * static_cast<std::uint64_t>(settings_.quote_levels);
+}
+
+void ExchangeSimulator::onEvent(const VenueEvent& event, std::int64_t now_ns) {
+    switch (event.kind) {
+        case VenueEvent::Kind::FILL:
+            ready_fills_.push_back(event.fill);
+            break;
+        case VenueEvent::Kind::ARRIVAL:
+            onArrival(event.fill, now_ns);
+            break;
+        case VenueEvent::Kind::EXPIRY:
+            onExpiry(event.working_index, event.fill.order_id, now_ns);
+            break;
+    }
+}
+
+void ExchangeSimulator::onArrival(const SimulatedFill& order, std::int64_t now_ns) {
+    // Matching happens at the arrival time, not whenever the wheel was polled
+    const std::int64_t arrival_ns = std::min(order.fill_ns, now_ns);
+
+    SymbolId id;
+    SymbolBook* state = bookFor(order.symbol, id);
+    if (state == nullptr || free_working_.empty() ||
+        (order.signal != SignalType::BUY && order.signal != SignalType::SELL)) {
+        SimulatedFill rejected = order;
+        rejected.fill_ns = arrival_ns;
+        rejected.price = 0.0;
+        rejected.quantity = 0.0;
+        rejected.status = ExecutionStatus::REJECTED;
+        ready_fills_.push_back(rejected);
+        statistics_.orders_rejected++;
+        return;
+    }
+
+    const std::uint32_t index = free_working_.back();
+    free_working_.pop_back();
+    WorkingOrder& working = working_[index];
+    working.order = order;
+    working.remaining = order.quantity;
+    working.symbol = id;
+    working.handle = OrderBook::kInvalidOrder;
+    working.active = true;
+
+    // Marketable limit: may walk the book up to limit_slippage_bps past the order price
+    const bool buy = (order.signal == SignalType::BUY);
+    const double limit_price = order.price * (1.0 + (buy ? 1.0 : -1.0) * settings_.limit_slippage_bps / 10000.0);
+    const std::int64_t limit = buy ? static_cast<std::int64_t>(std::floor(limit_price / settings_.tick_size + 1e-9))
+                                   : static_cast<std::int64_t>(std::ceil(limit_price / settings_.tick_size - 1e-9));
+
+    OrderBook::AddResult result = state->book.addLimit(
+        buy ? OrderBook::Side::BUY : OrderBook::Side::SELL, limit, order.quantity, index + 1,
+        [&](const OrderBook::Match& match) { onMatch(*state, match, arrival_ns); });
+
+    if (!working_[index].active) {
+        return;  // Fully filled on arrival
+    }
+
+    if (result.rejected) {
+        // Could not queue the remainder: close the order out
+        emitWorkingFill(index, 0.0, 0.0, ExecutionStatus::CANCELLED, arrival_ns);
+        return;
+    }
+
+    working_[index].handle = result.handle;
+    if (settings_.resting_timeout_ns > 0) {
+        VenueEvent expiry;
+        expiry.kind = VenueEvent::Kind::EXPIRY;
+        expiry.working_index = index;
+        expiry.fill = order;
+        if (!pending_.schedule(arrival_ns + settings_.resting_timeout_ns, expiry)) {
+            state->book.cancel(result.handle);
+            emitWorkingFill(index, 0.0, 0.0, ExecutionStatus::CANCELLED, arrival_ns);
+        }
+    }
+}
+
+void ExchangeSimulator::onExpiry(std::uint32_t working_index, OrderId order_id, std::int64_t now_ns) {
+    WorkingOrder& working = working_[working_index];
+    if (!working.active || working.order.order_id != order_id) {
+        return;  // Filled before it expired
+    }
+
+    books_[working.symbol].book.cancel(working.handle);
+    statistics_.orders_expired++;
+    emitWorkingFill(working_index, 0.0, 0.0, ExecutionStatus::CANCELLED, now_ns);
+}
+
+void ExchangeSimulator::onMatch(SymbolBook& state, const OrderBook::Match& match, std::int64_t now_ns) {
+    const double price = static_cast<double>(match.price_ticks) * settings_.tick_size;
+
+    // Owner 0 is market liquidity; simulated orders are tagged with working index + 1
+    if (match.maker_owner == 0) {
+        if (match.maker_done) {
+            // Quote used up: forget its handle before the book reuses it
+            auto it = std::find(state.quotes.begin(), state.quotes.end(), match.maker);
+            if (it != state.quotes.end()) {
+                *it = state.quotes.back();
+                state.quotes.pop_back();
+            }
+        }
+    } else {
+        std::uint32_t index = static_cast<std::uint32_t>(match.maker_owner - 1);
+        bool done = match.maker_done;
+        emitWorkingFill(index, price, match.quantity,
+                        done ? ExecutionStatus::FILLED : ExecutionStatus::PARTIALLY_FILLED, now_ns);
+    }
+    if (match.taker_owner != 0) {
+        std::uint32_t index = static_cast<std::uint32_t>(match.taker_owner - 1);
+        bool done = working_[index].remaining - match.quantity <= 1e-9;
+        emitWorkingFill(index, price, match.quantity,
+                        done ? ExecutionStatus::FILLED : ExecutionStatus::PARTIALLY_FILLED, now_ns);
+    }
+}
+
+void ExchangeSimulator::emitWorkingFill(std::uint32_t working_index, double price, double quantity,
+                                        ExecutionStatus status, std::int64_t now_ns) {
+    WorkingOrder& working = working_[working_index];
+
+    SimulatedFill fill = working.order;
+    fill.fill_ns = now_ns;
+    fill.price = price;
+    fill.quantity = quantity;
+    fill.status = status;
+    ready_fills_.push_back(fill);
+
+    working.remaining -= quantity;
+    if (status == ExecutionStatus::PARTIALLY_FILLED) {
+        statistics_.partial_fills++;
+    } else {
+        // Filled or cancelled: the order is finished
+        working.active = false;
+        free_working_.push_back(working_index);
+    }
+}
+
+ExchangeSimulator::SymbolBook* ExchangeSimulator::bookFor(const char* symbol, SymbolId& id) {
+    id = symbols_.findOrInsert(symbol);
+    if (id == kInvalidSymbolId) {
+        return nullptr;
+    }
+    if (id >= books_.size()) {
+        SymbolBook state{OrderBook(settings_.book_levels, settings_.max_working_orders +
+                                   2 * static_cast<std::size_t>(settings_.quote_levels)), {}};
+        state.quotes.reserve(2 * static_cast<std::size_t>(settings_.quote_levels));
+        books_.push_back(std::move(state));
+    }
+    return &books_[id];
+}
+
+std::int64_t ExchangeSimulator::toTicks(double price) const {
+    return static_cast<std::int64_t>(std::llround(price / settings_.tick_size));
+}
+
+ExchangeSimulator::Statistics ExchangeSimulator::getStatistics() const {
+    Statistics stats = statistics_;
+    stats.pending_fills = pending_.size() + ready_fills_.size();
+    stats.working_orders = working_.size() - free_working_.size();
+    return stats;
+}
+
+std::int64_t ExchangeSimulator::sampleLatency() {
+    return settings_.base_latency_ns + rng_.uniformInt(0, settings_.latency_jitter_ns);
+}
+
+double ExchangeSimulator::samplePrice(const TradingOrder& order) {
+    double noise = (rng_.uniform() * 2.0 - 1.0) * settings_.slippage_noise_bps;
+    double adverse_bps = settings_.slippage_bps + 
+                         settings_.impact_bps_per_unit * order.quantity + noise;
+    double direction = (order.signal == SignalType::SELL) ? -1.0 : 1.0;
+    return order.price * (1.0 + direction * adverse_bps / 10000.0);
+}
+
+} // namespace trading
@@ -2,7 +2,6 @@
 #include <iostream>
 #include <cstring>
 #include <algorithm>
-#include <random>
 
 namespace trading {
 
@@ -11,11 +10,27 @@ ExecutionEngine::ExecutionEngine()
     , simulation_mode_(true)
     , initial_capital_(100000.0)
     , current_capital_(100000.0)
-    , current_position_(0.0)
+    , mark_to_market_(false)
+    , venue_statistics_{}
     , order_counter_(0)
-    , peak_capital_(100000.0)
+    , engine_id_(0)
+    , session_id_(static_cast<std::uint16_t>(TimeUtils::getCurrentTimestampUs() / 1000000))
+    , positions_(symbols_.capacity())
+    , trade_returns_(kReturnWindow)
+    , drawdown_(100000.0)
+    , order_assembler_([this](aeron::concurrent::AtomicBuffer& buffer,
+                              util::index_t offset,
+                              util::index_t length,
+                              aeron::Header& header) {
+          processOrder(buffer, offset, length);
+      })
 {
-    performance_metrics_ = {0.0, 0.0, 0, 0, 0, 0.0, 0.0, 0.0, 0, 0};
+    performance_metrics_ = {};
+    latency_breakdown_ = {};
+    // These and positions_ are indexed by symbol id and sized for every symbol the table can hold,
+    // so a new symbol's first fill or tick does not allocate
+    pending_marks_.reserve(symbols_.capacity());
+    marked_symbols_.reserve(symbols_.capacity());
 }
 
 ExecutionEngine::~ExecutionEngine() {
@@ -48,6 +63,43 @@ bool ExecutionEngine::initialize(std::shared_ptr<aeron::Aeron> aeron,
     }
 }
 
+bool ExecutionEngine::subscribeMarketData(const std::string& market_data_channel,
+                                         std::int32_t market_data_stream_id) {
+    try {
+        LOG_EXECUTION("Creating market data subscription for execution: {} stream {}", 
+                     market_data_channel, market_data_stream_id);
+        
+        market_data_subscription_ = aeron_->addSubscription(market_data_channel, market_data_stream_id);
+        
+        // Wait for subscription to connect
+        while (!market_data_subscription_->isConnected()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        
+        return true;
+        
+    } catch (const std::exception& e) {
+        LOG_ERROR_EXECUTION("Failed to subscribe to market data: {}", e.what());
+        return false;
+    }
+}
+
+bool ExecutionEngine::publishExecutionReports(const std::string& report_channel,
+                                             std::int32_t report_stream_id) {
+    try {
+        LOG_EXECUTION("Creating publication for execution reports: {} stream {}", 
+                     report_channel, report_stream_id);
+        
+        // Reports offered before the strategy subscribes are counted as dropped
+        report_publication_ = aeron_->addPublication(report_channel, report_stream_id);
+        return true;
+        
+    } catch (const std::exception& e) {
+        LOG_ERROR_EXECUTION("Failed to create execution report publication: {}", e.what());
+        return false;
+    }
+}
+
 void ExecutionEngine::start() {
     if (running_.load()) {
         LOG_EXECUTION("Execution engine is already running");
@@ -80,22 +132,87 @@ PerformanceMetrics ExecutionEngine::getPerformanceMetrics() const {
     return performance_metrics_;
 }
 
+ExchangeSimulator::Statistics ExecutionEngine::getVenueStatistics() const {
+    std::lock_guard<std::mutex> lock(performance_mutex_);
+    return venue_statistics_;
+}
+
+PortfolioSnapshot ExecutionEngine::getPortfolio() const {
+    std::lock_guard<std::mutex> lock(performance_mutex_);
+    return positions_.portfolio();
+}
+
+double ExecutionEngine::getPosition(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(performance_mutex_);
+    SymbolId symbol_id = symbols_.find(symbol.c_str());
+    return symbol_id == kInvalidSymbolId ? 0.0 : positions_.position(symbol_id);
+}
+
+LatencyBreakdown ExecutionEngine::getLatencyBreakdown() const {
+    std::lock_guard<std::mutex> lock(performance_mutex_);
+    return latency_breakdown_;
+}
+
 std::vector<TradeExecution> ExecutionEngine::getTradeHistory() const {
-    std::lock_guard<std::mutex> lock(trades_mutex_);
-    return trade_history_;
+    std::vector<TradeExecution> history;
+    
+    TradeJournalReader reader;
+    if (!trade_journal_.isOpen() || !reader.open(trade_journal_.basePath())) {
+        return history;
+    }
+    
+    while (reader.poll([&history](const TradeExecution& execution) {
+        history.push_back(execution);
+    }, 4096) > 0) {
+    }
+    return history;
+}
+
+bool ExecutionEngine::openTradeJournal(const std::string& base_path, std::uint64_t segment_capacity) {
+    if (!trade_journal_.open(base_path, segment_capacity)) {
+        LOG_ERROR_EXECUTION("Failed to open trade journal: {}", base_path);
+        return false;
+    }
+    
+    // Rebuild positions and PnL from the executions already journaled
+    TradeJournalReader reader;
+    std::uint64_t replayed = 0;
+    bool journaled_session = false;
+    std::uint16_t last_session = 0;
+    if (reader.open(base_path)) {
+        while (reader.poll([&](const TradeExecution& execution) {
+            updatePerformanceMetrics(execution);
+            if (orderIdEngine(execution.order_id) == engine_id_) {
+                journaled_session = true;
+                last_session = orderIdSession(execution.order_id);
+            }
+            replayed++;
+        }, 4096) > 0) {
+        }
+    }
+    
+    // Continue from the journal's last session: the startup-time default repeats every 65536 s
+    if (journaled_session) {
+        session_id_ = static_cast<std::uint16_t>(last_session + 1);
+        order_counter_ = 0;
+    }
+    
+    LOG_EXECUTION("Trade journal {} opened, {} executions replayed, order session {}",
+                 base_path, replayed, session_id_);
+    return true;
 }
 
 void ExecutionEngine::resetPerformanceTracking() {
-    std::lock_guard<std::mutex> lock1(performance_mutex_);
-    std::lock_guard<std::mutex> lock2(trades_mutex_);
+    // The journal is append-only and keeps the trade history
+    std::lock_guard<std::mutex> lock(performance_mutex_);
     
     current_capital_ = initial_capital_;
-    current_position_ = 0.0;
-    peak_capital_ = initial_capital_;
+    positions_.reset();
+    drawdown_.reset(initial_capital_);
     
-    performance_metrics_ = {0.0, 0.0, 0, 0, 0, 0.0, 0.0, 0.0, 0, 0};
-    trade_history_.clear();
-    daily_returns_.clear();
+    performance_metrics_ = {};
+    latency_breakdown_ = {};
+    trade_returns_.reset();
     
     LOG_EXECUTION("Performance tracking reset");
 }
@@ -106,16 +223,41 @@ void ExecutionEngine::processLoop() {
     aeron::concurrent::SleepingIdleStrategy idleStrategy(std::chrono::milliseconds(1));
     
     while (running_.load()) {
-        const int fragmentsRead = input_subscription_->poll(
-            [this](const aeron::concurrent::AtomicBuffer& buffer, 
-                   util::index_t offset, 
-                   util::index_t length, 
-                   const aeron::Header& header) {
-                processOrder(buffer, offset, length);
-            }, 
-            10);  // Poll up to 10 fragments at a time
+        int fragmentsRead = input_subscription_->poll(order_assembler_.handler(), poll_limit_.limit());
+        
+        poll_limit_.onPoll(fragmentsRead);
+        
+        // Requote the simulated books before matching anything that has come due;
+        // orders are always polled first so marking never delays them
+        if (market_data_subscription_) {
+            int market_data_read = market_data_subscription_->poll(
+                [this](const aeron::concurrent::AtomicBuffer& buffer, 
+                       util::index_t offset, 
+                       util::index_t length, 
+                       const aeron::Header& header) {
+                    processMarketData(buffer, offset, length);
+                }, 
+                market_data_poll_limit_.limit());
+            
+            market_data_poll_limit_.onPoll(market_data_read);
+            fragmentsRead += market_data_read;
+            applyMarks();
+        }
         
-        idleStrategy.idle(fragmentsRead);
+        // Deliver simulated fills that have come due
+        int fills = 0;
+        if (simulation_mode_) {
+            fills = pollSimulatedVenue(TimeUtils::getCurrentTimestampNs());
+            
+            if (fragmentsRead + fills > 0) {
+                std::lock_guard<std::mutex> lock(performance_mutex_);
+                venue_statistics_ = exchange_.getStatistics();
+            }
+        }
+        
+        // Keep spinning while fills are pending so they are delivered on time
+        const bool fills_pending = simulation_mode_ && exchange_.hasPendingFills();
+        idleStrategy.idle(fragmentsRead + fills + (fills_pending ? 1 : 0));
     }
     
     LOG_EXECUTION("Execution processing loop ended");
@@ -124,27 +266,98 @@ void ExecutionEngine::processLoop() {
 void ExecutionEngine::processOrder(const aeron::concurrent::AtomicBuffer& buffer,
                                   util::index_t offset,
                                   util::index_t length) {
-    if (length < sizeof(TradingOrder)) {
+    // A single order, or a netted batch from the strategy reassembled by order_assembler_
+    if (!decodeOrderMessage(buffer.buffer() + offset, static_cast<std::size_t>(length),
+                            [this](const TradingOrder& order) { handleOrder(order); })) {
         LOG_ERROR_EXECUTION("Invalid trading order message size: {}", length);
+    }
+}
+
+void ExecutionEngine::handleOrder(const TradingOrder& order) {
+    if (simulation_mode_) {
+        submitSimulatedOrder(order);
+    } else {
+        recordExecution(executeLiveOrder(order));
+    }
+}
+
+void ExecutionEngine::processMarketData(const aeron::concurrent::AtomicBuffer& buffer,
+                                       util::index_t offset,
+                                       util::index_t length) {
+    if (length < sizeof(MarketDataMessage)) {
+        LOG_ERROR_EXECUTION("Invalid market data message size: {}", length);
         return;
     }
     
-    // Extract trading order message
-    TradingOrder order;
-    std::memcpy(&order, buffer.buffer() + offset, sizeof(TradingOrder));
+    MarketDataMessage message;
+    std::memcpy(&message, buffer.buffer() + offset, sizeof(MarketDataMessage));
+    handleMarketData(message, TimeUtils::getCurrentTimestampNs());
+}
+
+void ExecutionEngine::handleMarketData(const MarketDataMessage& message, std::int64_t now_ns) {
+    exchange_.onMarketData(message, now_ns);
     
-    // Execute the order
-    TradeExecution execution = executeOrder(order);
+    if (mark_to_market_ && message.price > 0.0) {
+        stageMark(message);
+    }
+}
+
+int ExecutionEngine::pollSimulatedVenue(std::int64_t now_ns) {
+    return exchange_.poll(now_ns, [this](const SimulatedFill& fill) { onSimulatedFill(fill); });
+}
+
+void ExecutionEngine::stageMark(const MarketDataMessage& message) {
+    // Only this thread inserts symbols, so a lookup without the lock is safe
+    SymbolId symbol_id = symbols_.find(message.symbol);
+    if (symbol_id == kInvalidSymbolId) {
+        std::lock_guard<std::mutex> lock(performance_mutex_);
+        symbol_id = symbols_.findOrInsert(message.symbol);
+        if (symbol_id == kInvalidSymbolId) {
+            return;
+        }
+    }
+    
+    // Conflate: a burst of ticks for one symbol costs one mark per duty cycle
+    if (symbol_id >= pending_marks_.size()) {
+        pending_marks_.resize(symbol_id + 1, 0.0);
+    }
+    if (pending_marks_[symbol_id] == 0.0) {
+        marked_symbols_.push_back(symbol_id);
+    }
+    pending_marks_[symbol_id] = message.price;
+}
+
+void ExecutionEngine::applyMarks() {
+    if (marked_symbols_.empty()) {
+        return;
+    }
     
+    std::lock_guard<std::mutex> lock(performance_mutex_);
+    for (SymbolId symbol_id : marked_symbols_) {
+        positions_.onPrice(symbol_id, pending_marks_[symbol_id]);
+        pending_marks_[symbol_id] = 0.0;
+    }
+    marked_symbols_.clear();
+    updateEquity();
+}
+
+void ExecutionEngine::updateEquity() {
+    drawdown_.update(current_capital_ + positions_.portfolio().unrealized_pnl);
+    performance_metrics_.current_drawdown = drawdown_.current();
+    performance_metrics_.max_drawdown = drawdown_.max();
+}
+
+void ExecutionEngine::recordExecution(const TradeExecution& execution) {
     // Store execution record
-    {
-        std::lock_guard<std::mutex> lock(trades_mutex_);
-        trade_history_.push_back(execution);
+    if (trade_journal_.isOpen() && !trade_journal_.append(execution)) {
+        LOG_ERROR_EXECUTION("Failed to append execution to trade journal");
     }
     
     // Update performance metrics
     updatePerformanceMetrics(execution);
     
+    publishExecutionReport(execution);
+    
     LOG_DEBUG_EXECUTION("Order executed: signal={}, price={}, quantity={}, status={}", 
                        static_cast<int>(execution.signal),
                        execution.executed_price,
@@ -152,43 +365,83 @@ void ExecutionEngine::processOrder(const aeron::concurrent::AtomicBuffer& buffer
                        static_cast<int>(execution.status));
 }
 
-TradeExecution ExecutionEngine::executeOrder(const TradingOrder& order) {
-    if (simulation_mode_) {
-        return simulateExecution(order);
+void ExecutionEngine::publishExecutionReport(const TradeExecution& execution) {
+    if (!report_publication_) {
+        return;
+    }
+    
+    ExecutionReport report;
+    report.timestamp = execution.execution_timestamp;
+    report.order_id = execution.order_id;
+    report.price = execution.executed_price;
+    report.quantity = execution.executed_quantity;
+    std::memcpy(report.symbol, execution.symbol, sizeof(report.symbol));
+    report.signal = execution.signal;
+    report.reserved = 0;
+    report.strategy_id = execution.strategy_id;
+    report.status = execution.status;
+    
+    // Positions are only written by this thread, so reading them needs no lock
+    SymbolId symbol_id = symbols_.find(execution.symbol);
+    report.position = symbol_id == kInvalidSymbolId ? 0.0 : positions_.position(symbol_id);
+    
+    aeron::concurrent::AtomicBuffer buffer(reinterpret_cast<std::uint8_t*>(&report), sizeof(report));
+    std::int64_t result = report_publication_->offer(buffer, 0, sizeof(report));
+    
+    if (result < 0) {
+        LOG_DEBUG_EXECUTION("Execution report not published, result: {}", result);
+    }
+    
+    std::lock_guard<std::mutex> lock(performance_mutex_);
+    if (result > 0) {
+        performance_metrics_.reports_published++;
     } else {
-        return executeLiveOrder(order);
+        performance_metrics_.reports_dropped++;
     }
 }
 
-TradeExecution ExecutionEngine::simulateExecution(const TradingOrder& order) {
-    auto execution_start = TimeUtils::getCurrentTime();
+void ExecutionEngine::submitSimulatedOrder(const TradingOrder& order) {
+    const OrderId order_id = generateOrderId();
+    const std::int64_t now_ns = TimeUtils::getCurrentTimestampNs();
+    
+    if (exchange_.submitOrder(order, order_id, now_ns)) {
+        return;  // Fills arrive through onSimulatedFill
+    }
+    
+    LOG_ERROR_EXECUTION("Simulated venue full, rejecting order {}", orderIdSequence(order_id));
     
     TradeExecution execution;
-    execution.execution_timestamp = TimeUtils::getCurrentTimestampNs();
-    execution.order_id = generateOrderId();
+    execution.execution_timestamp = now_ns;
+    execution.order_id = order_id;
     execution.signal = order.signal;
-    execution.executed_price = order.price;
-    execution.executed_quantity = order.quantity;
-    execution.status = ExecutionStatus::FILLED;  // Assume all orders fill in simulation
+    execution.strategy_id = order.strategy_id;
+    execution.executed_price = 0.0;
+    execution.executed_quantity = 0.0;
+    execution.status = ExecutionStatus::REJECTED;
     std::strncpy(execution.symbol, order.symbol, sizeof(execution.symbol) - 1);
     execution.symbol[sizeof(execution.symbol) - 1] = '\0';
-    
-    // Add some realistic execution latency simulation (10-100 microseconds)
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> latency_dist(10000, 100000);  // 10-100 microseconds in nanoseconds
-    
-    auto simulated_latency = std::chrono::nanoseconds(latency_dist(gen));
-    std::this_thread::sleep_for(simulated_latency);
-    
-    execution.execution_latency_ns = TimeUtils::getDurationNs(execution_start, TimeUtils::getCurrentTime());
-    
-    // Add small price slippage simulation
-    std::uniform_real_distribution<> slippage_dist(-0.0001, 0.0001);  // ±0.01% slippage
-    double slippage = slippage_dist(gen);
-    execution.executed_price *= (1.0 + slippage);
-    
-    return execution;
+    execution.execution_latency_ns = 0;
+    execution.hops = order.hops;
+    recordExecution(execution);
+}
+
+void ExecutionEngine::onSimulatedFill(const SimulatedFill& fill) {
+    TradeExecution execution;
+    execution.execution_timestamp = TimeUtils::getCurrentTimestampNs();
+    execution.order_id = fill.order_id;
+    execution.signal = fill.signal;
+    execution.strategy_id = fill.strategy_id;
+    execution.executed_price = fill.price;
+    execution.executed_quantity = fill.quantity;
+    execution.status = fill.status;
+    std::memcpy(execution.symbol, fill.symbol, sizeof(execution.symbol));
+    
+    // Venue latency in simulated time, not the time this thread spent waiting
+    execution.execution_latency_ns = fill.fill_ns - fill.submit_ns;
+    execution.hops = fill.hops;
+    execution.hops.execution_ns = execution.execution_timestamp;
+    
+    recordExecution(execution);
 }
 
 TradeExecution ExecutionEngine::executeLiveOrder(const TradingOrder& order) {
@@ -199,12 +452,14 @@ TradeExecution ExecutionEngine::executeLiveOrder(const TradingOrder& order) {
     execution.execution_timestamp = TimeUtils::getCurrentTimestampNs();
     execution.order_id = generateOrderId();
     execution.signal = order.signal;
+    execution.strategy_id = order.strategy_id;
     execution.executed_price = order.price;
     execution.executed_quantity = order.quantity;
     execution.status = ExecutionStatus::PENDING;  // Would be updated by broker callback
     std::strncpy(execution.symbol, order.symbol, sizeof(execution.symbol) - 1);
     execution.symbol[sizeof(execution.symbol) - 1] = '\0';
     execution.execution_latency_ns = 0;  // Would be set when execution completes
+    execution.hops = order.hops;         // execution_ns set when the fill arrives
     
     LOG_EXECUTION("Live order execution not implemented - placeholder returned");
     
@@ -212,20 +467,21 @@ TradeExecution ExecutionEngine::executeLiveOrder(const TradingOrder& order) {
 }
 
 void ExecutionEngine::updatePerformanceMetrics(const TradeExecution& execution) {
-    if (execution.status != ExecutionStatus::FILLED) {
-        return;  // Only update metrics for filled orders
+    if (execution.status != ExecutionStatus::FILLED && 
+        execution.status != ExecutionStatus::PARTIALLY_FILLED) {
+        return;  // Only update metrics for executed quantity
     }
     
     std::lock_guard<std::mutex> lock(performance_mutex_);
     
-    // Calculate P&L for this trade
-    double trade_pnl = calculatePnL(execution);
-    
-    // Update position
-    if (execution.signal == SignalType::BUY) {
-        current_position_ += execution.executed_quantity;
-    } else if (execution.signal == SignalType::SELL) {
-        current_position_ -= execution.executed_quantity;
+    // Update the symbol's position; P&L is realized when a position is reduced
+    double trade_pnl = 0.0;
+    SymbolId symbol_id = symbols_.findOrInsert(execution.symbol);
+    if (symbol_id != kInvalidSymbolId &&
+        (execution.signal == SignalType::BUY || execution.signal == SignalType::SELL)) {
+        double signed_quantity = execution.signal == SignalType::BUY ? 
+            execution.executed_quantity : -execution.executed_quantity;
+        trade_pnl = positions_.onFill(symbol_id, signed_quantity, execution.executed_price);
     }
     
     // Update capital
@@ -252,7 +508,10 @@ void ExecutionEngine::updatePerformanceMetrics(const TradeExecution& execution)
         performance_metrics_.total_pnl / performance_metrics_.total_trades;
     
     // Update drawdown
-    updateDrawdown(current_capital_);
+    updateEquity();
+    
+    // Update tick-to-trade breakdown
+    latency_breakdown_.record(execution.hops);
     
     // Update execution latency stats
     if (execution.execution_latency_ns > 0) {
@@ -269,88 +528,14 @@ void ExecutionEngine::updatePerformanceMetrics(const TradeExecution& execution)
         }
     }
     
-    // Update Sharpe ratio (simplified calculation)
-    daily_returns_.push_back(trade_pnl / initial_capital_);
-    if (daily_returns_.size() > 252) {  // Keep one year of data
-        daily_returns_.erase(daily_returns_.begin());
-    }
-    performance_metrics_.sharpe_ratio = calculateSharpeRatio();
-}
-
-double ExecutionEngine::calculatePnL(const TradeExecution& execution) const {
-    // Simplified P&L calculation
-    // In a real system, this would consider position sizing, entry/exit prices, etc.
-    
-    static double last_price = execution.executed_price;
-    
-    double pnl = 0.0;
-    
-    if (execution.signal == SignalType::BUY) {
-        // For simplicity, assume we're buying at current price
-        // P&L would be realized when we sell
-        pnl = 0.0;  // Unrealized P&L
-    } else if (execution.signal == SignalType::SELL) {
-        // Assume we're selling position bought at last price
-        pnl = (execution.executed_price - last_price) * execution.executed_quantity;
-    }
-    
-    last_price = execution.executed_price;
-    return pnl;
-}
-
-void ExecutionEngine::updateDrawdown(double current_pnl) {
-    if (current_capital_ > peak_capital_) {
-        peak_capital_ = current_capital_;
-    }
-    
-    double current_drawdown = (peak_capital_ - current_capital_) / peak_capital_;
-    
-    if (current_drawdown > performance_metrics_.max_drawdown) {
-        performance_metrics_.max_drawdown = current_drawdown;
-    }
+    // Update rolling risk-adjusted returns
+    trade_returns_.add(trade_pnl / initial_capital_);
+    performance_metrics_.sharpe_ratio = trade_returns_.sharpeRatio();
+    performance_metrics_.sortino_ratio = trade_returns_.sortinoRatio();
 }
 
-double ExecutionEngine::calculateSharpeRatio() const {
-    if (daily_returns_.size() < 2) {
-        return 0.0;
-    }
-    
-    // Calculate mean return
-    double mean_return = 0.0;
-    for (double ret : daily_returns_) {
-        mean_return += ret;
-    }
-    mean_return /= daily_returns_.size();
-    
-    // Calculate standard deviation
-    double variance = 0.0;
-    for (double ret : daily_returns_) {
-        variance += (ret - mean_return) * (ret - mean_return);
-    }
-    variance /= (daily_returns_.size() - 1);
-    double std_dev = std::sqrt(variance);
-    
-    // Calculate Sharpe ratio (assuming risk-free rate = 0)
-    if (std_dev > 0.0) {
-        return (mean_return * std::sqrt(252)) / (std_dev * std::sqrt(252));  // Annualized
-    }
-    
-    return 0.0;
-}
-
-std::string ExecutionEngine::generateOrderId() {
-    return "ORDER_" + std::to_string(++order_counter_) + "_" + 
-           std::to_string(TimeUtils::getCurrentTimestampUs());
-}
-
-double ExecutionEngine::getMarketPrice(const std::string& symbol) const {
-    // Placeholder implementation for simulation
-    // In a real system, this would fetch current market price
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> price_dist(100.0, 200.0);
-    
-    return price_dist(gen);
+OrderId ExecutionEngine::generateOrderId() {
+    return makeOrderId(engine_id_, session_id_, ++order_counter_);
 }
 
 } // namespace trading
\ No newline at end of file
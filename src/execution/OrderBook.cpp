@@ -0,0 +1,225 @@
+#include "execution/OrderBook.h"
+#include <algorithm>
+
+namespace trading {
+
+OrderBook::OrderBook(std::size_t levels, std::size_t max_orders)
+    : window_low_(0)
+    , window_set_(false)
+    , free_head_(kInvalidOrder)
+    , order_count_(0)
+{
+    levels_ = 64;
+    while (levels_ < levels) {
+        levels_ <<= 1;
+    }
+    mask_ = levels_ - 1;
+
+    for (Ladder* book : {&bids_, &asks_}) {
+        book->levels.assign(levels_, Level{kInvalidOrder, kInvalidOrder, 0.0});
+        book->occupied.assign(levels_ / 64, 0);
+        book->best = kNoPrice;
+    }
+
+    pool_.resize(max_orders);
+    clear();
+}
+
+void OrderBook::clear() {
+    for (Ladder* book : {&bids_, &asks_}) {
+        std::fill(book->levels.begin(), book->levels.end(), Level{kInvalidOrder, kInvalidOrder, 0.0});
+        std::fill(book->occupied.begin(), book->occupied.end(), 0);
+        book->best = kNoPrice;
+    }
+
+    const std::size_t capacity = pool_.size();
+    for (std::size_t i = 0; i < capacity; ++i) {
+        pool_[i].active = false;
+        pool_[i].next = (i + 1 < capacity) ? static_cast<OrderHandle>(i + 1) : kInvalidOrder;
+    }
+    free_head_ = capacity > 0 ? 0 : kInvalidOrder;
+    order_count_ = 0;
+    window_set_ = false;
+}
+
+bool OrderBook::cancel(OrderHandle handle) {
+    if (handle >= pool_.size() || !pool_[handle].active) {
+        return false;
+    }
+
+    Order& order = pool_[handle];
+    Ladder& book = (order.side == Side::BUY) ? bids_ : asks_;
+    const std::int64_t price = order.price_ticks;
+    Level& level = book.levels[levelIndex(price)];
+
+    level.quantity -= order.quantity;
+    unlink(level, handle);
+    if (level.head == kInvalidOrder) {
+        clearLevel(book, price);
+    }
+    return true;
+}
+
+double OrderBook::remaining(OrderHandle handle) const {
+    if (handle >= pool_.size() || !pool_[handle].active) {
+        return 0.0;
+    }
+    return pool_[handle].quantity;
+}
+
+double OrderBook::depthAt(Side side, std::int64_t price_ticks) const {
+    if (!inWindow(price_ticks)) {
+        return 0.0;
+    }
+    const Ladder& book = (side == Side::BUY) ? bids_ : asks_;
+    const Level& level = book.levels[levelIndex(price_ticks)];
+    return level.head == kInvalidOrder ? 0.0 : level.quantity;
+}
+
+OrderBook::OrderHandle OrderBook::rest(Side side, std::int64_t price_ticks, double quantity, std::uint64_t owner) {
+    if (free_head_ == kInvalidOrder || !slideWindowTo(price_ticks)) {
+        return kInvalidOrder;
+    }
+
+    const OrderHandle handle = free_head_;
+    Order& order = pool_[handle];
+    free_head_ = order.next;
+
+    order.quantity = quantity;
+    order.owner = owner;
+    order.price_ticks = price_ticks;
+    order.side = side;
+    order.active = true;
+    order.next = kInvalidOrder;
+
+    Ladder& book = (side == Side::BUY) ? bids_ : asks_;
+    const std::size_t index = levelIndex(price_ticks);
+    Level& level = book.levels[index];
+
+    // Append to the level FIFO: time priority within the price
+    order.prev = level.tail;
+    if (level.tail == kInvalidOrder) {
+        level.head = handle;
+        level.quantity = 0.0;
+        book.occupied[index >> 6] |= (1ull << (index & 63));
+    } else {
+        pool_[level.tail].next = handle;
+    }
+    level.tail = handle;
+    level.quantity += quantity;
+    order_count_++;
+
+    if (book.best == kNoPrice ||
+        (side == Side::BUY ? price_ticks > book.best : price_ticks < book.best)) {
+        book.best = price_ticks;
+    }
+    return handle;
+}
+
+void OrderBook::unlink(Level& level, OrderHandle handle) {
+    Order& order = pool_[handle];
+
+    if (order.prev == kInvalidOrder) {
+        level.head = order.next;
+    } else {
+        pool_[order.prev].next = order.next;
+    }
+    if (order.next == kInvalidOrder) {
+        level.tail = order.prev;
+    } else {
+        pool_[order.next].prev = order.prev;
+    }
+
+    order.active = false;
+    order.next = free_head_;
+    free_head_ = handle;
+    order_count_--;
+}
+
+void OrderBook::clearLevel(Ladder& book, std::int64_t price_ticks) {
+    const std::size_t index = levelIndex(price_ticks);
+    book.levels[index].quantity = 0.0;
+    book.occupied[index >> 6] &= ~(1ull << (index & 63));
+
+    if (book.best != price_ticks) {
+        return;
+    }
+
+    // Next best is the nearest occupied level on the worse side of the window
+    const std::int64_t window_high = window_low_ + static_cast<std::int64_t>(levels_) - 1;
+    if (&book == &bids_) {
+        book.best = (price_ticks > window_low_) ? scanDown(book, price_ticks - 1, window_low_) : kNoPrice;
+    } else {
+        book.best = (price_ticks < window_high) ? scanUp(book, price_ticks + 1, window_high) : kNoPrice;
+    }
+}
+
+bool OrderBook::slideWindowTo(std::int64_t price_ticks) {
+    if (inWindow(price_ticks)) {
+        return true;
+    }
+
+    const std::int64_t span = static_cast<std::int64_t>(levels_);
+    const std::int64_t new_low = price_ticks - span / 2;
+
+    if (window_set_ && order_count_ > 0) {
+        // Levels that fall out of the window must be empty
+        const std::int64_t old_high = window_low_ + span - 1;
+        const std::int64_t new_high = new_low + span - 1;
+        std::int64_t leave_from = window_low_;
+        std::int64_t leave_to = old_high;
+        if (new_low > window_low_) {
+            leave_to = std::min(old_high, new_low - 1);
+        } else {
+            leave_from = std::max(window_low_, new_high + 1);
+        }
+        if (rangeOccupied(leave_from, leave_to)) {
+            return false;
+        }
+    }
+
+    window_low_ = new_low;
+    window_set_ = true;
+    return true;
+}
+
+bool OrderBook::rangeOccupied(std::int64_t from_ticks, std::int64_t to_ticks) const {
+    if (from_ticks > to_ticks) {
+        return false;
+    }
+    return scanUp(bids_, from_ticks, to_ticks) != kNoPrice ||
+           scanUp(asks_, from_ticks, to_ticks) != kNoPrice;
+}
+
+std::int64_t OrderBook::scanUp(const Ladder& book, std::int64_t from_ticks, std::int64_t to_ticks) const {
+    std::int64_t ticks = from_ticks;
+    while (ticks <= to_ticks) {
+        const std::size_t index = levelIndex(ticks);
+        const unsigned bit = static_cast<unsigned>(index & 63);
+        const std::uint64_t word = book.occupied[index >> 6] & (~0ull << bit);
+        if (word != 0) {
+            const std::int64_t found = ticks + (__builtin_ctzll(word) - static_cast<int>(bit));
+            return found <= to_ticks ? found : kNoPrice;
+        }
+        ticks += 64 - bit;
+    }
+    return kNoPrice;
+}
+
+std::int64_t OrderBook::scanDown(const Ladder& book, std::int64_t from_ticks, std::int64_t to_ticks) const {
+    std::int64_t ticks = from_ticks;
+    while (ticks >= to_ticks) {
+        const std::size_t index = levelIndex(ticks);
+        const unsigned bit = static_cast<unsigned>(index & 63);
+        // (2 << 63) wraps to 0, so bit 63 keeps the whole word
+        const std::uint64_t word = book.occupied[index >> 6] & ((2ull << bit) - 1);
+        if (word != 0) {
+            const std::int64_t found = ticks - (static_cast<int>(bit) - (63 - __builtin_clzll(word)));
+            return found >= to_ticks ? found : kNoPrice;
+        }
+        ticks -= static_cast<std::int64_t>(bit) + 1;
+    }
+    return kNoPrice;
+}
+
+} // namespace trading
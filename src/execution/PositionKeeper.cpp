@@ -0,0 +1,107 @@
+#include "execution/PositionKeeper.h"
+#include <algorithm>
+#include <cmath>
+
+namespace trading {
+
+namespace {
+constexpr double kFlatEpsilon = 1e-9;  // Positions below this are treated as flat
+}
+
+PositionKeeper::PositionKeeper(std::size_t expected_symbols)
+    : size_(0)
+{
+    for (std::vector<double>* column : {&position_, &average_cost_, &last_price_, &realized_, &unrealized_}) {
+        column->reserve(expected_symbols);
+    }
+    portfolio_ = {};
+}
+
+void PositionKeeper::reset() {
+    size_ = 0;
+    for (std::vector<double>* column : {&position_, &average_cost_, &last_price_, &realized_, &unrealized_}) {
+        column->clear();
+    }
+    portfolio_ = {};
+}
+
+double PositionKeeper::onFill(SymbolId id, double quantity, double price) {
+    ensure(id);
+    removeFromTotals(id);
+
+    double& position = position_[id];
+    double& cost = average_cost_[id];
+    double realized = 0.0;
+
+    if (std::fabs(position) < kFlatEpsilon || (position > 0.0) == (quantity > 0.0)) {
+        // Opening or adding: blend the average cost
+        const double total = std::fabs(position) + std::fabs(quantity);
+        cost = total > 0.0 ? (std::fabs(position) * cost + std::fabs(quantity) * price) / total : 0.0;
+        position += quantity;
+    } else {
+        // Reducing: realize the closed quantity against the average cost
+        const double closed = std::min(std::fabs(quantity), std::fabs(position));
+        realized = closed * (price - cost) * (position > 0.0 ? 1.0 : -1.0);
+        position += quantity;
+
+        if (std::fabs(position) < kFlatEpsilon) {
+            position = 0.0;
+            cost = 0.0;
+        } else if ((position > 0.0) == (quantity > 0.0)) {
+            cost = price;  // Flipped through flat: the remainder opened at this price
+        }
+    }
+
+    realized_[id] += realized;
+    last_price_[id] = price;
+    unrealized_[id] = position * (price - cost);
+
+    portfolio_.realized_pnl += realized;
+    addToTotals(id);
+    return realized;
+}
+
+void PositionKeeper::onPrice(SymbolId id, double price) {
+    ensure(id);
+    if (position_[id] == 0.0) {
+        last_price_[id] = price;  // Nothing to mark; just remember the price
+        return;
+    }
+
+    removeFromTotals(id);
+    last_price_[id] = price;
+    unrealized_[id] = position_[id] * (price - average_cost_[id]);
+    addToTotals(id);
+}
+
+void PositionKeeper::ensure(SymbolId id) {
+    if (id < size_) {
+        return;
+    }
+    size_ = static_cast<std::size_t>(id) + 1;
+    for (std::vector<double>* column : {&position_, &average_cost_, &last_price_, &realized_, &unrealized_}) {
+        column->resize(size_, 0.0);
+    }
+}
+
+void PositionKeeper::removeFromTotals(SymbolId id) {
+    const double position = position_[id];
+    portfolio_.unrealized_pnl -= unrealized_[id];
+    portfolio_.gross_exposure -= std::fabs(position) * last_price_[id];
+    portfolio_.net_exposure -= position * last_price_[id];
+    if (position != 0.0) {
+        portfolio_.open_positions--;
+    }
+}
+
+void PositionKeeper::addToTotals(SymbolId id) {
+    const double position = position_[id];
+    portfolio_.unrealized_pnl += unrealized_[id];
+    portfolio_.gross_exposure += std::fabs(position) * last_price_[id];
+    portfolio_.net_exposure += position * last_price_[id];
+    if (position != 0.0) {
+        portfolio_.open_positions++;
+    }
+}
+
+} // namespace trading
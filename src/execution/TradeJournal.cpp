@@ -0,0 +1,176 @@
+#include "execution/TradeJournal.h"
+#include <cstdio>
+
+namespace trading {
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "journal header counters are shared between processes");
+
+std::string TradeJournalSegment::path(const std::string& base_path, std::uint64_t segment_index) {
+    char suffix[24];
+    std::snprintf(suffix, sizeof(suffix), ".%06llu", static_cast<unsigned long long>(segment_index));
+    return base_path + suffix;
+}
+
+namespace {
+
+bool validSegment(const MappedFile& file, std::uint64_t segment_index) {
+    if (file.size() < TradeJournalSegment::recordsOffset()) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const TradeJournalSegment::Header*>(file.data());
+    return header->magic == TradeJournalSegment::kMagic &&
+           header->record_size == sizeof(TradeExecution) &&
+           header->segment_index == segment_index &&
+           file.size() >= TradeJournalSegment::fileSize(header->capacity);
+}
+
+} // namespace
+
+bool TradeJournal::open(const std::string& base_path, std::uint64_t segment_capacity) {
+    close();
+    base_path_ = base_path;
+    segment_capacity_ = segment_capacity > 0 ? segment_capacity : kDefaultSegmentCapacity;
+
+    // Resume at the last existing segment, or start a new journal
+    std::uint64_t last = 0;
+    if (!MappedFile::exists(TradeJournalSegment::path(base_path_, 0))) {
+        return createSegment(0, 0);
+    }
+    while (MappedFile::exists(TradeJournalSegment::path(base_path_, last + 1))) {
+        last++;
+    }
+    return mapSegment(last);
+}
+
+bool TradeJournal::append(const TradeExecution& execution) {
+    if (header_ == nullptr) {
+        return false;
+    }
+
+    std::uint64_t count = header_->count.load(std::memory_order_relaxed);
+    if (count >= header_->capacity) {
+        const std::uint64_t next_index = header_->segment_index + 1;
+        const std::uint64_t next_first = header_->first_record + count;
+        file_.sync(0, file_.size());
+        if (!createSegment(next_index, next_first)) {
+            return false;
+        }
+        count = 0;
+    }
+
+    std::memcpy(&records_[count], &execution, sizeof(TradeExecution));
+    header_->count.store(count + 1, std::memory_order_release);
+
+    // Keep the resident set bounded: drop whole pages the tail has moved past
+    const std::size_t written = TradeJournalSegment::recordsOffset() + (count + 1) * sizeof(TradeExecution);
+    if (written - released_bytes_ >= 2 * kReleaseChunk) {
+        const std::size_t upto = written - kReleaseChunk;
+        file_.release(released_bytes_, upto - released_bytes_);
+        released_bytes_ = upto;
+    }
+    return true;
+}
+
+void TradeJournal::close() {
+    if (file_.isOpen()) {
+        file_.sync(0, file_.size());
+    }
+    file_.close();
+    header_ = nullptr;
+    records_ = nullptr;
+    released_bytes_ = 0;
+}
+
+std::uint64_t TradeJournal::size() const {
+    if (header_ == nullptr) {
+        return 0;
+    }
+    return header_->first_record + header_->count.load(std::memory_order_relaxed);
+}
+
+bool TradeJournal::createSegment(std::uint64_t segment_index, std::uint64_t first_record) {
+    const std::string path = TradeJournalSegment::path(base_path_, segment_index);
+    const std::string temp_path = path + ".tmp";
+
+    MappedFile file;
+    if (!file.create(temp_path, TradeJournalSegment::fileSize(segment_capacity_))) {
+        return false;
+    }
+
+    auto* header = reinterpret_cast<TradeJournalSegment::Header*>(file.data());
+    header->magic = TradeJournalSegment::kMagic;
+    header->record_size = sizeof(TradeExecution);
+    header->reserved = 0;
+    header->capacity = segment_capacity_;
+    header->segment_index = segment_index;
+    header->first_record = first_record;
+    header->count.store(0, std::memory_order_release);
+
+    // Readers only ever see a segment with a complete header
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        file.close();
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    file_ = std::move(file);
+    header_ = header;
+    records_ = reinterpret_cast<TradeExecution*>(file_.data() + TradeJournalSegment::recordsOffset());
+    released_bytes_ = 0;
+    return true;
+}
+
+bool TradeJournal::mapSegment(std::uint64_t segment_index) {
+    MappedFile file;
+    if (!file.open(TradeJournalSegment::path(base_path_, segment_index), true) ||
+        !validSegment(file, segment_index)) {
+        return false;
+    }
+
+    file_ = std::move(file);
+    header_ = reinterpret_cast<TradeJournalSegment::Header*>(file_.data());
+    records_ = reinterpret_cast<TradeExecution*>(file_.data() + TradeJournalSegment::recordsOffset());
+    released_bytes_ = 0;
+    return true;
+}
+
+bool TradeJournalReader::open(const std::string& base_path) {
+    base_path_ = base_path;
+    return mapSegment(0);
+}
+
+bool TradeJournalReader::mapSegment(std::uint64_t segment_index) {
+    const std::string path = TradeJournalSegment::path(base_path_, segment_index);
+    if (!MappedFile::exists(path)) {
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(path, false) || !validSegment(file, segment_index)) {
+        return false;
+    }
+
+    file_ = std::move(file);
+    segment_index_ = segment_index;
+    header_ = reinterpret_cast<const TradeJournalSegment::Header*>(file_.data());
+    records_ = reinterpret_cast<const TradeExecution*>(file_.data() + TradeJournalSegment::recordsOffset());
+    offset_ = 0;
+    released_bytes_ = 0;
+    return true;
+}
+
+bool TradeJournalReader::nextSegment() {
+    return mapSegment(segment_index_ + 1);
+}
+
+void TradeJournalReader::releaseRead() {
+    const std::size_t read = TradeJournalSegment::recordsOffset() + offset_ * sizeof(TradeExecution);
+    if (read - released_bytes_ >= 2 * kReleaseChunk) {
+        const std::size_t upto = read - kReleaseChunk;
+        file_.release(released_bytes_, upto - released_bytes_);
+        released_bytes_ = upto;
+    }
+}
+
+} // namespace trading
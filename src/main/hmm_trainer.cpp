@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Config.h"
+#include "common/DCIndicator.h"
+#include "common/SymbolParameters.h"
+#include "market_data/MarketDataRecording.h"
+#include "strategy/RegimeModel.h"
+#include "strategy/RegimeTrainer.h"
+
+namespace {
+
+/**
+ * @brief Replay a market data recording into per-symbol DC feature sequences
+ *
+ * Each symbol runs at its own theta, the one its live ladder rung 0 uses
+ * to feed the regime filter.
+ */
+std::size_t collectSequences(const trading::MarketDataRecording& recording,
+                             const trading::SymbolParameterTable& parameters, trading::RegimeTrainer& trainer) {
+    std::unordered_map<std::string, std::size_t> symbol_index;
+    std::vector<std::string> symbols;
+    std::vector<trading::DCIndicator> indicators;
+    std::vector<std::vector<trading::RegimeObservation>> sequences;
+
+    trading::MarketDataMessage message;
+    const std::uint64_t last = recording.lastSequence();
+    for (std::uint64_t sequence = 1; sequence <= last; ++sequence) {
+        if (!recording.read(sequence, message)) {
+            continue;
+        }
+
+        message.symbol[sizeof(message.symbol) - 1] = '\0';
+        auto inserted = symbol_index.emplace(message.symbol, indicators.size());
+        if (inserted.second) {
+            symbols.emplace_back(message.symbol);
+            indicators.emplace_back(parameters.lookup(message.symbol).theta);
+            sequences.emplace_back();
+        }
+        const std::size_t index = inserted.first->second;
+
+        trading::DCEvent event = indicators[index].processDataPoint(
+            trading::MarketDataPoint(message.timestamp, message.price, message.volume));
+        if (event.type != trading::DCEventType::NONE) {
+            sequences[index].push_back(trading::regimeFeatures(event.tmv_ext, event.duration));
+        }
+    }
+
+    std::size_t events = 0;
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        events += sequences[i].size();
+        trainer.addSequence(symbols[i], std::move(sequences[i]));
+    }
+    return events;
+}
+
+} // namespace
+
+/**
+ * @brief Offline Baum-Welch training of the strategy's regime HMMs
+ *
+ * Replays a market data recording through a DC indicator per symbol, at
+ * the symbol's theta from the symbols table, and fits a Gaussian HMM with
+ * hmm_states states to each symbol's DC events, plus a default model over
+ * all symbols, in parallel across symbols and EM restarts. Writes the
+ * models the strategy engine loads from hmm_model_file.
+ *
+ * Usage: hmm_trainer [config_file] [recording_file] [output_file]
+ */
+int main(int argc, char* argv[]) {
+    auto& config = trading::Config::getInstance();
+    std::string config_file = (argc > 1) ? argv[1] : "config/system_config.json";
+    if (!config.loadConfig(config_file)) {
+        std::cerr << "Failed to load configuration from: " << config_file << std::endl;
+        return 1;
+    }
+
+    const auto& settings = config.getStrategySettings();
+    std::string recording_file = (argc > 2) ? argv[2] : config.getRecoveryConfig().recording_file;
+    std::string output_file = (argc > 3) ? argv[3] : settings.hmm_model_file;
+
+    trading::MarketDataRecording recording;
+    if (!recording.open(recording_file)) {
+        std::cerr << "Failed to open market data recording: " << recording_file << std::endl;
+        return 1;
+    }
+
+    trading::SymbolParameterTable parameters(trading::SymbolParameters{config.getDCConfig().theta, 1.0});
+    std::string symbol_error;
+    if (!parameters.load(config.getSymbolParameters(), symbol_error)) {
+        std::cerr << "Invalid symbol parameters: " << symbol_error << std::endl;
+        return 1;
+    }
+
+    trading::RegimeTrainer trainer;
+    const std::size_t events = collectSequences(recording, parameters, trainer);
+    std::cout << "Collected " << events << " DC events from " << recording_file << std::endl;
+
+    if (settings.hmm_states < static_cast<int>(trading::kMinRegimeStates) ||
+        settings.hmm_states > static_cast<int>(trading::kMaxRegimeStates)) {
+        std::cerr << "hmm_states must be between " << trading::kMinRegimeStates << " and "
+                  << trading::kMaxRegimeStates << std::endl;
+        return 1;
+    }
+    if (settings.hmm_max_iterations <= 0) {
+        std::cerr << "hmm_max_iterations must be positive" << std::endl;
+        return 1;
+    }
+
+    trading::RegimeTrainingOptions options;
+    options.states = static_cast<std::size_t>(settings.hmm_states);
+    options.max_iterations = settings.hmm_max_iterations;
+    options.tolerance = 1e-6;
+    options.restarts = std::max(settings.hmm_restarts, 1);
+    options.min_events = static_cast<std::size_t>(std::max(settings.hmm_min_symbol_events, 0));
+    options.threads = static_cast<std::size_t>(std::max(settings.hmm_trainer_threads, 0));
+    options.seed = 42;
+
+    trading::RegimeModelSet models;
+    trading::RegimeTrainingReport report;
+    auto start = std::chrono::steady_clock::now();
+    if (!trainer.train(options, models, report)) {
+        std::cerr << "Not enough DC events to train a " << settings.hmm_states << "-state model" << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Trained " << report.jobs << " EM runs (" << report.converged_jobs << " converged, "
+              << report.iterations << " iterations, " << report.stolen_jobs << " stolen) in "
+              << std::fixed << std::setprecision(2) << seconds << " s" << std::endl;
+    std::cout << report.symbol_models << " of " << report.symbols
+              << " symbols have their own model; default log-likelihood "
+              << std::setprecision(3) << report.default_log_likelihood << std::endl;
+
+    if (!models.save(output_file)) {
+        std::cerr << "Failed to write " << output_file << std::endl;
+        return 1;
+    }
+    std::cout << "Regime models written to " << output_file << std::endl;
+    return 0;
+}
@@ -13,6 +13,7 @@
 #include "common/Logger.h"
 #include "common/TimeUtils.h"
 #include "market_data/MarketDataProcessor.h"
+#include "market_data/MarketDataRecording.h"
 
 namespace {
     volatile bool running = true;
@@ -33,6 +34,8 @@ public:
         , trend_(0.0)
         , volatility_(0.02)
         , message_count_(0)
+        , sequence_number_(0)
+        , unrecorded_count_(0)
     {
         // Initialize random generators
         std::random_device rd;
@@ -63,6 +66,19 @@ public:
         }
     }
     
+    /**
+     * @brief Record every message so consumers can replay sequence gaps
+     */
+    bool enableRecording(const std::string& path, std::uint64_t capacity) {
+        if (!recording_.create(path, capacity)) {
+            std::cerr << "Failed to create market data recording: " << path << std::endl;
+            return false;
+        }
+        std::cout << "Recording market data to " << path 
+                 << " (capacity " << capacity << " messages)" << std::endl;
+        return true;
+    }
+    
     void start(int messages_per_second = 1000) {
         std::cout << "Starting market data simulation at " << messages_per_second 
                  << " messages/second" << std::endl;
@@ -76,12 +92,20 @@ public:
             
             // Create market data message
             trading::MarketDataMessage market_data;
+            market_data.sequence_number = ++sequence_number_;
             market_data.timestamp = trading::TimeUtils::getCurrentTimestampNs();
             market_data.price = price_;
             market_data.volume = generateVolume();
             std::strncpy(market_data.symbol, "EURUSD", sizeof(market_data.symbol) - 1);
             market_data.symbol[sizeof(market_data.symbol) - 1] = '\0';
             
+            // Record before publishing: a message lost in transport is still replayable
+            if (recording_.isOpen() && !recording_.append(market_data) && unrecorded_count_++ == 0) {
+                // The recording never wraps: from here on gaps cannot be replayed
+                std::cerr << "Market data recording full, message " << market_data.sequence_number
+                         << " and later are not recorded" << std::endl;
+            }
+            
             // Publish the message
             publishMarketData(market_data);
             
@@ -99,6 +123,9 @@ public:
         }
         
         std::cout << "Market data simulation stopped. Total messages: " << message_count_ << std::endl;
+        if (unrecorded_count_ > 0) {
+            std::cout << unrecorded_count_ << " messages were not recorded" << std::endl;
+        }
     }
 
 private:
@@ -155,6 +182,9 @@ private:
     double trend_;
     double volatility_;
     std::uint64_t message_count_;
+    std::uint64_t sequence_number_;
+    trading::MarketDataRecording recording_;
+    std::uint64_t unrecorded_count_;  // Appends refused by a full recording
     
     // Random generators
     std::mt19937 gen_;
@@ -202,6 +232,12 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        if (config.getRecoveryConfig().enable_gap_recovery) {
+            simulator.enableRecording(
+                config.getRecoveryConfig().recording_file,
+                config.getRecoveryConfig().recording_capacity);
+        }
+        
         // Start simulation
         int messages_per_second = (argc > 2) ? std::atoi(argv[2]) : 1000;
         simulator.start(messages_per_second);
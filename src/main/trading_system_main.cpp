@@ -1,14 +1,19 @@
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <signal.h>
+#include <string>
 #include <thread>
 #include <chrono>
+#include <vector>
 
 #include <aeron/Aeron.h>
 #include <aeron/Context.h>
 
 #include "common/Config.h"
+#include "common/ConfigWatcher.h"
 #include "common/Logger.h"
+#include "common/SymbolParameters.h"
 #include "market_data/MarketDataProcessor.h"
 #include "strategy/StrategyEngine.h"
 #include "execution/ExecutionEngine.h"
@@ -20,6 +25,87 @@ namespace {
         std::cout << "Received signal " << signal << ", shutting down..." << std::endl;
         running = false;
     }
+    
+    // Configured strategies, with rule strategies' rules compiled; empty
+    // instances run the top-level strategy alone
+    bool buildStrategies(const trading::Config::StrategyConfig& strategy_settings,
+                         std::vector<trading::StrategyInstanceSettings>& strategies, std::string& error) {
+        auto instances = strategy_settings.instances;
+        if (instances.empty()) {
+            instances.push_back({strategy_settings.name, strategy_settings.leverage_factor,
+                                 strategy_settings.enable_hmm, {}, strategy_settings.trade_synthetics,
+                                 strategy_settings.rules});
+        }
+        strategies.clear();
+        for (const auto& instance : instances) {
+            std::shared_ptr<trading::RuleTable> rules;
+            if (instance.name == trading::DCRuleStrategy::kName) {
+                rules = std::make_shared<trading::RuleTable>();
+                if (!rules->compile(instance.rules, error)) {
+                    error = "Invalid trading rules for " + instance.name + ": " + error;
+                    return false;
+                }
+            }
+            strategies.push_back(trading::StrategyInstanceSettings{
+                instance.name, instance.leverage_factor, instance.enable_hmm, instance.thetas, rules,
+                instance.trade_synthetics});
+        }
+        return true;
+    }
+    
+    // Per-symbol thresholds and leverage over the global theta
+    std::unique_ptr<trading::SymbolParameterTable> buildSymbolParameters(const trading::Config& config,
+                                                                        std::string& error) {
+        auto parameters = std::make_unique<trading::SymbolParameterTable>(
+            trading::SymbolParameters{config.getDCConfig().theta, 1.0});
+        if (!parameters->load(config.getSymbolParameters(), error)) {
+            error = "Invalid symbol parameters: " + error;
+            return nullptr;
+        }
+        return parameters;
+    }
+    
+    std::unique_ptr<trading::RiskLimitTable> buildRiskLimits(const trading::Config::RiskConfig& risk) {
+        auto risk_limits = std::make_unique<trading::RiskLimitTable>(trading::RiskLimits{
+            risk.max_position, risk.max_notional, risk.max_orders_per_second, risk.price_band_bps});
+        for (const auto& symbol : risk.symbols) {
+            risk_limits->set(symbol.symbol.c_str(), trading::RiskLimits{
+                symbol.max_position, symbol.max_notional, symbol.max_orders_per_second, symbol.price_band_bps});
+        }
+        return risk_limits;
+    }
+    
+    // Applies the parameters that can change while running: the DC thresholds,
+    // per-symbol leverage, each strategy's leverage, regime use, thetas and
+    // rules, and the risk limits. Everything else, including which strategies
+    // run, needs a restart.
+    void applyReloadedConfig(const trading::Config& config, trading::MarketDataProcessor& market_data_processor,
+                             trading::StrategyEngine& strategy_engine) {
+        std::vector<trading::StrategyInstanceSettings> strategies;
+        std::string error;
+        auto dc_parameters = buildSymbolParameters(config, error);
+        auto strategy_parameters = buildSymbolParameters(config, error);
+        if (!dc_parameters || !strategy_parameters ||
+            !buildStrategies(config.getStrategySettings(), strategies, error)) {
+            std::cerr << error << "; keeping the current parameters" << std::endl;
+            return;
+        }
+        if (strategies.size() != strategy_engine.strategyCount()) {
+            std::cerr << "Strategies added or removed; restart to apply" << std::endl;
+            return;
+        }
+        
+        market_data_processor.setSymbolParameters(std::move(dc_parameters));
+        strategy_engine.setSymbolParameters(std::move(strategy_parameters));
+        for (std::size_t id = 0; id < strategies.size(); ++id) {
+            if (!strategy_engine.updateStrategy(id, strategies[id])) {
+                std::cerr << "Strategy " << id << " is " << strategy_engine.strategyName(id)
+                          << ", not " << strategies[id].name << "; restart to change it" << std::endl;
+            }
+        }
+        strategy_engine.setRiskLimits(buildRiskLimits(config.getRiskConfig()));
+        std::cout << "Reloaded parameters" << std::endl;
+    }
 }
 
 int main(int argc, char* argv[]) {
@@ -74,7 +160,36 @@ int main(int argc, char* argv[]) {
             std::cerr << "Failed to initialize market data processor" << std::endl;
             return 1;
         }
-        market_data_processor.setDCThreshold(config.getDCConfig().theta);
+        // Each component flattens its own copy into arrays indexed by its symbol ids
+        std::string symbol_error;
+        auto dc_parameters = buildSymbolParameters(config, symbol_error);
+        auto strategy_parameters = buildSymbolParameters(config, symbol_error);
+        if (!dc_parameters || !strategy_parameters) {
+            std::cerr << symbol_error << std::endl;
+            return 1;
+        }
+        market_data_processor.setSymbolParameters(std::move(dc_parameters));
+        const auto& adaptive_theta = config.getDCConfig().adaptive_theta;
+        market_data_processor.setAdaptiveTheta(trading::AdaptiveThetaSettings{
+            adaptive_theta.enabled, adaptive_theta.event_interval_s,
+            static_cast<std::uint32_t>(std::max(adaptive_theta.half_life_ticks, 1)),
+            adaptive_theta.min_scale, adaptive_theta.max_scale});
+        const auto& theta_scales = config.getDCConfig().theta_scales;
+        if (!market_data_processor.setThetaLadder(theta_scales)) {
+            std::cerr << "Invalid theta_scales: 1 to " << trading::MarketDataProcessor::kMaxThetaLadder
+                      << " positive multiples required" << std::endl;
+            return 1;
+        }
+        std::string synthetic_error;
+        if (!market_data_processor.setSyntheticInstruments(config.getSyntheticConfig(), synthetic_error)) {
+            std::cerr << "Invalid synthetics: " << synthetic_error << std::endl;
+            return 1;
+        }
+        if (config.getRecoveryConfig().enable_gap_recovery) {
+            market_data_processor.enableGapRecovery(
+                config.getRecoveryConfig().recording_file,
+                config.getRecoveryConfig().max_replay_per_cycle);
+        }
         
         // Configure strategy engine
         if (!strategy_engine.initialize(
@@ -86,8 +201,74 @@ int main(int argc, char* argv[]) {
             std::cerr << "Failed to initialize strategy engine" << std::endl;
             return 1;
         }
-        strategy_engine.enableHMM(config.getStrategySettings().enable_hmm);
-        strategy_engine.setLeverageFactor(config.getStrategySettings().leverage_factor);
+        // Every configured strategy runs over the one DC signal stream
+        const auto& strategy_settings = config.getStrategySettings();
+        std::vector<trading::StrategyInstanceSettings> strategies;
+        std::string strategy_error;
+        if (!buildStrategies(strategy_settings, strategies, strategy_error)) {
+            std::cerr << strategy_error << std::endl;
+            return 1;
+        }
+        bool use_regimes = false;
+        for (const auto& strategy : strategies) {
+            if (strategy.rules) {
+                std::cout << "Compiled " << strategy.rules->rules() << " trading rules into "
+                          << strategy.rules->cells() << " table cells" << std::endl;
+            }
+            if (!strategy_engine.addStrategy(strategy)) {
+                std::cerr << "Cannot add strategy " << strategy.name << " (available:";
+                for (const char* name : trading::strategyNames()) {
+                    std::cerr << " " << name;
+                }
+                std::cerr << "; at most " << trading::StrategyEngine::kMaxStrategies << ")" << std::endl;
+                return 1;
+            }
+            use_regimes = use_regimes || strategy.enable_hmm;
+        }
+        strategy_engine.setSymbolParameters(std::move(strategy_parameters));
+        
+        // Trade the consensus of the theta ladder rather than every rung's signals
+        const auto& ensemble = strategy_settings.theta_ensemble;
+        if (ensemble.enabled) {
+            std::vector<std::uint32_t> weights = ensemble.weights;
+            if (weights.empty()) {
+                weights.assign(theta_scales.size(), 1);
+            }
+            if (!strategy_engine.setThetaEnsemble(weights, ensemble.quorum)) {
+                std::cerr << "Invalid theta_ensemble weights or quorum" << std::endl;
+                return 1;
+            }
+        }
+        
+        // Lead-lag statistics between configured pairs, offered to the strategies as features
+        const auto& lead_lag = config.getLeadLagConfig();
+        if (lead_lag.enabled && !strategy_engine.setLeadLagPairs(lead_lag.pairs, trading::LeadLagSettings{
+                lead_lag.max_lag_ns, static_cast<std::uint32_t>(std::max(lead_lag.half_life_events, 1)),
+                static_cast<std::uint32_t>(std::max(lead_lag.min_samples, 1))})) {
+            std::cerr << "Invalid lead_lag pairs or settings" << std::endl;
+            return 1;
+        }
+        strategy_engine.setWorkerThreads(static_cast<std::size_t>(std::max(strategy_settings.worker_threads, 0)));
+        if (use_regimes) {
+            // The regime model comes from hmm_trainer; trade without regimes if it is missing
+            if (strategy_engine.loadRegimeModel(strategy_settings.hmm_model_file)) {
+                strategy_engine.enableHMM(true);
+            } else {
+                std::cerr << "No usable regime model at " << strategy_settings.hmm_model_file
+                          << ", HMM regime detection disabled" << std::endl;
+            }
+        }
+        
+        // Pre-trade limits; a new table can be swapped in while running
+        strategy_engine.setRiskLimits(buildRiskLimits(config.getRiskConfig()));
+        strategy_engine.enableRiskChecks(config.getRiskConfig().enabled);
+        
+        const auto& throttle = config.getThrottleConfig();
+        strategy_engine.setOrderThrottle(
+            trading::TokenBucketLimit{throttle.symbol_orders_per_second, throttle.symbol_burst},
+            trading::TokenBucketLimit{throttle.global_orders_per_second, throttle.global_burst});
+        strategy_engine.enableOrderBatching(config.getOrderBatchingConfig().enabled,
+                                            config.getOrderBatchingConfig().window_ns);
         
         // Configure execution engine
         if (!execution_engine.initialize(
@@ -97,9 +278,70 @@ int main(int argc, char* argv[]) {
             std::cerr << "Failed to initialize execution engine" << std::endl;
             return 1;
         }
+        
+        // Fills, rejects and positions flow back to the strategy
+        if (!execution_engine.publishExecutionReports(
+                config.getExecutionReportConfig().channel,
+                config.getExecutionReportConfig().stream_id) ||
+            !strategy_engine.subscribeExecutionReports(
+                config.getExecutionReportConfig().channel,
+                config.getExecutionReportConfig().stream_id)) {
+            std::cerr << "Failed to set up the execution report stream" << std::endl;
+            return 1;
+        }
+        
         execution_engine.setSimulationMode(true);  // Default to simulation mode
         execution_engine.setInitialCapital(100000.0);
         
+        // Journal executions; a restart replays the journal to rebuild PnL
+        const auto& journal = config.getTradeJournalConfig();
+        if (journal.enabled && !execution_engine.openTradeJournal(journal.path, journal.segment_capacity)) {
+            std::cerr << "Failed to open trade journal " << journal.path << std::endl;
+            return 1;
+        }
+        
+        // Configure the simulated venue
+        const auto& venue = config.getSimulatedVenueConfig();
+        trading::ExchangeSimulator::Settings venue_settings;
+        venue_settings.seed = venue.seed;
+        venue_settings.base_latency_ns = venue.base_latency_ns;
+        venue_settings.latency_jitter_ns = venue.latency_jitter_ns;
+        venue_settings.slippage_bps = venue.slippage_bps;
+        venue_settings.impact_bps_per_unit = venue.impact_bps_per_unit;
+        venue_settings.slippage_noise_bps = venue.slippage_noise_bps;
+        venue_settings.partial_fill_probability = venue.partial_fill_probability;
+        venue_settings.max_partial_fills = venue.max_partial_fills;
+        venue_settings.partial_fill_interval_ns = venue.partial_fill_interval_ns;
+        venue_settings.max_pending_fills = venue.max_pending_fills;
+        venue_settings.match_against_book = venue.match_against_book;
+        venue_settings.tick_size = venue.tick_size;
+        venue_settings.quote_half_spread_bps = venue.quote_half_spread_bps;
+        venue_settings.quote_levels = venue.quote_levels;
+        venue_settings.limit_slippage_bps = venue.limit_slippage_bps;
+        venue_settings.resting_timeout_ns = venue.resting_timeout_ns;
+        venue_settings.book_levels = venue.book_levels;
+        venue_settings.max_working_orders = venue.max_working_orders;
+        execution_engine.configureSimulatedVenue(venue_settings);
+        
+        // The order book model matches against the live market data stream, and
+        // mark-to-market values open positions at its prices
+        const bool mark_to_market = config.getMarkToMarketConfig().enabled;
+        execution_engine.setMarkToMarket(mark_to_market);
+        if ((venue.match_against_book || mark_to_market) &&
+            !execution_engine.subscribeMarketData(config.getMarketDataConfig().channel,
+                                                  config.getMarketDataConfig().stream_id)) {
+            std::cerr << "Failed to subscribe execution engine to market data" << std::endl;
+            return 1;
+        }
+        
+        // Configure poll batch sizing
+        const auto& polling = config.getPollingConfig();
+        const int min_fragments = polling.adaptive_fragment_limit ? polling.min_fragment_limit : polling.fragment_limit;
+        const int max_fragments = polling.adaptive_fragment_limit ? polling.max_fragment_limit : polling.fragment_limit;
+        market_data_processor.setPollLimits(min_fragments, max_fragments);
+        strategy_engine.setPollLimits(min_fragments, max_fragments);
+        execution_engine.setPollLimits(min_fragments, max_fragments);
+        
         std::cout << "All components initialized successfully" << std::endl;
         
         // Start all components
@@ -110,6 +352,12 @@ int main(int argc, char* argv[]) {
         std::cout << "All components started successfully" << std::endl;
         std::cout << "Trading system is running... Press Ctrl+C to stop" << std::endl;
         
+        // Parameter changes saved to the config file are applied without a restart
+        trading::ConfigWatcher config_watcher;
+        if (config.getHotReloadConfig().enabled && !config_watcher.watch(config_file)) {
+            std::cerr << "Cannot watch " << config_file << ", hot reload disabled" << std::endl;
+        }
+        
         // Main loop - monitor system and print statistics
         auto last_stats_time = std::chrono::steady_clock::now();
         const auto stats_interval = std::chrono::seconds(10);
@@ -117,6 +365,15 @@ int main(int argc, char* argv[]) {
         while (running) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
             
+            // Reloaded on this thread, the only one that reads the configuration
+            if (config_watcher.changed()) {
+                if (config.reloadConfig(config_file)) {
+                    applyReloadedConfig(config, market_data_processor, strategy_engine);
+                } else {
+                    std::cerr << "Failed to reload " << config_file << "; keeping the current parameters" << std::endl;
+                }
+            }
+            
             auto now = std::chrono::steady_clock::now();
             if (now - last_stats_time >= stats_interval) {
                 // Print system statistics
@@ -128,15 +385,85 @@ int main(int argc, char* argv[]) {
                 std::cout << "Market Data: " << md_stats.messages_processed 
                          << " messages, " << md_stats.dc_events_detected 
                          << " DC events, Avg latency: " << md_stats.avg_processing_latency_ns << " ns" << std::endl;
+                if (md_stats.synthetic_ticks + md_stats.synthetic_ticks_skipped > 0) {
+                    std::cout << "Synthetics: " << md_stats.synthetic_ticks << " ticks, "
+                             << md_stats.synthetic_ticks_skipped << " skipped at or below zero" << std::endl;
+                }
+                if (md_stats.sequence_gaps > 0) {
+                    std::cout << "Market Data gaps: " << md_stats.sequence_gaps 
+                             << " gaps, " << md_stats.messages_lost << " lost, " 
+                             << md_stats.messages_recovered << " recovered, " 
+                             << md_stats.unrecoverable_messages << " unrecoverable" << std::endl;
+                }
+                if (md_stats.sequence_resets > 0) {
+                    std::cout << "Market Data sequence resets: " << md_stats.sequence_resets << std::endl;
+                }
                 
                 std::cout << "Strategy: " << strategy_stats.signals_processed 
-                         << " signals, " << strategy_stats.orders_generated 
-                         << " orders, Avg latency: " << strategy_stats.avg_strategy_latency_ns << " ns" << std::endl;
+                         << " signals (" << strategy_stats.signals_outvoted << " outvoted), "
+                         << strategy_stats.orders_generated 
+                         << " orders (" << strategy_stats.orders_suppressed << " suppressed, "
+                         << strategy_stats.orders_throttled << " throttled, "
+                         << strategy_stats.orders_netted << " netted in "
+                         << strategy_stats.order_batches << " batches, "
+                         << strategy_stats.orders_risk_rejected << " risk rejected, "
+                         << strategy_stats.execution_reports << " reports), Avg latency: " << strategy_stats.avg_strategy_latency_ns << " ns" << std::endl;
+                if (strategy_engine.strategyCount() > 1) {
+                    for (std::size_t id = 0; id < strategy_engine.strategyCount(); ++id) {
+                        auto stats = strategy_engine.getStrategyStatistics(id);
+                        std::cout << "  [" << id << "] " << strategy_engine.strategyName(id) << ": "
+                                 << stats.signals_processed << " signals, "
+                                 << stats.orders_generated << " orders ("
+                                 << stats.buy_signals << " buy, " << stats.sell_signals << " sell, "
+                                 << stats.orders_risk_rejected << " risk rejected), "
+                                 << stats.execution_reports << " reports, Avg latency: "
+                                 << stats.avg_strategy_latency_ns << " ns" << std::endl;
+                    }
+                }
                 
                 std::cout << "Execution: " << execution_stats.total_trades 
                          << " trades, PnL: $" << execution_stats.total_pnl 
                          << ", Win rate: " << (execution_stats.win_rate * 100) << "%" << std::endl;
                 
+                auto portfolio = execution_engine.getPortfolio();
+                std::cout << "Portfolio: realized $" << portfolio.realized_pnl
+                         << ", unrealized $" << portfolio.unrealized_pnl
+                         << ", gross exposure $" << portfolio.gross_exposure
+                         << ", " << portfolio.open_positions << " open positions" << std::endl;
+                
+                auto latency = execution_engine.getLatencyBreakdown();
+                if (latency.samples > 0) {
+                    std::cout << "Tick-to-trade: avg " << latency.tick_to_trade.avg_ns 
+                             << " ns, max " << latency.tick_to_trade.max_ns << " ns (feed->dc "
+                             << latency.feed_to_dc.avg_ns << ", dc->signal "
+                             << latency.dc_to_signal.avg_ns << ", signal->order "
+                             << latency.signal_to_order.avg_ns << ", order->exec "
+                             << latency.order_to_execution.avg_ns << ")" << std::endl;
+                }
+                
+                auto venue_stats = execution_engine.getVenueStatistics();
+                std::cout << "Venue: " << venue_stats.orders_submitted << " orders, "
+                         << venue_stats.fills_generated << " fills ("
+                         << venue_stats.partial_fills << " partial), "
+                         << venue_stats.pending_fills << " pending, "
+                         << venue_stats.orders_rejected << " rejected, "
+                         << venue_stats.working_orders << " working, "
+                         << venue_stats.book_events << " book events" << std::endl;
+                
+                auto printPollStats = [](const char* name, const trading::AdaptivePollLimit::Statistics& poll_stats) {
+                    double avg_fragments = poll_stats.polls > 0 ?
+                        static_cast<double>(poll_stats.fragments) / poll_stats.polls : 0.0;
+                    std::cout << "Poll [" << name << "]: limit " << poll_stats.current_limit
+                             << " (max used " << poll_stats.max_limit_used << "), "
+                             << avg_fragments << " fragments/poll, "
+                             << poll_stats.saturated_polls << " saturated polls" << std::endl;
+                };
+                printPollStats("market data", market_data_processor.getPollStatistics());
+                printPollStats("strategy", strategy_engine.getPollStatistics());
+                printPollStats("strategy reports", strategy_engine.getReportPollStatistics());
+                printPollStats("execution", execution_engine.getPollStatistics());
+                printPollStats("execution market data", execution_engine.getMarketDataPollStatistics());
+                
                 last_stats_time = now;
             }
         }
@@ -157,9 +484,14 @@ int main(int argc, char* argv[]) {
         std::cout << "Total PnL: $" << final_stats.total_pnl << std::endl;
         std::cout << "Win Rate: " << (final_stats.win_rate * 100) << "%" << std::endl;
         std::cout << "Sharpe Ratio: " << final_stats.sharpe_ratio << std::endl;
+        std::cout << "Sortino Ratio: " << final_stats.sortino_ratio << std::endl;
         std::cout << "Max Drawdown: " << (final_stats.max_drawdown * 100) << "%" << std::endl;
         std::cout << "Average Execution Latency: " << final_stats.avg_execution_latency_ns << " ns" << std::endl;
         
+        auto final_latency = execution_engine.getLatencyBreakdown();
+        std::cout << "Average Tick-to-Trade Latency: " << final_latency.tick_to_trade.avg_ns << " ns" << std::endl;
+        std::cout << "Max Tick-to-Trade Latency: " << final_latency.tick_to_trade.max_ns << " ns" << std::endl;
+        
     }
     catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
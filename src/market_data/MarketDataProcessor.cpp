@@ -1,14 +1,30 @@
 #include "market_data/MarketDataProcessor.h"
 #include <iostream>
 #include <cstring>
+#include <algorithm>
+#include <cmath>
 
 namespace trading {
 
 MarketDataProcessor::MarketDataProcessor() 
-    : running_(false)
-    , statistics_{0, 0, 0, 0}
+    : theta_scales_{1.0}
+    , rcu_(1)
+    , rcu_reader_(rcu_.registerReader())
+    , parameters_(rcu_, std::make_unique<SymbolParameterTable>(SymbolParameters{0.004, 1.0}))  // Default 0.4% threshold
+    , parameters_version_(0)
+    , applied_version_(0)
+    , adaptive_theta_{false, 60.0, 500, 0.25, 4.0}
+    , expected_sequence_(0)
+    , gap_head_(0)
+    , gap_count_(0)
+    , gap_recovery_enabled_(false)
+    , max_replay_per_cycle_(64)
+    , running_(false)
+    , statistics_{}
 {
-    dc_indicator_ = std::make_unique<DCIndicator>(0.004); // Default 0.4% threshold
+    // Reserve per-symbol state up front so new symbols never reallocate on the hot path
+    dc_indicators_.reserve(symbols_.capacity());
+    last_sequence_.reserve(symbols_.capacity());
 }
 
 MarketDataProcessor::~MarketDataProcessor() {
@@ -81,10 +97,70 @@ void MarketDataProcessor::stop() {
 }
 
 void MarketDataProcessor::setDCThreshold(double theta) {
-    if (dc_indicator_) {
-        dc_indicator_->setTheta(theta);
-        LOG_MARKET_DATA("DC threshold set to {}", theta);
+    setSymbolParameters(std::make_unique<SymbolParameterTable>(SymbolParameters{theta, 1.0}));
+}
+
+void MarketDataProcessor::setSymbolParameters(std::unique_ptr<SymbolParameterTable> parameters) {
+    const double theta = parameters->defaults().theta;
+    const std::size_t overrides = parameters->size();
+    parameters_.update(std::move(parameters));
+    
+    // Bumped after the swap: the processing thread re-applies thetas between ticks once it sees it
+    parameters_version_.fetch_add(1, std::memory_order_release);
+    LOG_MARKET_DATA("DC threshold set to {}, {} symbols with their own", theta, overrides);
+}
+
+bool MarketDataProcessor::setThetaLadder(const std::vector<double>& scales) {
+    if (running_.load() || scales.empty() || scales.size() > kMaxThetaLadder) {
+        return false;
+    }
+    for (double scale : scales) {
+        if (!(scale > 0.0) || !std::isfinite(scale)) {
+            return false;
+        }
     }
+    
+    theta_scales_ = scales;
+    dc_indicators_.clear();
+    last_sequence_.clear();
+    dc_indicators_.reserve(symbols_.capacity() * theta_scales_.size());
+    LOG_MARKET_DATA("DC events detected at {} thresholds per symbol", theta_scales_.size());
+    return true;
+}
+
+bool MarketDataProcessor::setSyntheticInstruments(const std::vector<Config::SyntheticConfig>& synthetics,
+                                                  std::string& error) {
+    if (running_.load()) {
+        error = "synthetic instruments must be set before start";
+        return false;
+    }
+    if (!synthetics_.configure(synthetics, symbols_, error)) {
+        return false;
+    }
+    LOG_MARKET_DATA("{} synthetic instruments priced from their legs", synthetics_.size());
+    return true;
+}
+
+void MarketDataProcessor::applyParameters(const SymbolParameterTable& parameters) {
+    // Open trends are judged against the new thresholds from the next tick
+    const std::size_t rungs = theta_scales_.size();
+    for (SymbolId id = 0; id < last_sequence_.size(); ++id) {
+        const double theta = parameters.lookup(symbols_.name(id).c_str()).theta;
+        for (std::size_t rung = 0; rung < rungs; ++rung) {
+            dc_indicators_[id * rungs + rung].setTheta(theta * theta_scales_[rung]);
+        }
+    }
+    LOG_MARKET_DATA("DC thresholds applied to {} symbols", last_sequence_.size());
+}
+
+void MarketDataProcessor::enableGapRecovery(const std::string& recording_file, int max_replay_per_cycle) {
+    gap_recovery_enabled_ = !recording_file.empty();
+    recording_file_ = recording_file;
+    max_replay_per_cycle_ = std::max(1, max_replay_per_cycle);
+    
+    LOG_MARKET_DATA("Gap recovery {} (recording: {}, {} messages per cycle)", 
+                   gap_recovery_enabled_ ? "enabled" : "disabled", 
+                   recording_file_, max_replay_per_cycle_);
 }
 
 MarketDataProcessor::Statistics MarketDataProcessor::getStatistics() const {
@@ -96,8 +172,17 @@ void MarketDataProcessor::processLoop() {
     LOG_MARKET_DATA("Market data processing loop started");
     
     aeron::concurrent::SleepingIdleStrategy idleStrategy(std::chrono::milliseconds(1));
+    rcu_.online(rcu_reader_);
     
     while (running_.load()) {
+        // Pick up new parameters between ticks, never in the middle of one
+        rcu_.quiescent(rcu_reader_);
+        const std::uint64_t version = parameters_version_.load(std::memory_order_acquire);
+        if (version != applied_version_) {
+            applyParameters(*parameters_.read());
+            applied_version_ = version;
+        }
+        
         const int fragmentsRead = input_subscription_->poll(
             [this](const aeron::concurrent::AtomicBuffer& buffer, 
                    util::index_t offset, 
@@ -105,18 +190,24 @@ void MarketDataProcessor::processLoop() {
                    const aeron::Header& header) {
                 processMarketData(buffer, offset, length);
             }, 
-            10);  // Poll up to 10 fragments at a time
+            poll_limit_.limit());
         
-        idleStrategy.idle(fragmentsRead);
+        poll_limit_.onPoll(fragmentsRead);
+        
+        // Replay a bounded slice of any pending gap after the live fragments
+        const int replayed = (gap_count_ > 0) ? replayGaps() : 0;
+        
+        idleStrategy.idle(fragmentsRead + replayed);
     }
     
+    rcu_.offline(rcu_reader_);
     LOG_MARKET_DATA("Market data processing loop ended");
 }
 
 void MarketDataProcessor::processMarketData(const aeron::concurrent::AtomicBuffer& buffer, 
                                           util::index_t offset, 
                                           util::index_t length) {
-    auto start_time = TimeUtils::getCurrentTime();
+    const std::int64_t feed_receive_ns = TimeUtils::getCurrentTimestampNs();
     
     if (length < sizeof(MarketDataMessage)) {
         LOG_ERROR_MARKET_DATA("Invalid market data message size: {}", length);
@@ -127,11 +218,34 @@ void MarketDataProcessor::processMarketData(const aeron::concurrent::AtomicBuffe
     MarketDataMessage market_data;
     std::memcpy(&market_data, buffer.buffer() + offset, sizeof(MarketDataMessage));
     
+    if (!checkSequence(market_data.sequence_number)) {
+        return;  // Duplicate or already replayed
+    }
+    
+    processTick(market_data, feed_receive_ns);
+}
+
+void MarketDataProcessor::processTick(const MarketDataMessage& market_data, std::int64_t feed_receive_ns) {
+    auto start_time = TimeUtils::getCurrentTime();
+    
+    SymbolId symbol_id = symbolIdFor(market_data.symbol);
+    if (symbol_id == kInvalidSymbolId || synthetics_.isSynthetic(symbol_id)) {
+        LOG_ERROR_MARKET_DATA("{}, dropping tick for {}",
+                             symbol_id == kInvalidSymbolId ? "Symbol table full" : "Symbol is a synthetic",
+                             std::string(market_data.symbol, strnlen(market_data.symbol, sizeof(market_data.symbol))));
+        return;
+    }
+    last_sequence_[symbol_id] = market_data.sequence_number;
+    
     // Create market data point for DC processing
     MarketDataPoint data_point(market_data.timestamp, market_data.price, market_data.volume);
+    const std::uint64_t detected = detectDCEvents(symbol_id, data_point);
     
-    // Process through DC indicator
-    DCEvent dc_event = dc_indicator_->processDataPoint(data_point);
+    HopTimestamps hops{};
+    if (detected != 0) {
+        hops.feed_receive_ns = feed_receive_ns;
+        hops.dc_detected_ns = TimeUtils::getCurrentTimestampNs();
+    }
     
     // Update statistics
     {
@@ -142,36 +256,282 @@ void MarketDataProcessor::processMarketData(const aeron::concurrent::AtomicBuffe
         updateLatencyStats(latency_ns);
     }
     
-    // If DC event detected, publish signal
-    if (dc_event.type != DCEventType::NONE) {
-        {
+    // If DC events were detected, publish a signal for each
+    if (detected != 0) {
+        publishDCEvents(symbol_id, detected, hops);
+    }
+    
+    // Reprice only the synthetics this symbol is a leg of
+    synthetics_.onTick(symbol_id, market_data.price, [&](SymbolId synthetic_id, double value) {
+        processSyntheticTick(synthetic_id, MarketDataPoint(market_data.timestamp, value), feed_receive_ns);
+    });
+}
+
+void MarketDataProcessor::processSyntheticTick(SymbolId symbol_id, const MarketDataPoint& data_point,
+                                               std::int64_t feed_receive_ns) {
+    if (!(data_point.price > 0.0)) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics_.synthetic_ticks_skipped++;
+        return;
+    }
+    while (symbol_id >= last_sequence_.size()) {
+        addSymbolState();
+    }
+    
+    const std::uint64_t detected = detectDCEvents(symbol_id, data_point);
+    
+    HopTimestamps hops{};
+    if (detected != 0) {
+        hops.feed_receive_ns = feed_receive_ns;
+        hops.dc_detected_ns = TimeUtils::getCurrentTimestampNs();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics_.synthetic_ticks++;
+    }
+    
+    if (detected != 0) {
+        publishDCEvents(symbol_id, detected, hops);
+    }
+}
+
+std::uint64_t MarketDataProcessor::detectDCEvents(SymbolId symbol_id, const MarketDataPoint& data_point) {
+    // Process through the symbol's DC indicators, one per rung of the theta ladder
+    const std::size_t rungs = theta_scales_.size();
+    DCIndicator* indicators = &dc_indicators_[symbol_id * rungs];
+    std::uint64_t detected = 0;  // Bit per rung; the event is then the rung's last one
+    for (std::size_t rung = 0; rung < rungs; ++rung) {
+        const bool event = indicators[rung].processDataPoint(data_point).type != DCEventType::NONE;
+        detected |= static_cast<std::uint64_t>(event) << rung;
+    }
+    return detected;
+}
+
+void MarketDataProcessor::publishDCEvents(SymbolId symbol_id, std::uint64_t detected, const HopTimestamps& hops) {
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics_.dc_events_detected += static_cast<std::uint64_t>(__builtin_popcountll(detected));
+    }
+    
+    const std::size_t rungs = theta_scales_.size();
+    const DCIndicator* indicators = &dc_indicators_[symbol_id * rungs];
+    const std::string symbol = symbols_.name(symbol_id);
+    const bool synthetic = synthetics_.isSynthetic(symbol_id);
+    for (; detected != 0; detected &= detected - 1) {
+        const std::size_t rung = static_cast<std::size_t>(__builtin_ctzll(detected));
+        const DCEvent& dc_event = indicators[rung].getLastDCEvent();
+        publishDCSignal(dc_event, symbol, indicators[rung].getBaseTheta(), static_cast<std::uint8_t>(rung),
+                        synthetic, hops);
+        
+        LOG_DEBUG_MARKET_DATA("DC event detected: symbol={}, type={}, price={}, tmv={}, theta={}", 
+                             symbol,
+                             static_cast<int>(dc_event.type), 
+                             dc_event.price, 
+                             dc_event.tmv_ext,
+                             indicators[rung].getBaseTheta());
+    }
+}
+
+SymbolId MarketDataProcessor::symbolIdFor(const char* symbol) {
+    SymbolId symbol_id = symbols_.findOrInsert(symbol);
+    // Ids handed out ahead of the first tick, such as synthetic legs, get their state here too
+    while (symbol_id != kInvalidSymbolId && symbol_id >= last_sequence_.size()) {
+        addSymbolState();
+    }
+    return symbol_id;
+}
+
+void MarketDataProcessor::addSymbolState() {
+    // Resolved once; ticks read the theta held by the indicators. Each
+    // rung targets scale^2 times the event interval, so adaptive rungs
+    // keep their spacing instead of converging on one threshold.
+    const SymbolId symbol_id = static_cast<SymbolId>(last_sequence_.size());
+    const double theta = parameters_.read()->lookup(symbols_.name(symbol_id).c_str()).theta;
+    for (double scale : theta_scales_) {
+        AdaptiveThetaSettings adaptive = adaptive_theta_;
+        adaptive.event_interval_s *= scale * scale;
+        dc_indicators_.emplace_back(theta * scale);
+        dc_indicators_.back().setAdaptiveTheta(adaptive);
+    }
+    last_sequence_.push_back(0);
+}
+
+bool MarketDataProcessor::checkSequence(std::uint64_t sequence_number) {
+    if (expected_sequence_ == 0 || sequence_number == expected_sequence_) {
+        // First message after start-up, or in order
+        expected_sequence_ = sequence_number + 1;
+        return true;
+    }
+    
+    if (sequence_number > expected_sequence_) {
+        recordGap(expected_sequence_, sequence_number - 1);
+        expected_sequence_ = sequence_number + 1;
+        return true;
+    }
+    
+    if (expected_sequence_ - sequence_number > kMaxDuplicateDistance) {
+        // Too far back to be a duplicate; dropping it would drop the whole restarted stream
+        resetSequence(sequence_number);
+        return true;
+    }
+    
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    statistics_.duplicate_messages++;
+    return false;
+}
+
+void MarketDataProcessor::resetSequence(std::uint64_t sequence_number) {
+    LOG_ERROR_MARKET_DATA("Sequence jumped back from {} to {}, resynchronizing",
+                         expected_sequence_ - 1, sequence_number);
+    expected_sequence_ = sequence_number + 1;
+    
+    // Pending gaps and per-symbol sequences belong to the old numbering
+    std::uint64_t unrecoverable = 0;
+    for (; gap_count_ > 0; gap_count_--, gap_head_ = (gap_head_ + 1) % kMaxPendingGaps) {
+        const GapRange& gap = pending_gaps_[gap_head_];
+        unrecoverable += gap.last_sequence - gap.next_sequence + 1;
+    }
+    std::fill(last_sequence_.begin(), last_sequence_.end(), 0);
+    
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    statistics_.sequence_resets++;
+    statistics_.unrecoverable_messages += unrecoverable;
+}
+
+void MarketDataProcessor::recordGap(std::uint64_t first_missing, std::uint64_t last_missing) {
+    std::uint64_t missing = last_missing - first_missing + 1;
+    
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics_.sequence_gaps++;
+        statistics_.messages_lost += missing;
+        if (!gap_recovery_enabled_) {
+            statistics_.unrecoverable_messages += missing;
+        }
+    }
+    
+    LOG_MARKET_DATA("Sequence gap detected: missing {} message(s) [{}, {}]", 
+                   missing, first_missing, last_missing);
+    
+    if (!gap_recovery_enabled_) {
+        return;
+    }
+    
+    if (gap_count_ == kMaxPendingGaps) {
+        // Queue full: widen the newest range rather than dropping the gap. Live
+        // ticks inside the widened range were already applied, so replaying
+        // them only re-checks extremes.
+        GapRange& newest = pending_gaps_[(gap_head_ + gap_count_ - 1) % kMaxPendingGaps];
+        newest.last_sequence = last_missing;
+        return;
+    }
+    
+    pending_gaps_[(gap_head_ + gap_count_) % kMaxPendingGaps] = 
+        GapRange{first_missing, last_missing, TimeUtils::getCurrentTimestampNs()};
+    gap_count_++;
+}
+
+int MarketDataProcessor::replayGaps() {
+    if (!recording_.isOpen() && !recording_.open(recording_file_)) {
+        // The recorder may not have created the file yet; give up after the timeout
+        const GapRange& oldest = pending_gaps_[gap_head_];
+        if (TimeUtils::getCurrentTimestampNs() - oldest.detected_ns > kRecoveryTimeoutNs) {
+            LOG_ERROR_MARKET_DATA("Market data recording {} unavailable, dropping gap recovery", 
+                                 recording_file_);
+            std::uint64_t unrecoverable = 0;
+            for (; gap_count_ > 0; gap_count_--, gap_head_ = (gap_head_ + 1) % kMaxPendingGaps) {
+                const GapRange& gap = pending_gaps_[gap_head_];
+                unrecoverable += gap.last_sequence - gap.next_sequence + 1;
+            }
             std::lock_guard<std::mutex> lock(stats_mutex_);
-            statistics_.dc_events_detected++;
+            statistics_.unrecoverable_messages += unrecoverable;
         }
+        return 0;
+    }
+    
+    int replayed = 0;
+    while (gap_count_ > 0 && replayed < max_replay_per_cycle_) {
+        GapRange& gap = pending_gaps_[gap_head_];
         
-        std::string symbol(market_data.symbol);
-        publishDCSignal(dc_event, symbol);
+        MarketDataMessage market_data;
+        if (!recording_.read(gap.next_sequence, market_data)) {
+            bool never_available = recording_.lastSequence() >= gap.next_sequence;
+            bool timed_out = TimeUtils::getCurrentTimestampNs() - gap.detected_ns > kRecoveryTimeoutNs;
+            if (!never_available && !timed_out) {
+                break;  // Recorder still catching up; retry next duty cycle
+            }
+            
+            std::uint64_t unrecoverable = gap.last_sequence - gap.next_sequence + 1;
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                statistics_.unrecoverable_messages += unrecoverable;
+            }
+            LOG_ERROR_MARKET_DATA("Cannot recover {} message(s) from sequence {}", 
+                                 unrecoverable, gap.next_sequence);
+            gap_head_ = (gap_head_ + 1) % kMaxPendingGaps;
+            gap_count_--;
+            continue;
+        }
         
-        LOG_DEBUG_MARKET_DATA("DC event detected: type={}, price={}, tmv={}", 
-                             static_cast<int>(dc_event.type), 
-                             dc_event.price, 
-                             dc_event.tmv_ext);
+        applyRecoveredTick(market_data);
+        replayed++;
+        
+        if (gap.next_sequence++ == gap.last_sequence) {
+            gap_head_ = (gap_head_ + 1) % kMaxPendingGaps;
+            gap_count_--;
+        }
+    }
+    
+    return replayed;
+}
+
+void MarketDataProcessor::applyRecoveredTick(const MarketDataMessage& market_data) {
+    SymbolId symbol_id = symbolIdFor(market_data.symbol);
+    if (symbol_id == kInvalidSymbolId || synthetics_.isSynthetic(symbol_id)) {
+        return;
+    }
+    
+    bool late_extreme = false;
+    if (market_data.sequence_number > last_sequence_[symbol_id]) {
+        // Nothing newer has been applied for this symbol: process in order
+        processTick(market_data, TimeUtils::getCurrentTimestampNs());
+    } else {
+        // The symbol has moved on; only a missed extreme still matters
+        MarketDataPoint data_point(market_data.timestamp, market_data.price, market_data.volume);
+        const std::size_t rungs = theta_scales_.size();
+        for (std::size_t rung = 0; rung < rungs; ++rung) {
+            late_extreme = dc_indicators_[symbol_id * rungs + rung].processLateDataPoint(data_point) || late_extreme;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    statistics_.messages_recovered++;
+    if (late_extreme) {
+        statistics_.late_extremes_applied++;
     }
 }
 
-bool MarketDataProcessor::publishDCSignal(const DCEvent& dc_event, const std::string& symbol) {
-    DCSignalMessage signal_msg;
+bool MarketDataProcessor::publishDCSignal(const DCEvent& dc_event, const std::string& symbol, double theta,
+                                          std::uint8_t theta_index, bool synthetic, HopTimestamps hops) {
+    DCSignalMessage signal_msg{};
     signal_msg.timestamp = dc_event.timestamp;
     signal_msg.event_type = dc_event.type;
+    signal_msg.theta_index = theta_index;
+    signal_msg.synthetic = synthetic ? 1 : 0;
     signal_msg.price = dc_event.price;
     signal_msg.tmv_ext = dc_event.tmv_ext;
     signal_msg.duration = dc_event.duration;
     signal_msg.time_adjusted_return = dc_event.time_adjusted_return;
+    signal_msg.theta = theta;
     
     // Copy symbol (ensure null termination)
     std::strncpy(signal_msg.symbol, symbol.c_str(), sizeof(signal_msg.symbol) - 1);
     signal_msg.symbol[sizeof(signal_msg.symbol) - 1] = '\0';
     
+    hops.signal_published_ns = TimeUtils::getCurrentTimestampNs();
+    signal_msg.hops = hops;
+    
     // Publish the signal
     aeron::concurrent::AtomicBuffer buffer(reinterpret_cast<std::uint8_t*>(&signal_msg), 
                                           sizeof(signal_msg));
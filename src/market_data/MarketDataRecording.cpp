@@ -0,0 +1,93 @@
+#include "market_data/MarketDataRecording.h"
+#include <cstring>
+
+namespace trading {
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "recording header counters are shared between processes");
+
+bool MarketDataRecording::create(const std::string& path, std::uint64_t capacity) {
+    std::size_t size = recordsOffset() + capacity * sizeof(MarketDataMessage);
+    if (!file_.create(path, size)) {
+        return false;
+    }
+
+    header_ = reinterpret_cast<Header*>(file_.data());
+    header_->magic = kMagic;
+    header_->record_size = sizeof(MarketDataMessage);
+    header_->capacity = capacity;
+    header_->first_sequence.store(0, std::memory_order_relaxed);
+    header_->count.store(0, std::memory_order_release);
+    records_ = reinterpret_cast<MarketDataMessage*>(file_.data() + recordsOffset());
+    return true;
+}
+
+bool MarketDataRecording::open(const std::string& path) {
+    if (!file_.open(path, false) || file_.size() < recordsOffset()) {
+        file_.close();
+        return false;
+    }
+
+    Header* header = reinterpret_cast<Header*>(file_.data());
+    if (header->magic != kMagic || header->record_size != sizeof(MarketDataMessage) ||
+        file_.size() < recordsOffset() + header->capacity * sizeof(MarketDataMessage)) {
+        file_.close();
+        return false;
+    }
+
+    header_ = header;
+    records_ = reinterpret_cast<MarketDataMessage*>(file_.data() + recordsOffset());
+    return true;
+}
+
+bool MarketDataRecording::append(const MarketDataMessage& message) {
+    if (!header_) {
+        return false;
+    }
+
+    std::uint64_t count = header_->count.load(std::memory_order_relaxed);
+    if (count >= header_->capacity) {
+        return false;
+    }
+
+    if (count == 0) {
+        header_->first_sequence.store(message.sequence_number, std::memory_order_relaxed);
+    } else if (message.sequence_number !=
+               header_->first_sequence.load(std::memory_order_relaxed) + count) {
+        return false;
+    }
+
+    std::memcpy(&records_[count], &message, sizeof(MarketDataMessage));
+    header_->count.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+bool MarketDataRecording::read(std::uint64_t sequence_number, MarketDataMessage& message) const {
+    if (!header_) {
+        return false;
+    }
+
+    std::uint64_t count = header_->count.load(std::memory_order_acquire);
+    std::uint64_t first = header_->first_sequence.load(std::memory_order_relaxed);
+    if (count == 0 || sequence_number < first || sequence_number - first >= count) {
+        return false;
+    }
+
+    std::memcpy(&message, &records_[sequence_number - first], sizeof(MarketDataMessage));
+    return true;
+}
+
+std::uint64_t MarketDataRecording::lastSequence() const {
+    if (!header_) {
+        return 0;
+    }
+    std::uint64_t count = header_->count.load(std::memory_order_acquire);
+    return count == 0 ? 0 : header_->first_sequence.load(std::memory_order_relaxed) + count - 1;
+}
+
+std::size_t MarketDataRecording::recordsOffset() {
+    // Keep records cache-line aligned after the header
+    return (sizeof(Header) + 63) & ~static_cast<std::size_t>(63);
+}
+
+} // namespace trading
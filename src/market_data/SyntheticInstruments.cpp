@@ -0,0 +1,163 @@
+#include "market_data/SyntheticInstruments.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace trading {
+
+SyntheticInstruments::SyntheticInstruments() {
+    dependency_offsets_.push_back(0);
+}
+
+bool SyntheticInstruments::configure(const std::vector<Config::SyntheticConfig>& synthetics, SymbolTable& symbols,
+                                     std::string& error) {
+    auto valid_symbol = [](const std::string& symbol) {
+        return !symbol.empty() && symbol.size() <= kMaxSymbolNameLength;
+    };
+
+    // Nothing reaches the symbol table until the whole list is valid
+    std::unordered_set<std::string> names;
+    for (const Config::SyntheticConfig& synthetic : synthetics) {
+        names.insert(synthetic.name);
+    }
+    for (std::size_t i = 0; i < synthetics.size(); ++i) {
+        const Config::SyntheticConfig& synthetic = synthetics[i];
+        const std::string where = "synthetic " + std::to_string(i) + " (" + synthetic.name + "): ";
+        if (!valid_symbol(synthetic.name)) {
+            error = where + "name must be 1 to " + std::to_string(kMaxSymbolNameLength) + " characters";
+            return false;
+        }
+        const bool basket = synthetic.type == "basket";
+        const bool ratio = synthetic.type == "ratio";
+        if (!basket && !ratio && synthetic.type != "spread") {
+            error = where + "unknown type '" + synthetic.type + "' (spread, ratio or basket)";
+            return false;
+        }
+        if (basket ? synthetic.legs.empty() || synthetic.legs.size() > kMaxLegs : synthetic.legs.size() != 2) {
+            error = where + (basket ? "a basket needs 1 to " + std::to_string(kMaxLegs) + " legs"
+                                    : synthetic.type + " needs exactly 2 legs");
+            return false;
+        }
+        if (ratio && synthetic.offset != 0.0) {
+            error = where + "a ratio takes no offset";
+            return false;
+        }
+        if (!std::isfinite(synthetic.offset)) {
+            error = where + "offset must be finite";
+            return false;
+        }
+        for (std::size_t leg = 0; leg < synthetic.legs.size(); ++leg) {
+            const Config::SyntheticLegConfig& leg_config = synthetic.legs[leg];
+            if (!valid_symbol(leg_config.symbol)) {
+                error = where + "leg symbols must be 1 to " + std::to_string(kMaxSymbolNameLength) + " characters";
+                return false;
+            }
+            if (!std::isfinite(leg_config.weight) || (basket ? leg_config.weight == 0.0 : !(leg_config.weight > 0.0))) {
+                error = where + "leg " + leg_config.symbol + (basket ? " needs a non-zero weight" : " needs a positive weight");
+                return false;
+            }
+            for (std::size_t other = 0; other < leg; ++other) {
+                if (synthetic.legs[other].symbol == leg_config.symbol) {
+                    error = where + "leg " + leg_config.symbol + " listed twice";
+                    return false;
+                }
+            }
+            if (names.count(leg_config.symbol) != 0) {
+                error = where + "leg " + leg_config.symbol + " is itself a synthetic";
+                return false;
+            }
+        }
+    }
+    if (names.size() != synthetics.size()) {
+        error = "a synthetic name is listed twice";
+        return false;
+    }
+
+    std::unordered_set<std::string> new_symbols;
+    for (const Config::SyntheticConfig& synthetic : synthetics) {
+        if (symbols.find(synthetic.name.c_str()) == kInvalidSymbolId) {
+            new_symbols.insert(synthetic.name);
+        }
+        for (const Config::SyntheticLegConfig& leg : synthetic.legs) {
+            if (symbols.find(leg.symbol.c_str()) == kInvalidSymbolId) {
+                new_symbols.insert(leg.symbol);
+            }
+        }
+    }
+    if (symbols.size() + new_symbols.size() > symbols.capacity()) {
+        error = "symbol table full";
+        return false;
+    }
+
+    std::vector<Synthetic> resolved;
+    std::vector<Leg> legs;
+    for (std::size_t i = 0; i < synthetics.size(); ++i) {
+        const Config::SyntheticConfig& synthetic = synthetics[i];
+        const bool ratio = synthetic.type == "ratio";
+        const bool spread = synthetic.type == "spread";
+        Synthetic entry{symbols.findOrInsert(synthetic.name.c_str()), ratio,
+                        static_cast<std::uint32_t>(synthetic.legs.size()), 0,
+                        ratio ? std::log(synthetic.legs[0].weight / synthetic.legs[1].weight) : synthetic.offset,
+                        0.0, static_cast<std::uint32_t>(legs.size()), 0};
+        for (std::size_t leg = 0; leg < synthetic.legs.size(); ++leg) {
+            const Config::SyntheticLegConfig& leg_config = synthetic.legs[leg];
+            const double sign = (spread || ratio) && leg == 1 ? -1.0 : 1.0;
+            legs.push_back(Leg{symbols.findOrInsert(leg_config.symbol.c_str()),
+                               sign * (ratio ? 1.0 : leg_config.weight)});
+        }
+        entry.last_leg = static_cast<std::uint32_t>(legs.size());
+        resolved.push_back(entry);
+    }
+
+    SymbolId leg_count = 0;
+    SymbolId synthetic_count = 0;
+    for (const Leg& leg : legs) {
+        leg_count = std::max<SymbolId>(leg_count, leg.symbol_id + 1);
+    }
+    for (const Synthetic& synthetic : resolved) {
+        synthetic_count = std::max<SymbolId>(synthetic_count, synthetic.symbol_id + 1);
+    }
+
+    synthetics_ = std::move(resolved);
+    legs_ = std::move(legs);
+    last_price_.assign(leg_count, 0.0);
+    is_synthetic_.assign(synthetic_count, false);
+    dependency_offsets_.assign(leg_count + 1, 0);
+    dependencies_.assign(legs_.size(), Dependency{0, 0.0});
+    for (const Synthetic& synthetic : synthetics_) {
+        is_synthetic_[synthetic.symbol_id] = true;
+        for (std::uint32_t leg = synthetic.first_leg; leg < synthetic.last_leg; ++leg) {
+            dependency_offsets_[legs_[leg].symbol_id + 1]++;
+        }
+    }
+    for (SymbolId id = 0; id < leg_count; ++id) {
+        dependency_offsets_[id + 1] += dependency_offsets_[id];
+    }
+
+    // Fill each leg's slice in synthetic order
+    std::vector<std::uint32_t> next(dependency_offsets_.begin(), dependency_offsets_.end() - 1);
+    for (std::uint32_t index = 0; index < synthetics_.size(); ++index) {
+        const Synthetic& synthetic = synthetics_[index];
+        for (std::uint32_t leg = synthetic.first_leg; leg < synthetic.last_leg; ++leg) {
+            dependencies_[next[legs_[leg].symbol_id]++] = Dependency{index, legs_[leg].coefficient};
+        }
+    }
+    return true;
+}
+
+double SyntheticInstruments::recompute(std::size_t index) const {
+    Synthetic synthetic = synthetics_[index];
+    refresh(synthetic);
+    return valueOf(synthetic);
+}
+
+void SyntheticInstruments::refresh(Synthetic& synthetic) const {
+    double sum = 0.0;
+    for (std::uint32_t leg = synthetic.first_leg; leg < synthetic.last_leg; ++leg) {
+        const double price = last_price_[legs_[leg].symbol_id];
+        sum += legs_[leg].coefficient * (synthetic.ratio ? std::log(price) : price);
+    }
+    synthetic.sum = sum;
+    synthetic.updates = 0;
+}
+
+} // namespace trading
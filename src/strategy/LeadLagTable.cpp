@@ -0,0 +1,137 @@
+#include "strategy/LeadLagTable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace trading {
+
+LeadLagTable::LeadLagTable()
+    : settings_{0, 1, 1}
+    , alpha_(1.0)
+{
+    follower_offsets_.push_back(0);
+}
+
+bool LeadLagTable::configure(const std::vector<Config::LeadLagPairConfig>& pairs, const LeadLagSettings& settings,
+                             SymbolTable& symbols, std::string& error) {
+    if (settings.max_lag_ns <= 0 || settings.half_life_events == 0) {
+        error = "max_lag_ns and half_life_events must be positive";
+        return false;
+    }
+
+    // Check names and repeats against a scratch table, so a refused list
+    // leaves no symbols behind in the engine's
+    struct Resolved {
+        SymbolId leader;
+        SymbolId follower;
+    };
+    SymbolTable seen(2 * pairs.size() + 1);
+    std::vector<Resolved> resolved;
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+        const Config::LeadLagPairConfig& pair = pairs[i];
+        const std::string where = "pair " + std::to_string(i) + " (" + pair.leader + " -> " + pair.follower + "): ";
+        if (pair.leader.empty() || pair.leader.size() > kMaxSymbolNameLength ||
+            pair.follower.empty() || pair.follower.size() > kMaxSymbolNameLength) {
+            error = where + "symbols must be 1 to " + std::to_string(kMaxSymbolNameLength) + " characters";
+            return false;
+        }
+        if (pair.leader == pair.follower) {
+            error = where + "a symbol cannot lead itself";
+            return false;
+        }
+        resolved.push_back(Resolved{seen.findOrInsert(pair.leader.c_str()), seen.findOrInsert(pair.follower.c_str())});
+    }
+
+    std::vector<Resolved> sorted = resolved;
+    std::sort(sorted.begin(), sorted.end(), [](const Resolved& a, const Resolved& b) {
+        return a.follower != b.follower ? a.follower < b.follower : a.leader < b.leader;
+    });
+    for (std::size_t i = 1; i < sorted.size(); ++i) {
+        if (sorted[i].follower == sorted[i - 1].follower && sorted[i].leader == sorted[i - 1].leader) {
+            error = "pair " + seen.name(sorted[i].leader) + " -> " + seen.name(sorted[i].follower) + " listed twice";
+            return false;
+        }
+    }
+
+    std::size_t new_symbols = 0;
+    for (SymbolId id = 0; id < seen.size(); ++id) {
+        new_symbols += symbols.find(seen.name(id).c_str()) == kInvalidSymbolId ? 1 : 0;
+    }
+    if (symbols.size() + new_symbols > symbols.capacity()) {
+        error = "symbol table full";
+        return false;
+    }
+
+    // Valid: give the pair symbols engine ids, sorted by follower
+    for (Resolved& pair : resolved) {
+        pair.leader = symbols.findOrInsert(seen.name(pair.leader).c_str());
+        pair.follower = symbols.findOrInsert(seen.name(pair.follower).c_str());
+    }
+    std::stable_sort(resolved.begin(), resolved.end(), [](const Resolved& a, const Resolved& b) {
+        return a.follower != b.follower ? a.follower < b.follower : a.leader < b.leader;
+    });
+
+    SymbolId symbol_count = 0;
+    for (const Resolved& pair : resolved) {
+        symbol_count = std::max<SymbolId>(symbol_count, std::max(pair.leader, pair.follower) + 1);
+    }
+
+    settings_ = settings;
+    settings_.min_samples = std::max<std::uint32_t>(settings.min_samples, 1);
+    alpha_ = 1.0 - std::exp2(-1.0 / settings.half_life_events);
+    last_event_ns_.assign(symbol_count, 0);
+    last_trend_.assign(symbol_count, 0);
+    follower_offsets_.assign(symbol_count + 1, 0);
+    pairs_.clear();
+    pairs_.reserve(resolved.size());
+    for (const Resolved& pair : resolved) {
+        follower_offsets_[pair.follower + 1]++;
+        pairs_.push_back(PairStatistics{pair.leader, 0, 0.0, 0.0, 0.0});
+    }
+    for (SymbolId id = 0; id < symbol_count; ++id) {
+        follower_offsets_[id + 1] += follower_offsets_[id];
+    }
+    return true;
+}
+
+LeadLagFeatures LeadLagTable::features(SymbolId symbol_id, std::int64_t timestamp) const {
+    LeadLagFeatures features{};
+    if (symbol_id >= last_event_ns_.size()) {
+        return features;
+    }
+
+    const PairStatistics* best = nullptr;
+    for (std::uint32_t i = follower_offsets_[symbol_id]; i < follower_offsets_[symbol_id + 1]; ++i) {
+        const PairStatistics& pair = pairs_[i];
+        if (pair.samples >= settings_.min_samples && last_trend_[pair.leader] != 0 &&
+            (best == nullptr || pair.agreement > best->agreement)) {
+            best = &pair;
+        }
+    }
+    if (best == nullptr) {
+        return features;
+    }
+
+    features.has_leader = true;
+    features.leader = best->leader;
+    features.leader_trend = last_trend_[best->leader];
+    features.since_leader_ns = timestamp - last_event_ns_[best->leader];
+    features.mean_lag_ns = best->mean_lag_ns;
+    features.lag_stddev_ns = std::sqrt(best->lag_variance);
+    features.agreement = best->agreement;
+    features.samples = best->samples;
+    return features;
+}
+
+std::size_t LeadLagTable::find(SymbolId leader, SymbolId follower) const {
+    if (follower >= last_event_ns_.size()) {
+        return pairs_.size();
+    }
+    for (std::uint32_t i = follower_offsets_[follower]; i < follower_offsets_[follower + 1]; ++i) {
+        if (pairs_[i].leader == leader) {
+            return i;
+        }
+    }
+    return pairs_.size();
+}
+
+} // namespace trading
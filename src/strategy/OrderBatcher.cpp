@@ -0,0 +1,89 @@
+#include "strategy/OrderBatcher.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace trading {
+
+namespace {
+constexpr double kFlatQuantity = 1e-9;  // Net quantities below this cancel out
+}
+
+OrderBatcher::OrderBatcher(std::size_t max_orders, std::size_t max_symbols)
+    : max_orders_(std::min<std::size_t>(std::max<std::size_t>(max_orders, 1), kMaxOrdersPerBatch))
+    , entry_of_symbol_(max_symbols, kNoEntry)
+{
+    static_assert(sizeof(TradingOrderBatchHeader) % alignof(TradingOrder) == 0,
+                  "Orders must stay aligned after the batch header");
+
+    entries_.reserve(max_orders_);
+    message_symbols_.reserve(max_orders_);
+    const std::size_t bytes = sizeof(TradingOrderBatchHeader) + max_orders_ * sizeof(TradingOrder);
+    message_.resize((bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+}
+
+bool OrderBatcher::add(SymbolId symbol_id, const TradingOrder& order) {
+    if (symbol_id >= entry_of_symbol_.size()) {
+        return false;
+    }
+
+    const double quantity = order.signal == SignalType::BUY ? order.quantity : -order.quantity;
+    std::uint32_t& index = entry_of_symbol_[symbol_id];
+
+    if (index == kNoEntry) {
+        if (entries_.size() >= max_orders_) {
+            return false;
+        }
+        index = static_cast<std::uint32_t>(entries_.size());
+        entries_.push_back(Entry{symbol_id, quantity, order, 1, false});
+    } else {
+        Entry& entry = entries_[index];
+        entry.opposed = entry.opposed || order.signal != entry.order.signal;
+        entry.net_quantity += quantity;
+        entry.order.price = order.price;
+        entry.orders++;
+    }
+    return true;
+}
+
+OrderBatcher::Batch OrderBatcher::build() {
+    std::uint8_t* data = reinterpret_cast<std::uint8_t*>(message_.data());
+    TradingOrder* orders = reinterpret_cast<TradingOrder*>(data + sizeof(TradingOrderBatchHeader));
+    message_symbols_.clear();
+
+    std::uint32_t count = 0;
+    std::uint32_t netted = 0;
+    for (Entry& entry : entries_) {
+        entry_of_symbol_[entry.symbol_id] = kNoEntry;
+        const bool flat = std::fabs(entry.net_quantity) < kFlatQuantity;
+        // Same-side orders merged into one are not netting
+        if (entry.opposed) {
+            netted += entry.orders - (flat ? 0 : 1);
+        }
+        if (flat) {
+            continue;
+        }
+
+        TradingOrder order = entry.order;
+        order.signal = entry.net_quantity > 0.0 ? SignalType::BUY : SignalType::SELL;
+        order.quantity = std::fabs(entry.net_quantity);
+        std::memcpy(&orders[count++], &order, sizeof(TradingOrder));
+        message_symbols_.push_back(entry.symbol_id);
+    }
+
+    TradingOrderBatchHeader header{kTradingOrderBatchMagic, count};
+    std::memcpy(data, &header, sizeof(header));
+
+    Batch batch;
+    batch.data = data;
+    batch.length = sizeof(TradingOrderBatchHeader) + count * sizeof(TradingOrder);
+    batch.orders = orders;
+    batch.symbols = message_symbols_.data();
+    batch.count = count;
+    batch.netted = netted;
+
+    entries_.clear();
+    return batch;
+}
+
+} // namespace trading
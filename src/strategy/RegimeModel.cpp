@@ -0,0 +1,226 @@
+#include "strategy/RegimeModel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace trading {
+
+namespace {
+
+constexpr std::uint32_t kRegimeModelMagic = 0x4D4D4852;  // "RHMM"
+constexpr std::uint16_t kRegimeModelVersion = 2;
+constexpr std::size_t kSymbolBytes = 16;
+
+struct RegimeModelFileHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t states;
+    std::uint16_t features;
+    std::uint16_t reserved;
+    std::uint32_t models;
+};
+static_assert(sizeof(RegimeModelFileHeader) == 16, "RegimeModelFileHeader layout changed");
+
+template <std::size_t K>
+void flatten(const HmmParameters<K, kRegimeFeatures>& parameters, std::vector<double>& values) {
+    values.insert(values.end(), parameters.initial.begin(), parameters.initial.end());
+    for (const auto& row : parameters.transition) {
+        values.insert(values.end(), row.begin(), row.end());
+    }
+    for (const auto& row : parameters.mean) {
+        values.insert(values.end(), row.begin(), row.end());
+    }
+    for (const auto& row : parameters.variance) {
+        values.insert(values.end(), row.begin(), row.end());
+    }
+}
+
+template <std::size_t K>
+HmmParameters<K, kRegimeFeatures> unflatten(const double* next) {
+    HmmParameters<K, kRegimeFeatures> parameters;
+    for (double& p : parameters.initial) {
+        p = *next++;
+    }
+    for (auto& row : parameters.transition) {
+        for (double& p : row) {
+            p = *next++;
+        }
+    }
+    for (auto& row : parameters.mean) {
+        for (double& m : row) {
+            m = *next++;
+        }
+    }
+    for (auto& row : parameters.variance) {
+        for (double& v : row) {
+            v = std::max(*next++, hmm_detail::kMinVariance);
+        }
+    }
+
+    // Tolerate rounding in hand-edited files
+    hmm_detail::normalize(parameters.initial);
+    for (auto& row : parameters.transition) {
+        hmm_detail::normalize(row);
+    }
+    return parameters;
+}
+
+} // namespace
+
+std::size_t RegimeModel::states() const {
+    return std::visit([](const auto& model) -> std::size_t {
+        if constexpr (std::is_same_v<std::decay_t<decltype(model)>, std::monostate>) {
+            return 0;
+        } else {
+            return std::decay_t<decltype(model)>::kStates;
+        }
+    }, model_);
+}
+
+void RegimeModel::reset(RegimeBelief& belief) const {
+    belief.fill(0.0);
+    std::visit([&](const auto& model) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(model)>, std::monostate>) {
+            model.reset(belief.data());
+        }
+    }, model_);
+}
+
+void RegimeModel::serialize(std::vector<double>& values) const {
+    std::visit([&](const auto& model) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(model)>, std::monostate>) {
+            flatten(model.parameters(), values);
+        }
+    }, model_);
+}
+
+bool RegimeModel::deserialize(std::size_t k, const double* values) {
+    for (std::size_t i = 0; i < serializedSize(k); ++i) {
+        if (!std::isfinite(values[i])) {
+            return false;
+        }
+    }
+
+    switch (k) {
+        case 2:
+            model_ = GaussianHMM<2, kRegimeFeatures>(unflatten<2>(values));
+            return true;
+        case 3:
+            model_ = GaussianHMM<3, kRegimeFeatures>(unflatten<3>(values));
+            return true;
+        case 4:
+            model_ = GaussianHMM<4, kRegimeFeatures>(unflatten<4>(values));
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool RegimeModelSet::load(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    RegimeModelFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kRegimeModelMagic) {
+        error = path + " is not a regime model file";
+        return false;
+    }
+    if (header.version != kRegimeModelVersion || header.features != kRegimeFeatures) {
+        error = "unsupported regime model version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.states < kMinRegimeStates || header.states > kMaxRegimeStates) {
+        error = "unsupported regime state count " + std::to_string(header.states);
+        return false;
+    }
+
+    RegimeModel default_model;
+    std::unordered_map<std::string, RegimeModel> symbol_models;
+    std::vector<double> values(RegimeModel::serializedSize(header.states));
+    for (std::uint32_t i = 0; i < header.models; ++i) {
+        char symbol[kSymbolBytes];
+        if (!file.read(symbol, sizeof(symbol)) ||
+            !file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(double))) {
+            error = path + " is truncated";
+            return false;
+        }
+        symbol[kSymbolBytes - 1] = '\0';
+
+        RegimeModel model;
+        if (!model.deserialize(header.states, values.data())) {
+            error = path + " contains a non-finite parameter";
+            return false;
+        }
+        if (symbol[0] == '\0') {
+            default_model = std::move(model);
+        } else {
+            symbol_models[symbol] = std::move(model);
+        }
+    }
+    if (!default_model.loaded()) {
+        error = path + " has no default model";
+        return false;
+    }
+
+    default_model_ = std::move(default_model);
+    symbol_models_ = std::move(symbol_models);
+    return true;
+}
+
+bool RegimeModelSet::save(const std::string& path) const {
+    if (!default_model_.loaded()) {
+        return false;
+    }
+
+    RegimeModelFileHeader header{kRegimeModelMagic, kRegimeModelVersion,
+                                 static_cast<std::uint16_t>(states()),
+                                 static_cast<std::uint16_t>(kRegimeFeatures), 0,
+                                 static_cast<std::uint32_t>(symbol_models_.size() + 1)};
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<double> values;
+    auto write = [&](const std::string& symbol, const RegimeModel& model) {
+        char name[kSymbolBytes] = {};
+        std::strncpy(name, symbol.c_str(), kSymbolBytes - 1);
+        values.clear();
+        model.serialize(values);
+        file.write(name, sizeof(name));
+        file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    };
+
+    write("", default_model_);
+    for (const auto& entry : symbol_models_) {
+        write(entry.first, entry.second);
+    }
+    return static_cast<bool>(file);
+}
+
+void RegimeModelSet::setDefault(RegimeModel model) {
+    default_model_ = std::move(model);
+    for (auto it = symbol_models_.begin(); it != symbol_models_.end();) {
+        it = it->second.states() != default_model_.states() ? symbol_models_.erase(it) : std::next(it);
+    }
+}
+
+bool RegimeModelSet::set(const std::string& symbol, RegimeModel model) {
+    if (model.states() != default_model_.states() || symbol.empty() || symbol.size() >= kSymbolBytes) {
+        return false;
+    }
+    symbol_models_[symbol] = std::move(model);
+    return true;
+}
+
+const RegimeModel& RegimeModelSet::lookup(const char* symbol) const {
+    auto it = symbol_models_.find(symbol);
+    return it != symbol_models_.end() ? it->second : default_model_;
+}
+
+} // namespace trading
@@ -0,0 +1,151 @@
+#include "strategy/RegimeTrainer.h"
+#include <cmath>
+#include <limits>
+
+#include "common/DeterministicRng.h"
+#include "common/WorkStealingPool.h"
+
+namespace trading {
+
+namespace {
+
+using Sequences = std::vector<std::vector<RegimeObservation>>;
+
+// Start for restarts after the first: means moved by up to a standard
+// deviation of the data, random transition rows that still favour staying.
+// Drawn from DeterministicRng, so a seed gives the same models everywhere
+template <std::size_t K>
+HmmParameters<K, kRegimeFeatures> perturb(const HmmParameters<K, kRegimeFeatures>& start,
+                                          std::uint64_t seed) {
+    DeterministicRng rng(seed);
+
+    HmmParameters<K, kRegimeFeatures> parameters = start;
+    for (std::size_t k = 0; k < K; ++k) {
+        for (std::size_t d = 0; d < kRegimeFeatures; ++d) {
+            parameters.mean[k][d] += rng.normal() * std::sqrt(start.variance[k][d]);
+        }
+        for (std::size_t j = 0; j < K; ++j) {
+            parameters.transition[k][j] = rng.uniform() + (j == k ? 2.0 * K : 0.0);
+        }
+        hmm_detail::normalize(parameters.transition[k]);
+    }
+    return parameters;
+}
+
+std::uint64_t jobSeed(std::uint64_t seed, std::size_t model, int restart) {
+    // splitmix64 of the job coordinates, so a job's start does not depend on which thread runs it
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (model * 1024 + static_cast<std::uint64_t>(restart) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+void RegimeTrainer::addSequence(const std::string& symbol, std::vector<RegimeObservation> sequence) {
+    symbols_.push_back(symbol);
+    sequences_.emplace_back();
+    sequences_.back().push_back(std::move(sequence));
+}
+
+bool RegimeTrainer::train(const RegimeTrainingOptions& options, RegimeModelSet& models,
+                          RegimeTrainingReport& report) const {
+    if (options.max_iterations <= 0 || options.restarts <= 0) {
+        return false;
+    }
+
+    switch (options.states) {
+        case 2:
+            return trainStates<2>(options, models, report);
+        case 3:
+            return trainStates<3>(options, models, report);
+        case 4:
+            return trainStates<4>(options, models, report);
+        default:
+            return false;
+    }
+}
+
+template <std::size_t K>
+bool RegimeTrainer::trainStates(const RegimeTrainingOptions& options, RegimeModelSet& models,
+                                RegimeTrainingReport& report) const {
+    using Result = HmmTrainingResult<K, kRegimeFeatures>;
+
+    report = RegimeTrainingReport{0, 0, 0, 0, 0, 0, 0, 0.0};
+
+    // Model 0 is the pooled default; the rest are symbols with enough history
+    Sequences pooled;
+    std::vector<std::size_t> trained_symbols;
+    for (std::size_t s = 0; s < sequences_.size(); ++s) {
+        const Sequences::value_type& sequence = sequences_[s].front();
+        if (sequence.empty()) {
+            continue;
+        }
+        report.symbols++;
+        report.events += sequence.size();
+        pooled.push_back(sequence);
+        if (sequence.size() >= std::max<std::size_t>(options.min_events, K)) {
+            trained_symbols.push_back(s);
+        }
+    }
+    if (report.events < K) {
+        return false;
+    }
+
+    const std::size_t model_count = trained_symbols.size() + 1;
+    const std::size_t restarts = static_cast<std::size_t>(options.restarts);
+    std::vector<Result> results(model_count * restarts);
+
+    {
+        WorkStealingPool pool(options.threads);
+        for (std::size_t model = 0; model < model_count; ++model) {
+            const Sequences& data = model == 0 ? pooled : sequences_[trained_symbols[model - 1]];
+            for (std::size_t restart = 0; restart < restarts; ++restart) {
+                pool.submit([&, model, restart, &data = data]() {
+                    auto start = initialHmmParameters<K, kRegimeFeatures>(data);
+                    if (restart > 0) {
+                        start = perturb(start, jobSeed(options.seed, model, static_cast<int>(restart)));
+                    }
+                    // Each job writes only its own slot
+                    results[model * restarts + restart] =
+                        trainBaumWelch(data, start, options.max_iterations, options.tolerance);
+                });
+            }
+        }
+        pool.wait();
+        report.stolen_jobs = pool.getStatistics().stolen;
+    }
+
+    report.jobs = results.size();
+    for (const Result& result : results) {
+        report.iterations += static_cast<std::uint64_t>(result.iterations);
+        report.converged_jobs += result.converged ? 1 : 0;
+    }
+
+    // Keep the most likely restart of each model
+    auto best = [&](std::size_t model) -> const Result& {
+        const Result* chosen = &results[model * restarts];
+        for (std::size_t restart = 1; restart < restarts; ++restart) {
+            const Result& candidate = results[model * restarts + restart];
+            if (candidate.log_likelihood > chosen->log_likelihood) {
+                chosen = &candidate;
+            }
+        }
+        return *chosen;
+    };
+
+    RegimeModelSet trained;
+    const Result& pooled_best = best(0);
+    report.default_log_likelihood = pooled_best.log_likelihood;
+    trained.setDefault(RegimeModel(pooled_best.parameters));
+    for (std::size_t model = 1; model < model_count; ++model) {
+        if (trained.set(symbols_[trained_symbols[model - 1]], RegimeModel(best(model).parameters))) {
+            report.symbol_models++;
+        }
+    }
+
+    models = std::move(trained);
+    return true;
+}
+
+} // namespace trading
@@ -0,0 +1,90 @@
+#include "strategy/RiskGate.h"
+#include <cmath>
+
+namespace trading {
+
+namespace {
+constexpr std::int64_t kRateWindowNs = 1000000000;
+
+void increment(std::atomic<std::uint64_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+}
+
+RiskGate::RiskGate(RcuDomain& domain, const RiskLimits& defaults, std::size_t max_symbols)
+    : limits_(domain, std::make_unique<RiskLimitTable>(defaults))
+    , checks_(0)
+    , rejected_position_(0)
+    , rejected_notional_(0)
+    , rejected_rate_(0)
+    , rejected_price_band_(0)
+{
+    // state() grows within this, so a check for a new symbol does not allocate
+    symbols_.reserve(max_symbols);
+}
+
+RiskCheckResult RiskGate::check(SymbolId id, const char* symbol, double quantity, double price,
+                                std::int64_t now_ns) {
+    increment(checks_);
+    const RiskLimits& limits = limits_.read()->lookup(symbol);
+    SymbolRisk& risk = state(id);
+
+    // Fat-finger band around the last known price
+    if (limits.price_band_bps > 0.0 && risk.reference_price > 0.0 &&
+        std::fabs(price - risk.reference_price) > risk.reference_price * limits.price_band_bps * 1e-4) {
+        increment(rejected_price_band_);
+        return RiskCheckResult::PRICE_BAND;
+    }
+
+    if (limits.max_notional > 0.0 && std::fabs(quantity) * price > limits.max_notional) {
+        increment(rejected_notional_);
+        return RiskCheckResult::MAX_NOTIONAL;
+    }
+
+    const double projected = risk.position + quantity;
+    if (limits.max_position > 0.0 && std::fabs(projected) > limits.max_position &&
+        std::fabs(projected) > std::fabs(risk.position)) {
+        // Orders that reduce an over-limit position are still allowed
+        increment(rejected_position_);
+        return RiskCheckResult::MAX_POSITION;
+    }
+
+    if (now_ns - risk.window_start_ns >= kRateWindowNs) {
+        risk.window_start_ns = now_ns;
+        risk.window_orders = 0;
+    }
+    if (limits.max_orders_per_second > 0 && risk.window_orders >= limits.max_orders_per_second) {
+        increment(rejected_rate_);
+        return RiskCheckResult::ORDER_RATE;
+    }
+
+    risk.position = projected;
+    risk.window_orders++;
+    return RiskCheckResult::ACCEPTED;
+}
+
+RiskGate::Statistics RiskGate::getStatistics() const {
+    return Statistics{checks_.load(std::memory_order_relaxed),
+                      rejected_position_.load(std::memory_order_relaxed),
+                      rejected_notional_.load(std::memory_order_relaxed),
+                      rejected_rate_.load(std::memory_order_relaxed),
+                      rejected_price_band_.load(std::memory_order_relaxed)};
+}
+
+const char* riskCheckResultName(RiskCheckResult result) {
+    switch (result) {
+        case RiskCheckResult::ACCEPTED:
+            return "accepted";
+        case RiskCheckResult::MAX_POSITION:
+            return "max position";
+        case RiskCheckResult::MAX_NOTIONAL:
+            return "max notional";
+        case RiskCheckResult::ORDER_RATE:
+            return "order rate";
+        case RiskCheckResult::PRICE_BAND:
+            return "price band";
+    }
+    return "unknown";
+}
+
+} // namespace trading
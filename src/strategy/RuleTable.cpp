@@ -0,0 +1,173 @@
+#include "strategy/RuleTable.h"
+#include <limits>
+
+namespace trading {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// Names indexed by DCEventType, MarketState and position bucket
+const char* const kEventNames[] = {"none", "upturn", "downturn"};
+const char* const kRegimeNames[] = {"unknown", "low", "high", "normal"};
+const char* const kPositionNames[] = {"flat", "long", "short"};
+
+// A rule field as a bit per accepted value; "any" accepts all of them
+template <std::size_t N>
+bool parseMask(const std::string& value, const char* const (&names)[N], std::uint32_t any, std::uint32_t& mask) {
+    if (value.empty() || value == "any") {
+        mask = any;
+        return true;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        if (value == names[i]) {
+            mask = 1u << i;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct CompiledRule {
+    std::uint32_t events;
+    std::uint32_t regimes;
+    std::uint32_t positions;
+    double min_return;
+    double max_return;
+    double min_tmv;
+    double max_tmv;
+    RuleTable::Decision decision;
+};
+
+bool buildAxis(std::vector<double> bounds, std::array<double, RuleTable::kMaxBounds>& axis, std::size_t& count) {
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    if (bounds.size() > RuleTable::kMaxBounds) {
+        return false;
+    }
+    axis.fill(kInfinity);
+    std::copy(bounds.begin(), bounds.end(), axis.begin());
+    count = bounds.size();
+    return true;
+}
+
+} // namespace
+
+RuleTable::RuleTable()
+    : cells_(kEvents * kRegimes * kPositions, Decision{SignalType::NONE, 0.0f})
+    , rules_(0)
+{
+    return_axis_.bounds.fill(kInfinity);
+    return_axis_.count = 0;
+    tmv_axis_.bounds.fill(kInfinity);
+    tmv_axis_.count = 0;
+}
+
+double RuleTable::Axis::lower(std::size_t b) const {
+    return b == 0 ? -kInfinity : bounds[b - 1];
+}
+
+double RuleTable::Axis::upper(std::size_t b) const {
+    return b == count ? kInfinity : bounds[b];
+}
+
+bool RuleTable::compile(const std::vector<Config::TradingRuleConfig>& rules, std::string& error) {
+    std::vector<CompiledRule> compiled;
+    std::vector<double> return_bounds;
+    std::vector<double> tmv_bounds;
+
+    for (std::size_t i = 0; i < rules.size(); ++i) {
+        const Config::TradingRuleConfig& rule = rules[i];
+        const std::string where = "rule " + std::to_string(i + 1) + ": ";
+        CompiledRule entry;
+
+        if (!parseMask(rule.event, kEventNames, 0x6u, entry.events) || entry.events == 1u) {
+            error = where + "unknown event '" + rule.event + "'";
+            return false;
+        }
+        if (!parseMask(rule.regime, kRegimeNames, 0xFu, entry.regimes)) {
+            error = where + "unknown regime '" + rule.regime + "'";
+            return false;
+        }
+        if (!parseMask(rule.position, kPositionNames, 0x7u, entry.positions)) {
+            error = where + "unknown position '" + rule.position + "'";
+            return false;
+        }
+
+        if (rule.action == "buy" || rule.action == "sell") {
+            if (!(rule.size > 0.0) || !std::isfinite(rule.size)) {
+                error = where + "size must be positive";
+                return false;
+            }
+            entry.decision = Decision{rule.action == "buy" ? SignalType::BUY : SignalType::SELL,
+                                      static_cast<float>(rule.size)};
+        } else if (rule.action == "none") {
+            entry.decision = Decision{SignalType::NONE, 0.0f};
+        } else {
+            error = where + "unknown action '" + rule.action + "'";
+            return false;
+        }
+
+        if (!(rule.min_return < rule.max_return) || !(rule.min_tmv < rule.max_tmv)) {
+            error = where + "empty range";
+            return false;
+        }
+        entry.min_return = rule.min_return;
+        entry.max_return = rule.max_return;
+        entry.min_tmv = rule.min_tmv;
+        entry.max_tmv = rule.max_tmv;
+        for (double bound : {rule.min_return, rule.max_return}) {
+            if (std::isfinite(bound)) {
+                return_bounds.push_back(bound);
+            }
+        }
+        for (double bound : {rule.min_tmv, rule.max_tmv}) {
+            if (std::isfinite(bound)) {
+                tmv_bounds.push_back(bound);
+            }
+        }
+        compiled.push_back(entry);
+    }
+
+    Axis return_axis;
+    Axis tmv_axis;
+    if (!buildAxis(return_bounds, return_axis.bounds, return_axis.count) ||
+        !buildAxis(tmv_bounds, tmv_axis.bounds, tmv_axis.count)) {
+        error = "rules use more than " + std::to_string(kMaxBounds) + " distinct bounds on one feature";
+        return false;
+    }
+
+    // Every bucket lies wholly inside or outside each rule's ranges, so its
+    // bounds decide the match for every value in it
+    std::vector<Decision> cells;
+    cells.reserve(kEvents * kRegimes * kPositions * return_axis.buckets() * tmv_axis.buckets());
+    for (std::size_t event = 0; event < kEvents; ++event) {
+        for (std::size_t regime = 0; regime < kRegimes; ++regime) {
+            for (std::size_t position = 0; position < kPositions; ++position) {
+                for (std::size_t r = 0; r < return_axis.buckets(); ++r) {
+                    for (std::size_t t = 0; t < tmv_axis.buckets(); ++t) {
+                        Decision decision{SignalType::NONE, 0.0f};
+                        for (const CompiledRule& rule : compiled) {
+                            if ((rule.events >> event & 1u) && (rule.regimes >> regime & 1u) &&
+                                (rule.positions >> position & 1u) &&
+                                rule.min_return <= return_axis.lower(r) && return_axis.upper(r) <= rule.max_return &&
+                                rule.min_tmv <= tmv_axis.lower(t) && tmv_axis.upper(t) <= rule.max_tmv) {
+                                decision = rule.decision;
+                                break;
+                            }
+                        }
+                        cells.push_back(decision);
+                    }
+                }
+            }
+        }
+    }
+
+    return_axis_ = return_axis;
+    tmv_axis_ = tmv_axis;
+    cells_ = std::move(cells);
+    rules_ = rules.size();
+    return true;
+}
+
+} // namespace trading
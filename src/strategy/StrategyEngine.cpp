@@ -1,16 +1,49 @@
 #include "strategy/StrategyEngine.h"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <cmath>
 
 namespace trading {
 
+namespace {
+constexpr std::size_t kWorkerQueueCapacity = 4096;  // Decoded events a worker can fall behind by
+constexpr int kWorkerDrainLimit = 256;              // Events a worker handles per duty cycle
+}
+
 StrategyEngine::StrategyEngine()
     : running_(false)
+    , workers_running_(false)
     , hmm_enabled_(false)
-    , leverage_factor_(1.0)
+    , regime_wanted_(false)
     , current_market_state_(MarketState::UNKNOWN)
-    , statistics_{0, 0, 0, 0, 0, 0, MarketState::UNKNOWN}
+    , working_order_timeout_ns_(1000000000)
+    , symbol_throttle_{0, 0}
+    , global_throttle_limit_{0, 0}
+    , batching_enabled_(false)
+    , batch_window_ns_(0)
+    , risk_checks_enabled_(true)
+    , rcu_(kMaxStrategyWorkers + 1)
+    , rcu_reader_(rcu_.registerReader())
+    , symbol_parameters_(rcu_, std::make_unique<SymbolParameterTable>(SymbolParameters{0.004, 1.0}))
+    , symbol_parameters_version_(0)
+    , applied_symbol_parameters_version_(0)
+    , lead_lag_enabled_(false)
+    , ensemble_enabled_(false)
+    , worker_threads_(0)
+    , threaded_(false)
+    , signals_processed_(0)
+    , signals_outvoted_(0)
+    , execution_reports_(0)
 {
+    // Per-symbol state grows as symbols are first seen; reserving it all
+    // here keeps that growth from allocating on the signal path
+    symbol_regimes_.reserve(symbols_.capacity());
+    symbol_leverage_.reserve(symbols_.capacity());
+    symbol_votes_.reserve(symbols_.capacity());
+    for (std::size_t i = 0; i < kMaxStrategyWorkers; ++i) {
+        worker_readers_.push_back(rcu_.registerReader());
+    }
 }
 
 StrategyEngine::~StrategyEngine() {
@@ -56,16 +89,155 @@ bool StrategyEngine::initialize(std::shared_ptr<aeron::Aeron> aeron,
     }
 }
 
+bool StrategyEngine::subscribeExecutionReports(const std::string& report_channel,
+                                              std::int32_t report_stream_id) {
+    try {
+        LOG_STRATEGY("Creating subscription for execution reports: {} stream {}", 
+                    report_channel, report_stream_id);
+        
+        report_subscription_ = aeron_->addSubscription(report_channel, report_stream_id);
+        
+        // Wait for subscription to connect
+        while (!report_subscription_->isConnected()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        
+        return true;
+        
+    } catch (const std::exception& e) {
+        LOG_ERROR_STRATEGY("Failed to subscribe to execution reports: {}", e.what());
+        return false;
+    }
+}
+
+bool StrategyEngine::addStrategy(const StrategyInstanceSettings& settings) {
+    if (running_.load() || strategies_.size() >= kMaxStrategies) {
+        return false;
+    }
+    
+    StrategyVariant strategy;
+    if (!makeStrategy(settings.name, strategy, settings.rules)) {
+        return false;
+    }
+    
+    const std::uint16_t id = static_cast<std::uint16_t>(strategies_.size());
+    OrderPublisher& publisher = *this;
+    auto instance = std::make_unique<StrategyInstance>(id, strategy, settings, rcu_, publisher, symbols_.capacity());
+    if (risk_limits_) {
+        instance->setRiskLimits(std::make_unique<RiskLimitTable>(*risk_limits_));
+    }
+    strategies_.push_back(std::move(instance));
+    
+    LOG_STRATEGY("Strategy {} is {}: leverage {}, HMM {}, {} thetas, synthetics {}", id, settings.name,
+                settings.leverage_factor, settings.enable_hmm ? "on" : "off",
+                settings.thetas.empty() ? std::string("all") : std::to_string(settings.thetas.size()),
+                settings.trade_synthetics ? "traded" : "not traded");
+    return true;
+}
+
+bool StrategyEngine::updateStrategy(std::size_t strategy_id, const StrategyInstanceSettings& settings) {
+    if (strategy_id >= strategies_.size() || !strategies_[strategy_id]->updateParameters(settings)) {
+        LOG_ERROR_STRATEGY("Cannot update strategy {} to {}", strategy_id, settings.name);
+        return false;
+    }
+    
+    bool regime_wanted = false;
+    for (const auto& strategy : strategies_) {
+        regime_wanted = regime_wanted || strategy->usesRegime();
+    }
+    regime_wanted_.store(regime_wanted, std::memory_order_relaxed);
+    return true;
+}
+
+void StrategyEngine::setSymbolParameters(std::unique_ptr<SymbolParameterTable> parameters) {
+    const std::size_t overrides = parameters->size();
+    symbol_parameters_.update(std::move(parameters));
+    
+    // Bumped after the swap: the signal loop re-reads every leverage once it sees the new version
+    symbol_parameters_version_.fetch_add(1, std::memory_order_release);
+    LOG_STRATEGY("Symbol parameters set, {} symbols with their own", overrides);
+}
+
+bool StrategyEngine::setLeadLagPairs(const std::vector<Config::LeadLagPairConfig>& pairs,
+                                     const LeadLagSettings& settings) {
+    std::string error;
+    if (running_.load() || !lead_lag_.configure(pairs, settings, symbols_, error)) {
+        LOG_ERROR_STRATEGY("Cannot set lead-lag pairs: {}", running_.load() ? "engine running" : error);
+        return false;
+    }
+    
+    lead_lag_enabled_ = !pairs.empty();
+    LOG_STRATEGY("Lead-lag statistics over {} pairs, lags up to {} ns", lead_lag_.pairs(), settings.max_lag_ns);
+    return true;
+}
+
+bool StrategyEngine::setThetaEnsemble(const std::vector<std::uint32_t>& weights, std::uint32_t quorum) {
+    std::string error;
+    if (running_.load() || !theta_ensemble_.configure(weights, quorum, error)) {
+        LOG_ERROR_STRATEGY("Cannot set theta ensemble: {}", running_.load() ? "engine running" : error);
+        return false;
+    }
+    
+    ensemble_enabled_ = true;
+    LOG_STRATEGY("Theta ensemble over {} thetas, quorum {} of {}", theta_ensemble_.thetas(),
+                theta_ensemble_.quorum(), theta_ensemble_.totalWeight());
+    return true;
+}
+
+void StrategyEngine::setRiskLimits(std::unique_ptr<RiskLimitTable> limits) {
+    for (auto& strategy : strategies_) {
+        strategy->setRiskLimits(std::make_unique<RiskLimitTable>(*limits));
+    }
+    risk_limits_ = std::move(limits);
+}
+
 void StrategyEngine::start() {
     if (running_.load()) {
         LOG_STRATEGY("Strategy engine is already running");
         return;
     }
     
+    if (strategies_.empty()) {
+        addStrategy(StrategyInstanceSettings{DCTrendStrategy::kName, 1.0, true, {}, nullptr, false});
+    }
+    
+    // Several strategies share the reported position, so each counts its own fills
+    bool regime_wanted = false;
+    for (auto& strategy : strategies_) {
+        strategy->setReportMode(report_subscription_ != nullptr, strategies_.size() > 1);
+        strategy->setWorkingOrderTimeout(working_order_timeout_ns_);
+        strategy->setOrderThrottle(symbol_throttle_, global_throttle_limit_);
+        strategy->enableOrderBatching(batching_enabled_, batch_window_ns_);
+        strategy->enableRiskChecks(risk_checks_enabled_);
+        regime_wanted = regime_wanted || strategy->usesRegime();
+    }
+    regime_wanted_.store(regime_wanted, std::memory_order_relaxed);
+    
+    // Strategies are dealt round-robin to the workers
+    const std::size_t threads = std::min({worker_threads_, strategies_.size(), kMaxStrategyWorkers});
+    threaded_ = threads > 0;
+    workers_.clear();
+    for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i) {
+        workers_.push_back(std::make_unique<Worker>(threaded_ ? kWorkerQueueCapacity : 2,
+                                                    threaded_ ? worker_readers_[i] : rcu_reader_));
+    }
+    worker_of_strategy_.assign(strategies_.size(), 0);
+    for (std::size_t id = 0; id < strategies_.size(); ++id) {
+        worker_of_strategy_[id] = id % workers_.size();
+        workers_[id % workers_.size()]->strategies.push_back(strategies_[id].get());
+    }
+    
     running_.store(true);
+    workers_running_.store(true);
+    if (threaded_) {
+        for (auto& worker : workers_) {
+            worker->thread = std::thread(&StrategyEngine::workerLoop, this, std::ref(*worker));
+        }
+    }
     processing_thread_ = std::make_unique<std::thread>(&StrategyEngine::processLoop, this);
     
-    LOG_STRATEGY("Strategy engine started");
+    LOG_STRATEGY("Strategy engine started: {} strategies on {} worker threads",
+                strategies_.size(), threaded_ ? workers_.size() : 0);
 }
 
 void StrategyEngine::stop() {
@@ -79,20 +251,83 @@ void StrategyEngine::stop() {
         processing_thread_->join();
     }
     
+    // Workers finish what the engine thread handed them before exiting
+    workers_running_.store(false);
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    
     LOG_STRATEGY("Strategy engine stopped");
 }
 
 StrategyEngine::Statistics StrategyEngine::getStatistics() const {
+    Statistics total{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, MarketState::UNKNOWN};
+    for (const auto& strategy : strategies_) {
+        const Statistics stats = strategy->getStatistics();
+        total.orders_generated += stats.orders_generated;
+        total.orders_suppressed += stats.orders_suppressed;
+        total.orders_throttled += stats.orders_throttled;
+        total.orders_netted += stats.orders_netted;
+        total.order_batches += stats.order_batches;
+        total.orders_risk_rejected += stats.orders_risk_rejected;
+        total.buy_signals += stats.buy_signals;
+        total.sell_signals += stats.sell_signals;
+        total.avg_strategy_latency_ns = std::max(total.avg_strategy_latency_ns, stats.avg_strategy_latency_ns);
+        total.max_strategy_latency_ns = std::max(total.max_strategy_latency_ns, stats.max_strategy_latency_ns);
+    }
+    
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    return statistics_;
+    total.signals_processed = signals_processed_;
+    total.signals_outvoted = signals_outvoted_;
+    total.execution_reports = execution_reports_;
+    total.current_market_state = current_market_state_;
+    return total;
+}
+
+RiskGate::Statistics StrategyEngine::getRiskStatistics() const {
+    RiskGate::Statistics total{};
+    for (const auto& strategy : strategies_) {
+        const RiskGate::Statistics stats = strategy->getRiskStatistics();
+        total.checks += stats.checks;
+        total.rejected_position += stats.rejected_position;
+        total.rejected_notional += stats.rejected_notional;
+        total.rejected_rate += stats.rejected_rate;
+        total.rejected_price_band += stats.rejected_price_band;
+    }
+    return total;
 }
 
 void StrategyEngine::processLoop() {
     LOG_STRATEGY("Strategy processing loop started");
     
     aeron::concurrent::SleepingIdleStrategy idleStrategy(std::chrono::milliseconds(1));
+    Worker& inline_worker = *workers_.front();
+    rcu_.online(rcu_reader_);
     
     while (running_.load()) {
+        // Nothing read through RCU is held across cycles
+        rcu_.quiescent(rcu_reader_);
+        if (symbol_parameters_version_.load(std::memory_order_acquire) != applied_symbol_parameters_version_) {
+            applySymbolParameters();
+        }
+        
+        // Apply execution reports first so signals see the latest positions
+        int reportsRead = 0;
+        if (report_subscription_) {
+            reportsRead = report_subscription_->poll(
+                [this](const aeron::concurrent::AtomicBuffer& buffer, 
+                       util::index_t offset, 
+                       util::index_t length, 
+                       const aeron::Header& header) {
+                    processExecutionReport(buffer, offset, length);
+                }, 
+                report_poll_limit_.limit());
+            
+            report_poll_limit_.onPoll(reportsRead);
+        }
+        
         const int fragmentsRead = input_subscription_->poll(
             [this](const aeron::concurrent::AtomicBuffer& buffer, 
                    util::index_t offset, 
@@ -100,139 +335,183 @@ void StrategyEngine::processLoop() {
                    const aeron::Header& header) {
                 processDCSignal(buffer, offset, length);
             }, 
-            10);  // Poll up to 10 fragments at a time
+            poll_limit_.limit());
+        
+        poll_limit_.onPoll(fragmentsRead);
         
-        idleStrategy.idle(fragmentsRead);
+        // Keep spinning while a batch is open so its window is honoured
+        const bool batches_open = !threaded_ &&
+            flushDueBatches(inline_worker, TimeUtils::getCurrentTimestampNs());
+        idleStrategy.idle(fragmentsRead + reportsRead + (batches_open ? 1 : 0));
     }
     
+    if (!threaded_) {
+        for (StrategyInstance* strategy : inline_worker.strategies) {
+            strategy->flush();
+        }
+    }
+    rcu_.offline(rcu_reader_);
     LOG_STRATEGY("Strategy processing loop ended");
 }
 
+void StrategyEngine::workerLoop(Worker& worker) {
+    aeron::concurrent::SleepingIdleStrategy idleStrategy(std::chrono::milliseconds(1));
+    rcu_.online(worker.rcu_reader);
+    
+    StrategyEvent event;
+    while (workers_running_.load()) {
+        rcu_.quiescent(worker.rcu_reader);
+        
+        int events = 0;
+        while (events < kWorkerDrainLimit && worker.events.tryPop(event)) {
+            run(worker, event);
+            events++;
+        }
+        
+        const bool batches_open = flushDueBatches(worker, TimeUtils::getCurrentTimestampNs());
+        idleStrategy.idle(events + (batches_open ? 1 : 0));
+    }
+    
+    // The engine thread has stopped, so this empties the ring for good
+    while (worker.events.tryPop(event)) {
+        run(worker, event);
+    }
+    for (StrategyInstance* strategy : worker.strategies) {
+        strategy->flush();
+    }
+    rcu_.offline(worker.rcu_reader);
+}
+
 void StrategyEngine::processDCSignal(const aeron::concurrent::AtomicBuffer& buffer,
                                    util::index_t offset,
                                    util::index_t length) {
-    auto start_time = TimeUtils::getCurrentTime();
+    const std::int64_t received_ns = TimeUtils::getCurrentTimestampNs();
     
     if (length < sizeof(DCSignalMessage)) {
         LOG_ERROR_STRATEGY("Invalid DC signal message size: {}", length);
         return;
     }
     
-    // Extract DC signal message
-    DCSignalMessage dc_signal;
-    std::memcpy(&dc_signal, buffer.buffer() + offset, sizeof(DCSignalMessage));
+    // Decode once for every strategy
+    StrategyEvent event;
+    event.kind = StrategyEvent::Kind::SIGNAL;
+    event.strategy = nullptr;
+    event.received_ns = received_ns;
+    std::memcpy(&event.signal, buffer.buffer() + offset, sizeof(DCSignalMessage));
     
-    // Update statistics
     {
         std::lock_guard<std::mutex> lock(stats_mutex_);
-        statistics_.signals_processed++;
+        signals_processed_++;
     }
     
-    // Update market state if HMM is enabled
-    if (hmm_enabled_) {
-        updateMarketState(dc_signal);
-    }
+    event.symbol_id = symbols_.findOrInsert(event.signal.symbol);
+    event.symbol_leverage = symbolLeverage(event.symbol_id);
     
-    // Generate trading signal based on DC event
-    SignalType trading_signal = generateTradingSignal(dc_signal);
+    // Update market state if HMM is enabled and some strategy uses it
+    event.market_state = MarketState::UNKNOWN;
+    if (hmm_enabled_.load(std::memory_order_relaxed) && regime_wanted_.load(std::memory_order_relaxed) &&
+        event.symbol_id != kInvalidSymbolId && regime_models_.loaded()) {
+        event.market_state = event.signal.theta_index == 0 ? updateMarketState(event.signal, event.symbol_id)
+                                                           : symbolMarketState(event.symbol_id);
+    }
     
-    if (trading_signal != SignalType::NONE) {
-        // Create trading order
-        TradingOrder order;
-        order.timestamp = TimeUtils::getCurrentTimestampNs();
-        order.signal = trading_signal;
-        order.price = dc_signal.price;
-        order.quantity = calculateOrderQuantity(trading_signal, dc_signal.price);
-        order.strategy_latency_ns = TimeUtils::getDurationNs(
-            TimeUtils::TimePoint(std::chrono::nanoseconds(dc_signal.timestamp)), 
-            TimeUtils::getCurrentTime());
-        
-        // Copy symbol
-        std::strncpy(order.symbol, dc_signal.symbol, sizeof(order.symbol) - 1);
-        order.symbol[sizeof(order.symbol) - 1] = '\0';
-        
-        // Publish trading order
-        if (publishTradingOrder(order)) {
-            std::lock_guard<std::mutex> lock(stats_mutex_);
-            statistics_.orders_generated++;
-            
-            if (trading_signal == SignalType::BUY) {
-                statistics_.buy_signals++;
-            } else if (trading_signal == SignalType::SELL) {
-                statistics_.sell_signals++;
-            }
+    // Lead-lag statistics follow the symbol's own theta, like the regime
+    event.lead_lag = LeadLagFeatures{};
+    if (lead_lag_enabled_ && event.symbol_id != kInvalidSymbolId) {
+        if (event.signal.theta_index == 0 && event.signal.event_type != DCEventType::NONE) {
+            lead_lag_.onEvent(event.symbol_id, event.signal.timestamp, event.signal.event_type);
         }
-        
-        LOG_DEBUG_STRATEGY("Trading order generated: signal={}, price={}, quantity={}", 
-                          static_cast<int>(trading_signal), order.price, order.quantity);
+        event.lead_lag = lead_lag_.features(event.symbol_id, event.signal.timestamp);
     }
     
-    // Update latency statistics
-    auto latency_ns = TimeUtils::getDurationNs(start_time, TimeUtils::getCurrentTime());
-    updateLatencyStats(latency_ns);
-}
-
-SignalType StrategyEngine::generateTradingSignal(const DCSignalMessage& dc_signal) {
-    // Basic DC strategy: 
-    // - Upward DC event -> Buy signal
-    // - Downward DC event -> Sell signal
-    
-    switch (dc_signal.event_type) {
-        case DCEventType::UPTURN:
-            // Consider time-adjusted return and market state
-            if (dc_signal.time_adjusted_return > 0.0) {
-                // Stronger signal if HMM indicates low volatility
-                if (hmm_enabled_ && current_market_state_ == MarketState::LOW_VOLATILITY) {
-                    LOG_DEBUG_STRATEGY("Strong BUY signal in low volatility state");
-                }
-                return SignalType::BUY;
-            }
-            break;
-            
-        case DCEventType::DOWNTURN:
-            // Consider time-adjusted return and market state
-            if (dc_signal.time_adjusted_return < 0.0) {
-                // Stronger signal if HMM indicates low volatility
-                if (hmm_enabled_ && current_market_state_ == MarketState::LOW_VOLATILITY) {
-                    LOG_DEBUG_STRATEGY("Strong SELL signal in low volatility state");
-                }
-                return SignalType::SELL;
-            }
-            break;
-            
-        default:
-            break;
+    if (ensemble_enabled_ && outvoted(event.signal, event.symbol_id)) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        signals_outvoted_++;
+        return;
     }
     
-    return SignalType::NONE;
+    for (auto& worker : workers_) {
+        dispatch(*worker, event);
+    }
 }
 
-double StrategyEngine::calculateOrderQuantity(SignalType signal, double price) {
-    double base_quantity = 100.0;  // Base quantity
+void StrategyEngine::processExecutionReport(const aeron::concurrent::AtomicBuffer& buffer,
+                                          util::index_t offset,
+                                          util::index_t length) {
+    if (length < sizeof(ExecutionReport)) {
+        LOG_ERROR_STRATEGY("Invalid execution report size: {}", length);
+        return;
+    }
+    
+    StrategyEvent event;
+    event.kind = StrategyEvent::Kind::REPORT;
+    event.market_state = MarketState::UNKNOWN;
+    event.symbol_leverage = 1.0;
+    event.lead_lag = LeadLagFeatures{};
+    event.received_ns = 0;
+    std::memcpy(&event.report, buffer.buffer() + offset, sizeof(ExecutionReport));
     
-    // Apply leverage factor
-    double quantity = base_quantity * leverage_factor_;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        execution_reports_++;
+    }
     
-    // Apply volatility-adjusted leverage if HMM is enabled
-    if (hmm_enabled_) {
-        double volatility_adjustment = getVolatilityAdjustedLeverage();
-        quantity *= volatility_adjustment;
+    // Only the strategy that sent the order sees its executions
+    if (event.report.strategy_id >= strategies_.size()) {
+        LOG_DEBUG_STRATEGY("Execution report for unknown strategy {}", event.report.strategy_id);
+        return;
     }
     
-    // Simple position sizing based on price (higher price = smaller quantity)
-    if (price > 0.0) {
-        quantity = std::min(quantity, 10000.0 / price);  // Max $10,000 per trade
+    event.symbol_id = symbols_.findOrInsert(event.report.symbol);
+    if (event.symbol_id == kInvalidSymbolId) {
+        return;
+    }
+    event.strategy = strategies_[event.report.strategy_id].get();
+    dispatch(*workers_[worker_of_strategy_[event.report.strategy_id]], event);
+}
+
+void StrategyEngine::dispatch(Worker& worker, const StrategyEvent& event) {
+    if (!threaded_) {
+        run(worker, event);
+        return;
+    }
+    
+    // A full ring holds the engine thread back rather than dropping the event
+    while (!worker.events.tryPush(event)) {
+        if (!running_.load()) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void StrategyEngine::run(Worker& worker, const StrategyEvent& event) {
+    if (event.kind == StrategyEvent::Kind::REPORT) {
+        event.strategy->onExecutionReport(event.report, event.symbol_id);
+        return;
     }
     
-    return std::max(1.0, quantity);  // Minimum 1 unit
+    for (StrategyInstance* strategy : worker.strategies) {
+        if (strategy->tradesSignal(event.signal)) {
+            strategy->onSignal(event.signal, event.symbol_id, event.market_state, event.symbol_leverage,
+                               event.received_ns, event.lead_lag);
+        }
+    }
+}
+
+bool StrategyEngine::flushDueBatches(Worker& worker, std::int64_t now_ns) {
+    bool open = false;
+    for (StrategyInstance* strategy : worker.strategies) {
+        open = strategy->flushDue(now_ns) || open;
+    }
+    return open;
 }
 
-bool StrategyEngine::publishTradingOrder(const TradingOrder& order) {
-    // Publish the order
-    aeron::concurrent::AtomicBuffer buffer(reinterpret_cast<const std::uint8_t*>(&order), 
-                                          sizeof(order));
+bool StrategyEngine::publish(const std::uint8_t* data, std::size_t length) {
+    // Publication::offer may be called from several worker threads at once
+    aeron::concurrent::AtomicBuffer buffer(const_cast<std::uint8_t*>(data), length);
     
-    std::int64_t result = output_publication_->offer(buffer, 0, sizeof(order));
+    std::int64_t result = output_publication_->offer(buffer, 0, length);
     
     if (result > 0) {
         LOG_DEBUG_STRATEGY("Trading order published successfully");
@@ -251,61 +530,93 @@ bool StrategyEngine::publishTradingOrder(const TradingOrder& order) {
     }
 }
 
-void StrategyEngine::updateMarketState(const DCSignalMessage& dc_signal) {
-    // Simple HMM-like state detection based on TMV and duration
-    // This is a simplified implementation - real HMM would use more sophisticated algorithms
-    
-    double volatility_indicator = std::abs(dc_signal.tmv_ext) / (dc_signal.duration / 1e9); // TMV per second
-    
-    // Threshold-based state classification
-    const double low_volatility_threshold = 0.1;
-    const double high_volatility_threshold = 0.5;
-    
-    MarketState new_state = current_market_state_;
+bool StrategyEngine::loadRegimeModel(const std::string& path) {
+    std::string error;
+    if (!regime_models_.load(path, error)) {
+        LOG_ERROR_STRATEGY("Failed to load regime models: {}", error);
+        return false;
+    }
     
-    if (volatility_indicator < low_volatility_threshold) {
-        new_state = MarketState::LOW_VOLATILITY;
-    } else if (volatility_indicator > high_volatility_threshold) {
-        new_state = MarketState::HIGH_VOLATILITY;
+    LOG_STRATEGY("Loaded {}-state regime models from {}: default plus {} symbols",
+                regime_models_.states(), path, regime_models_.symbolModels());
+    return true;
+}
+
+void StrategyEngine::applySymbolParameters() {
+    // Read the version first: a table published after this pass bumps it again
+    applied_symbol_parameters_version_ = symbol_parameters_version_.load(std::memory_order_acquire);
+    const SymbolParameterTable& parameters = *symbol_parameters_.read();
+    for (SymbolId id = 0; id < symbol_leverage_.size(); ++id) {
+        symbol_leverage_[id] = parameters.lookup(symbols_.name(id).c_str()).leverage_factor;
+    }
+}
+
+double StrategyEngine::symbolLeverage(SymbolId symbol_id) {
+    if (symbol_id == kInvalidSymbolId) {
+        return 1.0;
     }
     
-    if (new_state != current_market_state_) {
-        LOG_STRATEGY("Market state changed from {} to {}", 
-                    static_cast<int>(current_market_state_), 
-                    static_cast<int>(new_state));
-        current_market_state_ = new_state;
-        
-        std::lock_guard<std::mutex> lock(stats_mutex_);
-        statistics_.current_market_state = new_state;
+    // Symbols are resolved on first sight, including ones first seen in reports
+    while (symbol_leverage_.size() <= symbol_id) {
+        const std::string name = symbols_.name(static_cast<SymbolId>(symbol_leverage_.size()));
+        symbol_leverage_.push_back(symbol_parameters_.read()->lookup(name.c_str()).leverage_factor);
     }
+    return symbol_leverage_[symbol_id];
 }
 
-double StrategyEngine::getVolatilityAdjustedLeverage() const {
-    switch (current_market_state_) {
-        case MarketState::LOW_VOLATILITY:
-            return 1.5;  // Increase leverage in low volatility
-        case MarketState::HIGH_VOLATILITY:
-            return 0.5;  // Reduce leverage in high volatility
-        default:
-            return 1.0;  // Default leverage
+bool StrategyEngine::outvoted(const DCSignalMessage& dc_signal, SymbolId symbol_id) {
+    if (symbol_id == kInvalidSymbolId || !theta_ensemble_.votesOn(dc_signal.theta_index) ||
+        (dc_signal.event_type != DCEventType::UPTURN && dc_signal.event_type != DCEventType::DOWNTURN)) {
+        return false;
     }
+    
+    // A symbol's first vote starts from no votes on any theta
+    if (symbol_id >= symbol_votes_.size()) {
+        symbol_votes_.resize(symbol_id + 1, ThetaEnsemble::kNoVotes);
+    }
+    return !theta_ensemble_.vote(symbol_votes_[symbol_id], dc_signal.theta_index, dc_signal.event_type);
 }
 
-void StrategyEngine::updateLatencyStats(std::int64_t latency_ns) {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
+MarketState StrategyEngine::symbolMarketState(SymbolId symbol_id) const {
+    return symbol_id < symbol_regimes_.size() ? symbol_regimes_[symbol_id].market_state : MarketState::UNKNOWN;
+}
+
+MarketState StrategyEngine::updateMarketState(const DCSignalMessage& dc_signal, SymbolId symbol_id) {
+    // A symbol's first signal gets its regime model below
+    if (symbol_id >= symbol_regimes_.size()) {
+        symbol_regimes_.resize(symbol_id + 1, SymbolRegime{nullptr, RegimeBelief{}, MarketState::UNKNOWN});
+    }
+    SymbolRegime& state = symbol_regimes_[symbol_id];
     
-    // Update running average
-    if (statistics_.signals_processed == 1) {
-        statistics_.avg_strategy_latency_ns = latency_ns;
-    } else {
-        statistics_.avg_strategy_latency_ns = 
-            (statistics_.avg_strategy_latency_ns * 0.9) + (latency_ns * 0.1);
+    if (state.regime_model == nullptr) {
+        state.regime_model = &regime_models_.lookup(dc_signal.symbol);
+        state.regime_model->reset(state.regime_belief);
     }
     
-    // Update max latency
-    if (latency_ns > statistics_.max_strategy_latency_ns) {
-        statistics_.max_strategy_latency_ns = latency_ns;
+    // One forward-filter step of the symbol's regime HMM; states are ordered
+    // from the calmest regime to the most volatile
+    const std::size_t regime = state.regime_model->update(
+        state.regime_belief, regimeFeatures(dc_signal.tmv_ext, dc_signal.duration));
+    
+    MarketState new_state = MarketState::NORMAL_VOLATILITY;
+    if (regime == 0) {
+        new_state = MarketState::LOW_VOLATILITY;
+    } else if (regime + 1 == state.regime_model->states()) {
+        new_state = MarketState::HIGH_VOLATILITY;
+    }
+    
+    if (new_state != state.market_state) {
+        LOG_DEBUG_STRATEGY("Market state of {} changed from {} to {}", dc_signal.symbol,
+                          static_cast<int>(state.market_state),
+                          static_cast<int>(new_state));
+        state.market_state = new_state;
+    }
+    
+    if (new_state != current_market_state_) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        current_market_state_ = new_state;
     }
+    return new_state;
 }
 
-} // namespace trading 
\ No newline at end of file
+} // namespace trading
@@ -0,0 +1,342 @@
+#include "strategy/StrategyInstance.h"
+#include <cmath>
+#include <cstring>
+
+#include "common/Logger.h"
+#include "common/TimeUtils.h"
+
+namespace trading {
+
+namespace {
+bool acceptsTheta(const std::vector<double>& thetas, double theta) {
+    if (thetas.empty()) {
+        return true;
+    }
+    for (double accepted : thetas) {
+        if (std::fabs(theta - accepted) <= accepted * 1e-9) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+StrategyInstance::StrategyInstance(std::uint16_t id, const StrategyVariant& strategy,
+                                   const StrategyInstanceSettings& settings, RcuDomain& rcu,
+                                   OrderPublisher& publisher, std::size_t max_symbols)
+    : id_(id)
+    , name_(settings.name)
+    , parameters_(rcu, std::make_unique<StrategyParameters>(StrategyParameters{
+          strategy, settings.leverage_factor, settings.enable_hmm, settings.thetas, settings.trade_synthetics}))
+    , publisher_(publisher)
+    , reports_(false)
+    , own_fills_(false)
+    , working_order_timeout_ns_(1000000000)
+    , symbol_throttle_{0, 0}
+    , global_throttle_limit_{0, 0}
+    , order_batcher_(kMaxOrdersPerBatch, max_symbols)
+    , batching_enabled_(false)
+    , batch_window_ns_(0)
+    , batch_opened_ns_(0)
+    , risk_gate_(rcu, RiskLimits{0.0, 0.0, 0, 0.0}, max_symbols)
+    , risk_checks_enabled_(true)
+    , statistics_{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, MarketState::UNKNOWN}
+    , orders_suppressed_(0)
+    , orders_throttled_(0)
+{
+    symbol_states_.reserve(max_symbols);
+}
+
+bool StrategyInstance::tradesTheta(double theta) const {
+    return acceptsTheta(parameters_.read()->thetas, theta);
+}
+
+bool StrategyInstance::tradesSignal(const DCSignalMessage& dc_signal) const {
+    const StrategyParameters& parameters = *parameters_.read();
+    return (dc_signal.synthetic == 0 || parameters.trade_synthetics) &&
+           acceptsTheta(parameters.thetas, dc_signal.theta);
+}
+
+bool StrategyInstance::updateParameters(const StrategyInstanceSettings& settings) {
+    StrategyVariant strategy;
+    if (settings.name != name_ || !makeStrategy(settings.name, strategy, settings.rules)) {
+        return false;
+    }
+    
+    parameters_.update(std::make_unique<StrategyParameters>(StrategyParameters{
+        strategy, settings.leverage_factor, settings.enable_hmm, settings.thetas, settings.trade_synthetics}));
+    
+    LOG_STRATEGY("Strategy {} ({}) updated: leverage {}, HMM {}, {} thetas", id_, name_,
+                settings.leverage_factor, settings.enable_hmm ? "on" : "off",
+                settings.thetas.empty() ? std::string("all") : std::to_string(settings.thetas.size()));
+    return true;
+}
+
+StrategyStatistics StrategyInstance::getStatistics() const {
+    StrategyStatistics statistics;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics = statistics_;
+    }
+    statistics.orders_suppressed = orders_suppressed_.load(std::memory_order_relaxed);
+    statistics.orders_throttled = orders_throttled_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+RiskGate::Statistics StrategyInstance::getRiskStatistics() const {
+    return risk_gate_.getStatistics();
+}
+
+void StrategyInstance::onSignal(const DCSignalMessage& dc_signal, SymbolId symbol_id, MarketState market_state,
+                                double symbol_leverage, std::int64_t received_ns, const LeadLagFeatures& lead_lag) {
+    // One version of the parameters for the whole signal
+    const StrategyParameters& parameters = *parameters_.read();
+    const MarketState regime = parameters.use_regime ? market_state : MarketState::UNKNOWN;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics_.signals_processed++;
+        statistics_.current_market_state = regime;
+    }
+
+    SymbolState* state = symbolState(symbol_id);
+    const std::int64_t now_ns = TimeUtils::getCurrentTimestampNs();
+
+    // Generate trading signal based on DC event; the visit resolves to the
+    // selected strategy's inlined code
+    const StrategyContext context{regime, parameters.leverage_factor * symbol_leverage,
+                                  state != nullptr ? state->position + state->batched_quantity : 0.0, lead_lag};
+    double quantity = 0.0;
+    SignalType trading_signal = std::visit([&](const auto& strategy) {
+        const SignalType signal = strategy.generateSignal(dc_signal, context);
+        if (signal != SignalType::NONE) {
+            quantity = strategy.orderQuantity(dc_signal, context);
+        }
+        return signal;
+    }, parameters.strategy);
+
+    // Trade only the difference to the target position; repeated signals that
+    // leave the target unchanged are suppressed
+    if (trading_signal != SignalType::NONE) {
+        if (state != nullptr && !sizeAgainstPosition(*state, trading_signal, quantity, now_ns)) {
+            trading_signal = SignalType::NONE;
+            orders_suppressed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Throttle a noisy symbol before it can use up the overall rate; a token
+    // is taken only when both buckets have one, so a globally throttled
+    // order does not spend the symbol's burst
+    if (trading_signal != SignalType::NONE && state != nullptr) {
+        if (state->throttle.available(symbol_throttle_, now_ns) &&
+            global_throttle_.available(global_throttle_limit_, now_ns)) {
+            state->throttle.consume(symbol_throttle_);
+            global_throttle_.consume(global_throttle_limit_);
+        } else {
+            trading_signal = SignalType::NONE;
+            orders_throttled_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Pre-trade checks; the band is measured from the last signal or fill price
+    if (risk_checks_enabled_ && symbol_id != kInvalidSymbolId) {
+        if (trading_signal != SignalType::NONE) {
+            const double signed_quantity = trading_signal == SignalType::BUY ? quantity : -quantity;
+            RiskCheckResult risk = risk_gate_.check(symbol_id, dc_signal.symbol, signed_quantity,
+                                                    dc_signal.price, now_ns);
+            if (risk != RiskCheckResult::ACCEPTED) {
+                {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    statistics_.orders_risk_rejected++;
+                }
+                LOG_DEBUG_STRATEGY("Order of {} rejected by risk check: {}", name_, riskCheckResultName(risk));
+                trading_signal = SignalType::NONE;
+            }
+        }
+        risk_gate_.onReferencePrice(symbol_id, dc_signal.price);
+    }
+
+    if (trading_signal != SignalType::NONE) {
+        // Create trading order
+        TradingOrder order;
+        order.timestamp = TimeUtils::getCurrentTimestampNs();
+        order.signal = trading_signal;
+        order.strategy_id = id_;
+        order.price = dc_signal.price;
+        order.quantity = quantity;
+
+        // Hop timestamps share this host's clock; dc_signal.timestamp is the feed's
+        order.hops = dc_signal.hops;
+        order.hops.order_created_ns = order.timestamp;
+        order.strategy_latency_ns = (dc_signal.hops.dc_detected_ns != 0) ?
+            order.hops.order_created_ns - dc_signal.hops.dc_detected_ns : 0;
+
+        // Copy symbol
+        std::strncpy(order.symbol, dc_signal.symbol, sizeof(order.symbol) - 1);
+        order.symbol[sizeof(order.symbol) - 1] = '\0';
+
+        if (batching_enabled_ && state != nullptr) {
+            // Net with other orders for this symbol until the batch is flushed
+            if (!order_batcher_.add(symbol_id, order)) {
+                flush();
+                order_batcher_.add(symbol_id, order);
+            }
+            if (order_batcher_.pending() == 1) {
+                batch_opened_ns_ = now_ns;
+            }
+            state->batched_quantity += trading_signal == SignalType::BUY ? order.quantity : -order.quantity;
+        } else if (publisher_.publish(reinterpret_cast<const std::uint8_t*>(&order), sizeof(order))) {
+            onOrderPublished(state, order);
+        }
+
+        LOG_DEBUG_STRATEGY("Trading order generated by {}: signal={}, price={}, quantity={}",
+                          name_, static_cast<int>(trading_signal), order.price, order.quantity);
+    }
+
+    updateLatencyStats(TimeUtils::getCurrentTimestampNs() - received_ns);
+}
+
+void StrategyInstance::onExecutionReport(const ExecutionReport& report, SymbolId symbol_id) {
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics_.execution_reports++;
+    }
+
+    SymbolState* state = symbolState(symbol_id);
+    if (state == nullptr) {
+        return;
+    }
+
+    if (!own_fills_) {
+        state->position = report.position;
+    } else if (report.status == ExecutionStatus::FILLED || report.status == ExecutionStatus::PARTIALLY_FILLED) {
+        state->position += report.signal == SignalType::BUY ? report.quantity : -report.quantity;
+    }
+    risk_gate_.onPosition(symbol_id, state->position);
+    if ((report.status == ExecutionStatus::FILLED || report.status == ExecutionStatus::PARTIALLY_FILLED) &&
+        report.price > 0.0) {
+        risk_gate_.onReferencePrice(symbol_id, report.price);
+    }
+
+    const bool final_report = report.status == ExecutionStatus::FILLED ||
+                              report.status == ExecutionStatus::REJECTED ||
+                              report.status == ExecutionStatus::CANCELLED;
+    if (final_report && state->working_orders > 0) {
+        state->working_orders--;
+    }
+
+    LOG_DEBUG_STRATEGY("Execution report for {}: status={}, quantity={}, position={}",
+                      name_, static_cast<int>(report.status), report.quantity, state->position);
+}
+
+bool StrategyInstance::sizeAgainstPosition(SymbolState& state, SignalType signal, double& quantity,
+                                           std::int64_t now_ns) {
+    if (state.working_orders > 0) {
+        if (now_ns - state.last_order_ns < working_order_timeout_ns_) {
+            return false;  // Wait for the working order to finish
+        }
+        state.working_orders = 0;  // Its final report is overdue
+    }
+
+    // The signal's target is a position of +/- quantity
+    const double target = signal == SignalType::BUY ? quantity : -quantity;
+    const double difference = target - (state.position + state.batched_quantity);
+    if (signal == SignalType::BUY ? difference < 1.0 : difference > -1.0) {
+        return false;  // Already at or beyond the target
+    }
+
+    quantity = std::fabs(difference);
+    return true;
+}
+
+StrategyInstance::SymbolState* StrategyInstance::symbolState(SymbolId symbol_id) {
+    if (symbol_id == kInvalidSymbolId || symbol_id >= symbol_states_.capacity()) {
+        return nullptr;
+    }
+
+    // Bounded by the capacity reserved in the constructor, so growing never reallocates
+    if (symbol_id >= symbol_states_.size()) {
+        symbol_states_.resize(symbol_id + 1, SymbolState{0.0, 0.0, 0, 0, TokenBucket()});
+    }
+    return &symbol_states_[symbol_id];
+}
+
+void StrategyInstance::onOrderPublished(SymbolState* state, const TradingOrder& order) {
+    if (state != nullptr && reports_) {
+        state->working_orders++;
+        state->last_order_ns = order.timestamp;
+    } else if (state != nullptr) {
+        // No reports will come: assume the order fills
+        state->position += order.signal == SignalType::BUY ? order.quantity : -order.quantity;
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    statistics_.orders_generated++;
+
+    if (order.signal == SignalType::BUY) {
+        statistics_.buy_signals++;
+    } else if (order.signal == SignalType::SELL) {
+        statistics_.sell_signals++;
+    }
+}
+
+bool StrategyInstance::flushDue(std::int64_t now_ns) {
+    // A zero window flushes once per poll batch
+    if (!order_batcher_.empty() &&
+        (batch_window_ns_ == 0 || now_ns - batch_opened_ns_ >= batch_window_ns_)) {
+        flush();
+    }
+    return !order_batcher_.empty();
+}
+
+void StrategyInstance::flush() {
+    if (order_batcher_.empty()) {
+        return;
+    }
+
+    OrderBatcher::Batch batch = order_batcher_.build();
+
+    // Queued quantities are settled either way; a lost batch is not retried
+    for (std::uint32_t i = 0; i < batch.count; ++i) {
+        symbol_states_[batch.symbols[i]].batched_quantity = 0.0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        statistics_.orders_netted += batch.netted;
+    }
+
+    if (batch.count == 0) {
+        return;
+    }
+
+    if (!publisher_.publish(batch.data, batch.length)) {
+        LOG_ERROR_STRATEGY("Failed to publish order batch of {} for {}", batch.count, name_);
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < batch.count; ++i) {
+        onOrderPublished(&symbol_states_[batch.symbols[i]], batch.orders[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    statistics_.order_batches++;
+}
+
+void StrategyInstance::updateLatencyStats(std::int64_t latency_ns) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    // Update running average
+    if (statistics_.signals_processed == 1) {
+        statistics_.avg_strategy_latency_ns = latency_ns;
+    } else {
+        statistics_.avg_strategy_latency_ns =
+            (statistics_.avg_strategy_latency_ns * 0.9) + (latency_ns * 0.1);
+    }
+
+    // Update max latency
+    if (latency_ns > statistics_.max_strategy_latency_ns) {
+        statistics_.max_strategy_latency_ns = latency_ns;
+    }
+}
+
+} // namespace trading
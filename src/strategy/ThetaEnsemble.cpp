@@ -0,0 +1,56 @@
+#include "strategy/ThetaEnsemble.h"
+#include <algorithm>
+
+namespace trading {
+
+ThetaEnsemble::ThetaEnsemble()
+    : weight_planes_{}
+    , planes_(0)
+    , thetas_(0)
+    , quorum_(1)
+    , total_weight_(0)
+{
+}
+
+bool ThetaEnsemble::configure(const std::vector<std::uint32_t>& weights, std::uint32_t quorum, std::string& error) {
+    if (weights.empty() || weights.size() > kMaxThetas) {
+        error = "1 to " + std::to_string(kMaxThetas) + " theta weights required";
+        return false;
+    }
+
+    std::array<std::uint64_t, 8> planes{};
+    std::size_t used_planes = 0;
+    std::uint32_t total = 0;
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        if (weights[i] > kMaxWeight) {
+            error = "weight of theta " + std::to_string(i) + " must be 0 to " + std::to_string(kMaxWeight);
+            return false;
+        }
+        for (std::size_t plane = 0; plane < planes.size(); ++plane) {
+            if (weights[i] & (1u << plane)) {
+                planes[plane] |= std::uint64_t(1) << i;
+                used_planes = std::max(used_planes, plane + 1);
+            }
+        }
+        total += weights[i];
+    }
+
+    const std::uint32_t majority = total / 2 + 1;
+    if (quorum == 0) {
+        quorum = majority;
+    }
+    if (quorum < majority || quorum > total) {
+        error = "quorum must be from " + std::to_string(majority) + " to " + std::to_string(total) +
+                " of the total weight " + std::to_string(total);
+        return false;
+    }
+
+    weight_planes_ = planes;
+    planes_ = used_planes;
+    thetas_ = weights.size();
+    quorum_ = quorum;
+    total_weight_ = total;
+    return true;
+}
+
+} // namespace trading
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+/**
+ * @brief Check-and-count harness shared by the standalone test programs
+ *
+ * check() prints one line per condition; testSummary() prints the verdict
+ * and gives main() its exit code.
+ */
+inline int failures = 0;
+
+inline void check(bool condition, const std::string& description) {
+    std::cout << (condition ? "[PASS] " : "[FAIL] ") << description << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+inline int testSummary() {
+    std::cout << "\n=== " << (failures == 0 ? "All tests passed" : "Tests FAILED") << " ===" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+#ifdef TEST_HARNESS_COUNT_ALLOCATIONS
+/**
+ * @brief Heap allocations made through operator new so far
+ *
+ * Defined, together with the replacement operator new and delete below, by
+ * test programs that define TEST_HARNESS_COUNT_ALLOCATIONS before including
+ * this header. Each test is a single translation unit, so the replacements
+ * are defined exactly once.
+ */
+inline std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#endif
@@ -0,0 +1,186 @@
+/**
+ * Adaptive Poll Limit Benchmark
+ * Sweeps burst sizes and compares fixed fragment limits against the
+ * load-adaptive limit. Each duty cycle polls a bulk stream (market data
+ * bursts) and then a priority stream (one message per burst) and pays a
+ * fixed per-poll overhead, so small limits cost throughput on the bulk
+ * stream and large limits cost latency on the priority stream.
+ *
+ * Build: g++ -std=c++17 -O3 -Iinclude test/adaptive_poll_benchmark.cpp src/common/DCIndicator.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <algorithm>
+#include <string>
+
+#include "common/AdaptivePollLimit.h"
+#include "common/DCIndicator.h"
+
+using namespace trading;
+
+namespace {
+
+constexpr std::int64_t kPollOverheadNs = 300;  // Poll call + duty cycle housekeeping
+constexpr int kRounds = 200;
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void spinFor(std::int64_t ns) {
+    const std::int64_t target = nowNs() + ns;
+    while (nowNs() < target) {
+    }
+}
+
+/**
+ * In-memory stand-in for an Aeron subscription
+ */
+class BenchSubscription {
+public:
+    void offer(std::int64_t enqueue_ns, double price) {
+        queue_.push_back({enqueue_ns, price});
+    }
+
+    template <typename Handler>
+    int poll(Handler&& handler, int limit) {
+        spinFor(kPollOverheadNs);
+        int processed = 0;
+        while (!queue_.empty() && processed < limit) {
+            handler(queue_.front().first, queue_.front().second);
+            queue_.pop_front();
+            ++processed;
+        }
+        return processed;
+    }
+
+    bool empty() const { return queue_.empty(); }
+
+private:
+    std::deque<std::pair<std::int64_t, double>> queue_;
+};
+
+struct Result {
+    double bulk_p50_ns;
+    double bulk_p99_ns;
+    double priority_p99_ns;
+    double messages_per_second;
+    double avg_fragments_per_poll;
+    int max_limit_used;
+};
+
+double percentile(std::vector<std::int64_t>& samples, double pct) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::size_t index = static_cast<std::size_t>(pct * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return static_cast<double>(samples[index]);
+}
+
+Result runScenario(int burst_size, int min_limit, int max_limit) {
+    BenchSubscription bulk;
+    BenchSubscription priority;
+    AdaptivePollLimit bulk_limit(min_limit, max_limit);
+    DCIndicator indicator(0.004);
+
+    std::vector<std::int64_t> bulk_latency;
+    std::vector<std::int64_t> priority_latency;
+    bulk_latency.reserve(static_cast<std::size_t>(burst_size) * kRounds);
+    priority_latency.reserve(kRounds);
+
+    std::int64_t busy_ns = 0;
+    double price = 100.0;
+    std::int64_t tick = 0;
+
+    for (int round = 0; round < kRounds; ++round) {
+        const std::int64_t burst_start = nowNs();
+        for (int i = 0; i < burst_size; ++i) {
+            price *= (i % 7 < 4) ? 1.0007 : 0.9993;
+            bulk.offer(burst_start, price);
+        }
+        priority.offer(burst_start, price);
+
+        while (!bulk.empty() || !priority.empty()) {
+            const int fragments = bulk.poll([&](std::int64_t enqueue_ns, double p) {
+                indicator.processDataPoint(MarketDataPoint(++tick, p));
+                bulk_latency.push_back(nowNs() - enqueue_ns);
+            }, bulk_limit.limit());
+            bulk_limit.onPoll(fragments);
+
+            priority.poll([&](std::int64_t enqueue_ns, double) {
+                priority_latency.push_back(nowNs() - enqueue_ns);
+            }, AdaptivePollLimit::kDefaultFragmentLimit);
+        }
+        busy_ns += nowNs() - burst_start;
+
+        // Idle duty cycles between bursts let the adaptive limit settle back down
+        for (int i = 0; i < 8; ++i) {
+            bulk_limit.onPoll(bulk.poll([](std::int64_t, double) {}, bulk_limit.limit()));
+        }
+    }
+
+    auto stats = bulk_limit.getStatistics();
+    Result result;
+    result.bulk_p50_ns = percentile(bulk_latency, 0.50);
+    result.bulk_p99_ns = percentile(bulk_latency, 0.99);
+    result.priority_p99_ns = percentile(priority_latency, 0.99);
+    result.messages_per_second = busy_ns > 0 ?
+        static_cast<double>(burst_size) * kRounds * 1e9 / busy_ns : 0.0;
+    result.avg_fragments_per_poll = stats.polls > 0 ?
+        static_cast<double>(stats.fragments) / stats.polls : 0.0;
+    result.max_limit_used = stats.max_limit_used;
+    return result;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Adaptive Poll Limit Benchmark ===" << std::endl;
+    std::cout << "Per-poll overhead: " << kPollOverheadNs << " ns, rounds per burst size: "
+              << kRounds << std::endl << std::endl;
+
+    struct Mode {
+        std::string name;
+        int min_limit;
+        int max_limit;
+    };
+    const std::vector<Mode> modes = {
+        {"fixed-10", 10, 10},
+        {"fixed-256", 256, 256},
+        {"adaptive-8..256", 8, 256},
+    };
+    const std::vector<int> burst_sizes = {1, 4, 16, 64, 256, 1024, 4096};
+
+    std::cout << std::left << std::setw(8) << "burst"
+              << std::setw(18) << "mode"
+              << std::right << std::setw(14) << "bulk p50 ns"
+              << std::setw(14) << "bulk p99 ns"
+              << std::setw(14) << "prio p99 ns"
+              << std::setw(14) << "msgs/s"
+              << std::setw(12) << "frag/poll"
+              << std::setw(10) << "max lim" << std::endl;
+
+    for (int burst : burst_sizes) {
+        for (const auto& mode : modes) {
+            Result r = runScenario(burst, mode.min_limit, mode.max_limit);
+            std::cout << std::left << std::setw(8) << burst
+                      << std::setw(18) << mode.name
+                      << std::right << std::fixed << std::setprecision(0)
+                      << std::setw(14) << r.bulk_p50_ns
+                      << std::setw(14) << r.bulk_p99_ns
+                      << std::setw(14) << r.priority_p99_ns
+                      << std::setw(14) << r.messages_per_second
+                      << std::setprecision(2)
+                      << std::setw(12) << r.avg_fragments_per_poll
+                      << std::setw(10) << r.max_limit_used << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,253 @@
+/**
+ * Adaptive Theta Test
+ * Replays a quiet, a volatile and a quiet session through a fixed and a
+ * volatility-adaptive DC indicator: the fixed threshold's event rate must
+ * swing with volatility while the adaptive one's stays near its target,
+ * and so must the orders a strategy sends downstream. Also checks the
+ * warm-up, the bounds, that the default mode is unchanged, and the cost.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/adaptive_theta_test.cpp src/common/DCIndicator.cpp src/strategy/StrategyInstance.cpp src/strategy/OrderBatcher.cpp src/strategy/RiskGate.cpp src/strategy/RuleTable.cpp src/common/TimeUtils.cpp src/common/Logger.cpp -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/DCIndicator.h"
+#include "strategy/StrategyInstance.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+constexpr std::int64_t kSecondNs = 1000000000;
+constexpr std::int64_t kSessionNs = 3600 * kSecondNs;
+
+const AdaptiveThetaSettings kAdaptive{true, 60.0, 500, 0.25, 4.0};
+
+class CountingPublisher : public OrderPublisher {
+public:
+    bool publish(const std::uint8_t*, std::size_t) override {
+        orders++;
+        return true;
+    }
+
+    std::uint64_t orders = 0;
+};
+
+struct Session {
+    double volatility;          // Per square-root second
+    std::int64_t tick_interval_ns;
+};
+
+// Geometric random walk; busier sessions also tick faster
+std::vector<MarketDataPoint> replay(const std::vector<Session>& sessions, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::vector<MarketDataPoint> ticks;
+    double price = 100.0;
+    std::int64_t now = 0;
+    for (const Session& session : sessions) {
+        const double step = session.volatility * std::sqrt(session.tick_interval_ns / 1e9);
+        for (std::int64_t end = now + kSessionNs; now < end; now += session.tick_interval_ns) {
+            price *= std::exp(step * normal(rng));
+            ticks.emplace_back(now, price);
+        }
+    }
+    return ticks;
+}
+
+struct SessionLoad {
+    std::uint64_t events;
+    std::uint64_t peak_events_per_minute;
+    std::uint64_t orders;
+};
+
+// Events per session as the strategy stream would carry them, and the
+// orders a trend strategy sends on from them
+std::vector<SessionLoad> run(DCIndicator& indicator, const std::vector<MarketDataPoint>& ticks, std::size_t sessions) {
+    RcuDomain rcu;
+    RcuDomain::ReaderId reader = rcu.registerReader();
+    CountingPublisher publisher;
+    StrategyVariant strategy;
+    makeStrategy(DCTrendStrategy::kName, strategy);
+    const StrategyInstanceSettings settings{DCTrendStrategy::kName, 1.0, false, {}, nullptr, false};
+    StrategyInstance instance(0, strategy, settings, rcu, publisher, 4);
+    instance.setReportMode(false, false);
+    instance.enableRiskChecks(false);
+    rcu.online(reader);
+
+    std::vector<SessionLoad> load(sessions, SessionLoad{0, 0, 0});
+    std::vector<std::uint64_t> per_minute(sessions * 60, 0);
+    for (const MarketDataPoint& tick : ticks) {
+        const DCEvent event = indicator.processDataPoint(tick);
+        if (event.type == DCEventType::NONE) {
+            continue;
+        }
+        const std::size_t session = std::min<std::size_t>(tick.timestamp / kSessionNs, sessions - 1);
+        load[session].events++;
+        per_minute[std::min<std::size_t>(tick.timestamp / (60 * kSecondNs), per_minute.size() - 1)]++;
+
+        DCSignalMessage message{};
+        message.event_type = event.type;
+        message.time_adjusted_return = event.type == DCEventType::UPTURN ? event.time_adjusted_return
+                                                                         : -event.time_adjusted_return;
+        message.price = event.price;
+        const std::uint64_t before = publisher.orders;
+        instance.onSignal(message, 0, MarketState::UNKNOWN, 1.0, 0);
+        load[session].orders += publisher.orders - before;
+    }
+    rcu.offline(reader);
+
+    for (std::size_t minute = 0; minute < per_minute.size(); ++minute) {
+        SessionLoad& session = load[minute / 60];
+        session.peak_events_per_minute = std::max(session.peak_events_per_minute, per_minute[minute]);
+    }
+    return load;
+}
+
+void print(const char* name, const std::vector<SessionLoad>& load) {
+    std::cout << "  " << std::left << std::setw(9) << name << std::right;
+    for (const SessionLoad& session : load) {
+        std::cout << std::setw(6) << session.events << " events (peak " << std::setw(3)
+                  << session.peak_events_per_minute << "/min, " << std::setw(5) << session.orders << " orders)";
+    }
+    std::cout << std::endl;
+}
+
+void testReplay() {
+    std::cout << "\n1. Quiet, volatile, quiet replay" << std::endl;
+    // Three times the volatility and twice the tick rate in the middle hour
+    const std::vector<Session> sessions = {{0.0002, 100000000}, {0.0006, 50000000}, {0.0002, 100000000}};
+    const std::vector<MarketDataPoint> ticks = replay(sessions, 47);
+    std::cout << ticks.size() << " ticks" << std::endl;
+
+    DCIndicator fixed(0.004);
+    DCIndicator adaptive(0.004);
+    adaptive.setAdaptiveTheta(kAdaptive);
+    const std::vector<SessionLoad> fixed_load = run(fixed, ticks, sessions.size());
+    const std::vector<SessionLoad> adaptive_load = run(adaptive, ticks, sessions.size());
+    print("fixed", fixed_load);
+    print("adaptive", adaptive_load);
+
+    const double fixed_swing = static_cast<double>(fixed_load[1].events) / std::max<std::uint64_t>(fixed_load[0].events, 1);
+    const double adaptive_swing = static_cast<double>(adaptive_load[1].events) /
+                                  std::max<std::uint64_t>(adaptive_load[0].events, 1);
+    std::cout << std::fixed << std::setprecision(1) << "volatile/quiet event ratio: fixed " << fixed_swing
+              << "x, adaptive " << adaptive_swing << "x" << std::endl;
+
+    check(fixed_swing > 5.0, "fixed theta swings with volatility");
+    check(adaptive_swing > 0.5 && adaptive_swing < 2.0, "adaptive theta holds the event rate");
+    bool near_target = true;
+    for (const SessionLoad& session : adaptive_load) {
+        near_target = near_target && session.events > 20 && session.events < 180;  // Targeted 60 per hour
+    }
+    check(near_target, "each session near one event a minute");
+    auto spread = [](const std::vector<SessionLoad>& load) {
+        auto [least, most] = std::minmax_element(load.begin(), load.end(), [](const SessionLoad& a, const SessionLoad& b) {
+            return a.orders < b.orders;
+        });
+        return static_cast<double>(most->orders) / std::max<std::uint64_t>(least->orders, 1);
+    };
+    std::cout << "busiest/quietest session orders: fixed " << spread(fixed_load) << "x, adaptive "
+              << spread(adaptive_load) << "x" << std::endl;
+    check(spread(fixed_load) > 5.0 && spread(adaptive_load) < 2.0, "downstream order load steady across sessions");
+    check(adaptive_load[1].peak_events_per_minute < fixed_load[1].peak_events_per_minute,
+          "lower peak message rate in the volatile session");
+}
+
+void testWarmUpAndBounds() {
+    std::cout << "\n2. Warm-up and bounds" << std::endl;
+    DCIndicator indicator(0.004);
+    indicator.setAdaptiveTheta(kAdaptive);
+
+    // Violent ticks: the estimate would ask for far more than the upper bound
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> normal(0.0, 0.01);
+    double price = 100.0;
+    bool warm_up_at_base = true;
+    for (std::uint32_t i = 0; i < 2000; ++i) {
+        price *= std::exp(normal(rng));
+        indicator.processDataPoint(MarketDataPoint(static_cast<std::int64_t>(i) * 100000000, price));
+        if (i + 1 < kAdaptive.half_life_ticks) {
+            warm_up_at_base = warm_up_at_base && indicator.getTheta() == 0.004;
+        }
+    }
+    check(warm_up_at_base, "configured theta until warmed up");
+    check(indicator.getTheta() == 0.004 * kAdaptive.max_scale, "capped at the upper bound");
+    check(indicator.getBaseTheta() == 0.004, "base theta kept for signals");
+
+    // A flat price asks for less than the lower bound
+    for (std::uint32_t i = 2000; i < 20000; ++i) {
+        indicator.processDataPoint(MarketDataPoint(static_cast<std::int64_t>(i) * 100000000, price));
+    }
+    check(indicator.getTheta() == 0.004 * kAdaptive.min_scale, "held at the lower bound");
+
+    indicator.setTheta(0.002);
+    check(indicator.getTheta() == 0.002 * kAdaptive.min_scale, "bounds follow a new configured theta");
+    indicator.reset();
+    check(indicator.getTheta() == 0.002 && indicator.getVolatility() == 0.0, "reset warms up again");
+}
+
+void testDefaultUnchanged() {
+    std::cout << "\n3. Fixed mode unchanged" << std::endl;
+    const std::vector<MarketDataPoint> ticks = replay({{0.0004, 100000000}}, 5);
+    DCIndicator plain(0.004);
+    DCIndicator disabled(0.004);
+    disabled.setAdaptiveTheta(AdaptiveThetaSettings{false, 60.0, 500, 0.25, 4.0});
+    bool same = true;
+    for (const MarketDataPoint& tick : ticks) {
+        const DCEvent a = plain.processDataPoint(tick);
+        const DCEvent b = disabled.processDataPoint(tick);
+        same = same && a.type == b.type && a.tmv_ext == b.tmv_ext && a.time_adjusted_return == b.time_adjusted_return;
+    }
+    check(same && disabled.getTheta() == 0.004, "disabled mode detects the same events");
+}
+
+void testCost() {
+    std::cout << "\n4. Cost per tick" << std::endl;
+    const std::vector<MarketDataPoint> ticks = replay({{0.0004, 100000000}}, 9);
+    DCIndicator fixed(0.004);
+    DCIndicator adaptive(0.004);
+    adaptive.setAdaptiveTheta(kAdaptive);
+
+    auto measure = [&](DCIndicator& indicator) {
+        std::uint64_t events = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < 20; ++pass) {
+            for (const MarketDataPoint& tick : ticks) {
+                events += indicator.processDataPoint(tick).type != DCEventType::NONE;
+            }
+            indicator.reset();
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    (20.0 * ticks.size());
+        return std::make_pair(ns, events);
+    };
+    auto fixed_cost = measure(fixed);
+    auto adaptive_cost = measure(adaptive);
+    std::cout << std::fixed << std::setprecision(2) << "fixed " << fixed_cost.first << " ns/tick, adaptive "
+              << adaptive_cost.first << " ns/tick" << std::endl;
+    check(adaptive_cost.first < fixed_cost.first + 20.0, "adaptive threshold adds under 20 ns per tick");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Adaptive Theta Test ===" << std::endl;
+
+    testReplay();
+    testWarmUpAndBounds();
+    testDefaultUnchanged();
+    testCost();
+
+    return testSummary();
+}
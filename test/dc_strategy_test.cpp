@@ -0,0 +1,121 @@
+/**
+ * DC Strategy Test
+ * Checks the compiled-in strategies' signals and sizing, selection by
+ * name, and times a signal through the StrategyVariant visit the engine
+ * uses.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/dc_strategy_test.cpp src/common/Logger.cpp -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "strategy/DCStrategies.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+DCSignalMessage signal(DCEventType type, double time_adjusted_return, double price = 100.0) {
+    DCSignalMessage message{};
+    message.event_type = type;
+    message.time_adjusted_return = time_adjusted_return;
+    message.price = price;
+    return message;
+}
+
+struct Decision {
+    SignalType signal;
+    double quantity;
+};
+
+Decision decide(const StrategyVariant& strategy, const DCSignalMessage& message, const StrategyContext& context) {
+    return std::visit([&](const auto& s) {
+        const SignalType result = s.generateSignal(message, context);
+        return Decision{result, result != SignalType::NONE ? s.orderQuantity(message, context) : 0.0};
+    }, strategy);
+}
+
+void testTrend() {
+    std::cout << "\n1. Trend strategy" << std::endl;
+    StrategyVariant strategy;
+    check(makeStrategy("DC_Strategy_v1", strategy) && std::holds_alternative<DCTrendStrategy>(strategy),
+          "selected by name");
+
+    const StrategyContext plain{MarketState::UNKNOWN, 1.0, 0.0};
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5), plain).signal == SignalType::BUY, "upturn buys");
+    check(decide(strategy, signal(DCEventType::DOWNTURN, -0.5), plain).signal == SignalType::SELL, "downturn sells");
+    check(decide(strategy, signal(DCEventType::UPTURN, -0.5), plain).signal == SignalType::NONE,
+          "disagreeing return ignored");
+
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5, 10.0), plain).quantity == 100.0, "base quantity");
+    const StrategyContext levered_calm{MarketState::LOW_VOLATILITY, 2.0, 0.0};
+    const StrategyContext turbulent{MarketState::HIGH_VOLATILITY, 1.0, 0.0};
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5, 10.0), levered_calm).quantity == 300.0,
+          "leverage and calm regime scale up");
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5, 10.0), turbulent).quantity == 50.0,
+          "volatile regime scales down");
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5, 1000.0), plain).quantity == 10.0, "notional cap");
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5, 1e6), plain).quantity == 1.0, "minimum one unit");
+}
+
+void testContrarian() {
+    std::cout << "\n2. Contrarian strategy" << std::endl;
+    StrategyVariant strategy;
+    check(makeStrategy("DC_Contrarian_v1", strategy) && std::holds_alternative<DCContrarianStrategy>(strategy),
+          "selected by name");
+
+    const StrategyContext calm{MarketState::LOW_VOLATILITY, 1.0, 0.0};
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5), calm).signal == SignalType::SELL, "upturn faded");
+    check(decide(strategy, signal(DCEventType::DOWNTURN, -0.5), calm).signal == SignalType::BUY, "downturn faded");
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5), StrategyContext{MarketState::HIGH_VOLATILITY, 1.0, 0.0})
+              .signal == SignalType::NONE, "stands aside in volatile regime");
+    check(decide(strategy, signal(DCEventType::UPTURN, 0.5, 10.0), calm).quantity == 50.0, "own base quantity");
+
+    check(!makeStrategy("no_such_strategy", strategy) && std::holds_alternative<DCContrarianStrategy>(strategy),
+          "unknown name refused, strategy kept");
+    check(strategyNames().size() == std::variant_size_v<StrategyVariant>, "every variant alternative has a name");
+}
+
+void testCost() {
+    std::cout << "\n3. Cost per signal (benchmark)" << std::endl;
+    constexpr int kSignals = 20000000;
+    std::vector<DCSignalMessage> messages;
+    for (int i = 0; i < 1024; ++i) {
+        messages.push_back(signal(i % 3 == 0 ? DCEventType::UPTURN : DCEventType::DOWNTURN,
+                                  (i % 5) - 2.0, 50.0 + i % 100));
+    }
+
+    StrategyVariant strategy;
+    makeStrategy("DC_Strategy_v1", strategy);
+    const StrategyContext context{MarketState::NORMAL_VOLATILITY, 1.0, 0.0};
+
+    double total = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSignals; ++i) {
+        total += decide(strategy, messages[i & 1023], context).quantity;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kSignals;
+
+    // Reported, not checked: timing depends on the machine and its load
+    std::cout << std::fixed << std::setprecision(2) << ns << " ns/signal (budget 20 ns), checksum " << total
+              << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== DC Strategy Test ===" << std::endl;
+
+    testTrend();
+    testContrarian();
+    testCost();
+
+    return testSummary();
+}
@@ -0,0 +1,261 @@
+/**
+ * Exchange Simulator Test
+ * Checks the simulated venue the execution engine uses in simulation mode:
+ * timer wheel ordering, seeded reproducibility, latency bounds, partial
+ * fills, price-time priority matching against a book built from market
+ * data, and packed order ids.
+ *
+ * Build: g++ -std=c++17 -O2 -Iinclude test/exchange_simulator_test.cpp src/execution/ExchangeSimulator.cpp \
+ *            src/execution/OrderBook.cpp
+ */
+
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include "common/TimerWheel.h"
+#include "execution/ExchangeSimulator.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+TradingOrder makeOrder(SignalType signal, double price, double quantity) {
+    TradingOrder order{};
+    order.signal = signal;
+    order.price = price;
+    order.quantity = quantity;
+    std::strncpy(order.symbol, "EURUSD", sizeof(order.symbol) - 1);
+    return order;
+}
+
+std::vector<SimulatedFill> runSession(const ExchangeSimulator::Settings& settings) {
+    ExchangeSimulator venue(settings);
+    std::vector<SimulatedFill> fills;
+    std::int64_t now = 1000000;
+
+    for (std::uint64_t seq = 1; seq <= 200; ++seq) {
+        venue.submitOrder(makeOrder(seq % 2 ? SignalType::BUY : SignalType::SELL, 1.1, 10.0), seq, now);
+        now += 7000;
+        venue.poll(now, [&](const SimulatedFill& fill) { fills.push_back(fill); });
+    }
+    while (venue.hasPendingFills()) {
+        now += 10000;
+        venue.poll(now, [&](const SimulatedFill& fill) { fills.push_back(fill); });
+    }
+    return fills;
+}
+
+void testTimerWheel() {
+    std::cout << "\n1. Timer wheel" << std::endl;
+    TimerWheel<int> wheel(1000, 8, 16);
+
+    check(wheel.schedule(5500, 1), "schedule within first rotation");
+    check(wheel.schedule(20500, 2), "schedule beyond one rotation");
+    check(wheel.schedule(5600, 3), "schedule into the same slot");
+
+    std::vector<int> fired;
+    auto collect = [&](std::int64_t, int payload) { fired.push_back(payload); };
+
+    check(wheel.advance(5000, collect) == 0, "nothing due before the deadline");
+    check(wheel.advance(6000, collect) == 2 && fired[0] == 1 && fired[1] == 3,
+          "same-slot entries fire in scheduling order");
+    check(wheel.advance(13000, collect) == 0 && wheel.size() == 1, "later rotation left in place");
+    check(wheel.advance(21000, collect) == 1 && fired.back() == 2, "later rotation fires on time");
+
+    check(wheel.schedule(100, 4), "deadline in the past accepted");
+    check(wheel.advance(21000, collect) == 1 && wheel.empty(), "past deadline fires on the next advance");
+
+    TimerWheel<int> small(1000, 4, 2);
+    small.schedule(1000, 1);
+    small.schedule(1000, 2);
+    check(!small.schedule(1000, 3), "schedule fails when the pool is exhausted");
+}
+
+void testDeterminism() {
+    std::cout << "\n2. Seeded reproducibility" << std::endl;
+    ExchangeSimulator::Settings settings = ExchangeSimulator::Settings::defaults();
+    settings.partial_fill_probability = 0.3;
+
+    std::vector<SimulatedFill> first = runSession(settings);
+    std::vector<SimulatedFill> second = runSession(settings);
+
+    bool identical = first.size() == second.size();
+    for (std::size_t i = 0; identical && i < first.size(); ++i) {
+        identical = first[i].order_id == second[i].order_id &&
+                    first[i].fill_ns == second[i].fill_ns &&
+                    first[i].price == second[i].price &&
+                    first[i].quantity == second[i].quantity;
+    }
+    check(identical, "same seed gives identical fills");
+
+    settings.seed = 7;
+    std::vector<SimulatedFill> reseeded = runSession(settings);
+    bool differs = reseeded.size() != first.size();
+    for (std::size_t i = 0; !differs && i < first.size(); ++i) {
+        differs = reseeded[i].fill_ns != first[i].fill_ns;
+    }
+    check(differs, "different seed gives different fills");
+}
+
+void testLatencyAndSlippage() {
+    std::cout << "\n3. Latency and slippage" << std::endl;
+    ExchangeSimulator::Settings settings = ExchangeSimulator::Settings::defaults();
+    settings.slippage_bps = 2.0;
+    settings.slippage_noise_bps = 0.0;
+
+    std::vector<SimulatedFill> fills = runSession(settings);
+    bool latency_ok = !fills.empty();
+    bool adverse = !fills.empty();
+    for (const auto& fill : fills) {
+        std::int64_t latency = fill.fill_ns - fill.submit_ns;
+        latency_ok = latency_ok && latency >= settings.base_latency_ns &&
+                     latency <= settings.base_latency_ns + settings.latency_jitter_ns;
+        double expected = fill.signal == SignalType::BUY ? 1.1 * (1.0 + 2e-4) : 1.1 * (1.0 - 2e-4);
+        adverse = adverse && std::fabs(fill.price - expected) < 1e-12;
+    }
+    check(fills.size() == 200, "every order filled once");
+    check(latency_ok, "latency within base + jitter");
+    check(adverse, "slippage moves the price against the order");
+}
+
+void testPartialFills() {
+    std::cout << "\n4. Partial fills" << std::endl;
+    ExchangeSimulator::Settings settings = ExchangeSimulator::Settings::defaults();
+    settings.partial_fill_probability = 1.0;
+    settings.max_partial_fills = 3;
+
+    ExchangeSimulator venue(settings);
+    venue.submitOrder(makeOrder(SignalType::BUY, 1.1, 9.0), 1, 0);
+
+    std::vector<SimulatedFill> fills;
+    venue.poll(1000000, [&](const SimulatedFill& fill) { fills.push_back(fill); });
+
+    double total = 0.0;
+    bool ordered = true;
+    for (std::size_t i = 0; i < fills.size(); ++i) {
+        total += fills[i].quantity;
+        bool last = (i + 1 == fills.size());
+        ordered = ordered && fills[i].status ==
+            (last ? ExecutionStatus::FILLED : ExecutionStatus::PARTIALLY_FILLED);
+        if (i > 0) {
+            ordered = ordered && fills[i].fill_ns > fills[i - 1].fill_ns;
+        }
+    }
+    check(fills.size() >= 2 && fills.size() <= 3, "order split into 2-3 fills");
+    check(std::fabs(total - 9.0) < 1e-9, "fills add up to the order quantity");
+    check(ordered, "only the last fill completes the order");
+    check(venue.getStatistics().partial_fills == fills.size() - 1, "partial fills counted");
+}
+
+void testOrderBook() {
+    std::cout << "\n5. Order book price-time priority" << std::endl;
+    OrderBook book(256, 64);
+    std::vector<OrderBook::Match> matches;
+    auto collect = [&](const OrderBook::Match& match) { matches.push_back(match); };
+
+    OrderBook::OrderHandle first = book.addLimit(OrderBook::Side::SELL, 1000, 5.0, 1, collect).handle;
+    book.addLimit(OrderBook::Side::SELL, 1000, 5.0, 2, collect);
+    book.addLimit(OrderBook::Side::SELL, 1002, 5.0, 3, collect);
+    book.addLimit(OrderBook::Side::BUY, 998, 5.0, 4, collect);
+    check(book.bestAsk() == 1000 && book.bestBid() == 998, "best bid and ask");
+    check(book.depthAt(OrderBook::Side::SELL, 1000) == 10.0, "level depth aggregates orders");
+
+    OrderBook::AddResult result = book.addLimit(OrderBook::Side::BUY, 1002, 12.0, 9, collect);
+    check(result.filled == 12.0 && result.handle == OrderBook::kInvalidOrder, "aggressive order fully filled");
+    check(matches.size() == 3 && matches[0].maker_owner == 1 && matches[1].maker_owner == 2 &&
+          matches[2].maker_owner == 3, "fills in price then time order");
+    check(matches[0].price_ticks == 1000 && matches[2].price_ticks == 1002 && matches[2].quantity == 2.0,
+          "fills at the maker's price");
+    check(book.remaining(first) == 0.0 && book.bestAsk() == 1002 &&
+          book.depthAt(OrderBook::Side::SELL, 1002) == 3.0, "book updated after the sweep");
+
+    matches.clear();
+    result = book.addLimit(OrderBook::Side::SELL, 998, 8.0, 10, collect);
+    check(result.filled == 5.0 && result.handle != OrderBook::kInvalidOrder &&
+          book.bestAsk() == 998 && book.bestBid() == OrderBook::kNoPrice, "remainder rests at its limit");
+    check(book.cancel(result.handle) && !book.cancel(result.handle) && book.bestAsk() == 1002,
+          "cancel restores the previous best");
+
+    // Far away prices slide the window once the book is empty there
+    OrderBook::OrderHandle far = book.addLimit(OrderBook::Side::BUY, 100000, 1.0, 11, collect).handle;
+    check(far == OrderBook::kInvalidOrder, "order outside a pinned window rejected");
+    book.clear();
+    check(book.addLimit(OrderBook::Side::BUY, 100000, 1.0, 11, collect).handle != OrderBook::kInvalidOrder &&
+          book.bestBid() == 100000, "window follows the market");
+}
+
+void testBookMatching() {
+    std::cout << "\n6. Fills against market data" << std::endl;
+    ExchangeSimulator::Settings settings = ExchangeSimulator::Settings::defaults();
+    settings.match_against_book = true;
+    settings.tick_size = 0.0001;
+    settings.quote_half_spread_bps = 1.0;  // One tick at 1.0
+    settings.quote_levels = 3;
+    settings.limit_slippage_bps = 1.5;     // May take the first level only
+    settings.resting_timeout_ns = 1000000;
+
+    ExchangeSimulator venue(settings);
+    std::vector<SimulatedFill> fills;
+    auto collect = [&](const SimulatedFill& fill) { fills.push_back(fill); };
+
+    MarketDataMessage tick{};
+    tick.price = 1.0;
+    tick.volume = 4.0;
+    std::strncpy(tick.symbol, "EURUSD", sizeof(tick.symbol) - 1);
+    venue.onMarketData(tick, 0);
+
+    venue.submitOrder(makeOrder(SignalType::BUY, 1.0, 10.0), 1, 0);
+    venue.poll(1000000 - 1, collect);
+    check(fills.size() == 1 && fills[0].status == ExecutionStatus::PARTIALLY_FILLED &&
+          std::fabs(fills[0].price - 1.0001) < 1e-12 && fills[0].quantity == 4.0,
+          "arrival takes the quoted size at the best ask only");
+    check(fills[0].fill_ns - fills[0].submit_ns >= settings.base_latency_ns, "fill after venue latency");
+    check(venue.getStatistics().working_orders == 1, "remainder rests in the book");
+
+    // Market moves down through the resting bid
+    tick.price = 0.9995;
+    tick.volume = 6.0;
+    venue.onMarketData(tick, 500000);
+    venue.poll(500000, collect);
+    check(fills.size() == 2 && fills[1].status == ExecutionStatus::FILLED && fills[1].quantity == 6.0 &&
+          std::fabs(fills[1].price - 1.0001) < 1e-12, "trade-through fills the rest at its limit");
+
+    venue.submitOrder(makeOrder(SignalType::SELL, 1.1, 1.0), 2, 600000);
+    venue.poll(700000, collect);
+    venue.poll(3000000, collect);
+    check(fills.size() == 3 && fills[2].status == ExecutionStatus::CANCELLED &&
+          venue.getStatistics().orders_expired == 1, "unfilled order cancelled after the timeout");
+    check(!venue.hasPendingFills() && venue.getStatistics().working_orders == 0, "nothing left working");
+}
+
+void testOrderIds() {
+    std::cout << "\n7. Packed order ids" << std::endl;
+    OrderId id = makeOrderId(3, 0xBEEF, 123456789);
+    check(orderIdEngine(id) == 3 && orderIdSession(id) == 0xBEEF && orderIdSequence(id) == 123456789,
+          "fields round-trip");
+    check(makeOrderId(3, 0xBEEF, 123456790) > id, "ids increase with the sequence");
+    check(formatOrderId(id) == "ORDER_3_48879_123456789", "formatted at report time");
+    check(std::is_trivially_copyable<TradeExecution>::value, "TradeExecution is trivially copyable");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Exchange Simulator Test ===" << std::endl;
+
+    testTimerWheel();
+    testDeterminism();
+    testLatencyAndSlippage();
+    testPartialFills();
+    testOrderBook();
+    testBookMatching();
+    testOrderIds();
+
+    return testSummary();
+}
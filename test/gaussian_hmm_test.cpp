@@ -0,0 +1,222 @@
+/**
+ * Gaussian HMM Test
+ * Samples DC-like features from known 2- and 3-regime HMMs, checks that
+ * Baum-Welch recovers the parameters and that the online filter tracks the
+ * hidden regime, round-trips a model file and times one filter update.
+ *
+ * Build: g++ -std=c++17 -O3 -Iinclude test/gaussian_hmm_test.cpp src/strategy/RegimeModel.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "strategy/GaussianHMM.h"
+#include "strategy/RegimeModel.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+template <std::size_t K>
+using Parameters = HmmParameters<K, kRegimeFeatures>;
+
+// Calm regimes: small moves over long durations; volatile: large moves, fast
+Parameters<2> twoRegimes() {
+    Parameters<2> p;
+    p.initial = {0.5, 0.5};
+    p.transition = {{{0.97, 0.03}, {0.05, 0.95}}};
+    p.mean = {{{-5.5, 2.0}, {-5.0, 1.0}}};
+    p.variance = {{{0.09, 0.36}, {0.09, 0.49}}};
+    return p;
+}
+
+Parameters<3> threeRegimes() {
+    Parameters<3> p;
+    p.initial = {0.4, 0.3, 0.3};
+    p.transition = {{{0.95, 0.04, 0.01}, {0.03, 0.94, 0.03}, {0.02, 0.06, 0.92}}};
+    p.mean = {{{-5.5, 2.5}, {-5.0, 1.0}, {-4.3, -0.8}}};
+    p.variance = {{{0.04, 0.16}, {0.04, 0.16}, {0.06, 0.25}}};
+    return p;
+}
+
+template <std::size_t K>
+void sample(const Parameters<K>& p, std::size_t length, std::mt19937_64& rng,
+            std::vector<RegimeObservation>& observations, std::vector<std::size_t>& states) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    auto draw = [&](const std::array<double, K>& probabilities) {
+        double u = uniform(rng);
+        for (std::size_t k = 0; k < K; ++k) {
+            if ((u -= probabilities[k]) <= 0.0) {
+                return k;
+            }
+        }
+        return K - 1;
+    };
+
+    std::size_t state = draw(p.initial);
+    for (std::size_t t = 0; t < length; ++t) {
+        RegimeObservation x;
+        for (std::size_t d = 0; d < kRegimeFeatures; ++d) {
+            x[d] = p.mean[state][d] + std::sqrt(p.variance[state][d]) * normal(rng);
+        }
+        observations.push_back(x);
+        states.push_back(state);
+        state = draw(p.transition[state]);
+    }
+}
+
+template <std::size_t K>
+double largestError(const Parameters<K>& fitted, const Parameters<K>& truth, bool transitions) {
+    double error = 0.0;
+    for (std::size_t i = 0; i < K; ++i) {
+        for (std::size_t d = 0; d < kRegimeFeatures; ++d) {
+            error = std::max(error, std::fabs(fitted.mean[i][d] - truth.mean[i][d]));
+        }
+        for (std::size_t j = 0; transitions && j < K; ++j) {
+            error = std::max(error, std::fabs(fitted.transition[i][j] - truth.transition[i][j]));
+        }
+    }
+    return error;
+}
+
+double filterAccuracy(const RegimeModel& model, const std::vector<RegimeObservation>& observations,
+                      const std::vector<std::size_t>& states) {
+    RegimeBelief belief;
+    model.reset(belief);
+    std::size_t correct = 0;
+    for (std::size_t t = 0; t < observations.size(); ++t) {
+        correct += model.update(belief, observations[t]) == states[t];
+    }
+    return static_cast<double>(correct) / observations.size();
+}
+
+template <std::size_t K>
+void testRecovery(const char* name, const Parameters<K>& truth) {
+    std::cout << "\n" << name << std::endl;
+    std::mt19937_64 rng(7);
+
+    // Several symbols' worth of history as independent sequences
+    std::vector<std::vector<RegimeObservation>> sequences(8);
+    std::vector<std::vector<std::size_t>> states(8);
+    for (std::size_t s = 0; s < sequences.size(); ++s) {
+        sample(truth, 2500, rng, sequences[s], states[s]);
+    }
+
+    const auto start = initialHmmParameters<K, kRegimeFeatures>(sequences);
+    const auto result = trainBaumWelch(sequences, start, 200, 1e-7);
+    std::cout << std::fixed << std::setprecision(3) << result.iterations << " iterations, log-likelihood "
+              << result.log_likelihood << std::endl;
+
+    check(result.converged, "Baum-Welch converged within the iteration limit");
+    check(largestError(result.parameters, truth, false) < 0.05, "emission means recovered");
+    check(largestError(result.parameters, truth, true) < 0.03, "transition probabilities recovered");
+
+    const auto limited = trainBaumWelch(sequences, start, 3, 1e-7);
+    check(limited.iterations == 3 && !limited.converged, "iteration limit honored");
+
+    std::vector<RegimeObservation> test;
+    std::vector<std::size_t> test_states;
+    sample(truth, 20000, rng, test, test_states);
+    const double accuracy = filterAccuracy(RegimeModel(result.parameters), test, test_states);
+    std::cout << "filter accuracy " << accuracy << std::endl;
+    check(accuracy > 0.9, "online filter tracks the hidden regime");
+}
+
+void testModelFile() {
+    std::cout << "\n3. Model file" << std::endl;
+    const std::string path = "/tmp/gaussian_hmm_test.rhmm";
+    RegimeModelSet models;
+    models.setDefault(RegimeModel(threeRegimes()));
+    Parameters<3> calmer = threeRegimes();
+    calmer.mean[2][0] = -4.8;
+    check(models.set("EURUSD", RegimeModel(calmer)), "symbol model added");
+    check(!models.set("GBPUSD", RegimeModel(twoRegimes())), "state count mismatch refused");
+    check(models.save(path), "models saved");
+
+    RegimeModelSet loaded;
+    std::string error;
+    check(loaded.load(path, error) && loaded.states() == 3 && loaded.symbolModels() == 1,
+          "models loaded with their state count");
+
+    RegimeBelief a;
+    RegimeBelief b;
+    const RegimeModel& original = models.lookup("EURUSD");
+    const RegimeModel& reloaded = loaded.lookup("EURUSD");
+    check(&loaded.lookup("USDJPY") != &reloaded, "unknown symbol falls back to the default");
+    original.reset(a);
+    reloaded.reset(b);
+    bool same = true;
+    std::mt19937_64 rng(3);
+    std::vector<RegimeObservation> observations;
+    std::vector<std::size_t> states;
+    sample(threeRegimes(), 1000, rng, observations, states);
+    for (const auto& x : observations) {
+        same = same && original.update(a, x) == reloaded.update(b, x);
+    }
+    check(same, "loaded model filters identically");
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("not a model", file);
+    std::fclose(file);
+    check(!loaded.load(path, error) && loaded.states() == 3, "bad file rejected, models kept");
+    check(!loaded.load("/nonexistent/model.rhmm", error), "missing file rejected");
+    std::remove(path.c_str());
+}
+
+void testFilterRobustness() {
+    std::cout << "\n4. Extreme observations" << std::endl;
+    RegimeModel model(twoRegimes());
+    RegimeBelief belief;
+    model.reset(belief);
+    model.update(belief, RegimeObservation{-5.5, 2.0});
+    const std::size_t extreme = model.update(belief, RegimeObservation{40.0, -60.0});
+    check(extreme == 1 && std::isfinite(belief[0]) && std::isfinite(belief[1]),
+          "far-tail observation does not underflow the belief");
+    check(std::fabs(belief[0] + belief[1] - 1.0) < 1e-9, "belief stays normalized");
+}
+
+void testCost() {
+    std::cout << "\n5. Cost per update (benchmark)" << std::endl;
+    constexpr std::size_t kUpdates = 5000000;
+    std::mt19937_64 rng(11);
+    std::vector<RegimeObservation> observations;
+    std::vector<std::size_t> states;
+    sample(threeRegimes(), 4096, rng, observations, states);
+
+    RegimeModel model(threeRegimes());
+    RegimeBelief belief;
+    model.reset(belief);
+    std::size_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kUpdates; ++i) {
+        sum += model.update(belief, observations[i & 4095]);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kUpdates;
+
+    // Reported, not checked: timing depends on the machine and its load
+    std::cout << std::fixed << std::setprecision(1) << ns << " ns/update (K=3, budget 200 ns), checksum " << sum
+              << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Gaussian HMM Test ===" << std::endl;
+
+    testRecovery("1. Two regimes", twoRegimes());
+    testRecovery("2. Three regimes", threeRegimes());
+    testModelFile();
+    testFilterRobustness();
+    testCost();
+
+    return testSummary();
+}
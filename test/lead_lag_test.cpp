@@ -0,0 +1,191 @@
+/**
+ * Lead-Lag Test
+ * Streams DC events through the lead-lag pair table: a follower that
+ * turns a few milliseconds after its leader must show that lag and its
+ * agreement, the most agreeing leader must be the one offered as a
+ * feature, bad pairs must be refused, and with thousands of pairs an
+ * event must stay under 200 ns and allocate nothing.
+ *
+ * Build: g++ -std=c++17 -O3 -march=native -pthread -Iinclude test/lead_lag_test.cpp src/strategy/LeadLagTable.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "strategy/LeadLagTable.h"
+
+#define TEST_HARNESS_COUNT_ALLOCATIONS
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+constexpr std::int64_t kMillisecondNs = 1000000;
+const LeadLagSettings kSettings{100 * kMillisecondNs, 50, 20};
+
+DCEventType opposite(DCEventType type) {
+    return type == DCEventType::UPTURN ? DCEventType::DOWNTURN : DCEventType::UPTURN;
+}
+
+void testPairs() {
+    std::cout << "\n1. Lag and agreement" << std::endl;
+    SymbolTable symbols(64);
+    LeadLagTable table;
+    std::string error;
+    check(table.configure({{"EURUSD", "EURCHF"}, {"USDJPY", "EURCHF"}, {"EURUSD", "GBPUSD"}}, kSettings,
+                          symbols, error), "pairs configured");
+    const SymbolId eurusd = symbols.find("EURUSD");
+    const SymbolId usdjpy = symbols.find("USDJPY");
+    const SymbolId eurchf = symbols.find("EURCHF");
+    check(eurusd != kInvalidSymbolId && eurchf != kInvalidSymbolId, "pair symbols have ids before they trade");
+
+    // EURCHF turns 5 +/- 1 ms after EURUSD, the same way 90% of the time;
+    // USDJPY turns at random 20 ms before that
+    std::mt19937_64 rng(49);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> jitter(0.0, 1.0 * kMillisecondNs);
+    std::int64_t now = 0;
+    bool gated = true;
+    for (int i = 0; i < 2000; ++i) {
+        now += 1000 * kMillisecondNs;
+        const DCEventType lead = uniform(rng) < 0.5 ? DCEventType::UPTURN : DCEventType::DOWNTURN;
+        table.onEvent(usdjpy, now - 20 * kMillisecondNs, uniform(rng) < 0.5 ? lead : opposite(lead));
+        table.onEvent(eurusd, now, lead);
+        const std::int64_t follow = now + 5 * kMillisecondNs + static_cast<std::int64_t>(jitter(rng));
+        table.onEvent(eurchf, follow, uniform(rng) < 0.9 ? lead : opposite(lead));
+        if (i + 1 < static_cast<int>(kSettings.min_samples)) {
+            gated = gated && !table.features(eurchf, follow).has_leader;
+        }
+    }
+
+    const LeadLagTable::PairStatistics& pair = table.pair(table.find(eurusd, eurchf));
+    const LeadLagTable::PairStatistics& noise = table.pair(table.find(usdjpy, eurchf));
+    std::cout << std::fixed << std::setprecision(2) << "EURUSD->EURCHF lag " << pair.mean_lag_ns / kMillisecondNs
+              << " +/- " << std::sqrt(pair.lag_variance) / kMillisecondNs << " ms, agreement " << pair.agreement
+              << "; USDJPY->EURCHF lag " << noise.mean_lag_ns / kMillisecondNs << " ms, agreement "
+              << noise.agreement << std::endl;
+    check(pair.samples == 2000 && std::fabs(pair.mean_lag_ns - 5.0 * kMillisecondNs) < 1.0 * kMillisecondNs,
+          "lag near 5 ms");
+    check(std::fabs(std::sqrt(pair.lag_variance) - 1.0 * kMillisecondNs) < 0.5 * kMillisecondNs, "spread near 1 ms");
+    check(pair.agreement > 0.75, "agreement near 90%");
+    check(std::fabs(noise.mean_lag_ns - 25.0 * kMillisecondNs) < 2.0 * kMillisecondNs && noise.agreement < 0.75,
+          "unrelated leader: longer lag, lower agreement");
+    check(table.pair(table.find(eurusd, symbols.find("GBPUSD"))).samples == 0, "follower without events untouched");
+    check(table.find(eurchf, eurusd) == table.pairs(), "pairs are directed");
+
+    check(gated, "no feature before min_samples matches");
+    const LeadLagFeatures features = table.features(eurchf, now + 8 * kMillisecondNs);
+    check(features.has_leader && features.leader == eurusd, "most agreeing leader offered");
+    check(features.since_leader_ns == 8 * kMillisecondNs && features.samples == 2000, "time since the leader's event");
+    check(!table.features(eurusd, now).has_leader, "a symbol that follows nothing has no leader");
+
+    // A follower event long after the leader's is not a match
+    table.onEvent(eurchf, now + 500 * kMillisecondNs, DCEventType::UPTURN);
+    check(table.pair(table.find(eurusd, eurchf)).samples == 2000, "events past max_lag_ns are not matched");
+}
+
+void testErrors() {
+    std::cout << "\n2. Invalid pairs" << std::endl;
+    SymbolTable symbols(64);
+    LeadLagTable table;
+    std::string error;
+    table.configure({{"EURUSD", "EURCHF"}}, kSettings, symbols, error);
+
+    check(!table.configure({{"EURUSD", "EURUSD"}}, kSettings, symbols, error), "self lead refused");
+    std::cout << "  " << error << std::endl;
+    check(!table.configure({{"EURUSD", "GBPUSD"}, {"EURUSD", "GBPUSD"}}, kSettings, symbols, error),
+          "repeated pair refused");
+    std::cout << "  " << error << std::endl;
+    check(!table.configure({{"", "GBPUSD"}}, kSettings, symbols, error), "empty symbol refused");
+    check(!table.configure({{"A_VERY_LONG_SYMBOL_NAME", "GBPUSD"}}, kSettings, symbols, error), "overlong symbol refused");
+    check(!table.configure({{"EURUSD", "SIXTEEN_CHARS_XY"}}, kSettings, symbols, error),
+          "16-character symbol refused, as char[16] messages truncate it");
+    check(!table.configure({{"EURUSD", "GBPUSD"}}, LeadLagSettings{0, 50, 20}, symbols, error), "zero max lag refused");
+    check(table.pairs() == 1, "failed configure keeps the current pairs");
+    const std::size_t known = symbols.size();
+    check(!table.configure({{"AUDUSD", "NZDUSD"}, {"EURUSD", "GBPUSD"}, {"EURUSD", "GBPUSD"}}, kSettings, symbols, error) &&
+          symbols.size() == known && symbols.find("AUDUSD") == kInvalidSymbolId, "failed configure adds no symbols");
+
+    SymbolTable small(2);
+    check(!table.configure({{"EURUSD", "GBPUSD"}, {"EURUSD", "USDJPY"}}, kSettings, small, error),
+          "full symbol table refused");
+}
+
+void testThousandsOfPairs() {
+    std::cout << "\n3. 2000 symbols, 8000 pairs" << std::endl;
+    constexpr int kSymbols = 2000;
+    constexpr int kPairs = 8000;
+    std::mt19937_64 rng(4);
+    std::vector<Config::LeadLagPairConfig> pairs;
+    std::vector<std::vector<bool>> listed(kSymbols, std::vector<bool>(kSymbols, false));
+    auto name = [](int i) {
+        char buffer[kSymbolLength + 1];
+        std::snprintf(buffer, sizeof(buffer), "SYM%05d", i);
+        return std::string(buffer);
+    };
+    while (static_cast<int>(pairs.size()) < kPairs) {
+        const int leader = static_cast<int>(rng() % kSymbols);
+        const int follower = static_cast<int>(rng() % kSymbols);
+        if (leader != follower && !listed[leader][follower]) {
+            listed[leader][follower] = true;
+            pairs.push_back({name(leader), name(follower)});
+        }
+    }
+
+    SymbolTable symbols(16384);
+    LeadLagTable table;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    check(table.configure(pairs, kSettings, symbols, error), "pairs configured");
+    const double configure_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    constexpr int kEvents = 5000000;
+    std::vector<SymbolId> ids(1 << 16);
+    std::vector<DCEventType> types(1 << 16);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = symbols.find(name(static_cast<int>(rng() % kSymbols)).c_str());
+        types[i] = rng() % 2 ? DCEventType::UPTURN : DCEventType::DOWNTURN;
+    }
+
+    const std::size_t allocations_before = allocations;
+    double checksum = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kEvents; ++i) {
+        const std::size_t n = static_cast<std::size_t>(i) & 0xFFFF;
+        const std::int64_t now = static_cast<std::int64_t>(i) * 10000;  // 100k events a second
+        table.onEvent(ids[n], now, types[n]);
+        checksum += table.features(ids[n], now).agreement;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kEvents;
+    const std::size_t hot_allocations = allocations - allocations_before;
+
+    std::uint64_t matched = 0;
+    for (std::size_t i = 0; i < table.pairs(); ++i) {
+        matched += table.pair(i).samples;
+    }
+    // Timings reported, not checked: they depend on the machine and its load
+    std::cout << std::fixed << std::setprecision(2) << "configure " << configure_ms << " ms, " << ns
+              << " ns/event with features (budget 200 ns), " << matched << " matches, " << hot_allocations
+              << " allocations, checksum " << checksum << std::endl;
+    check(hot_allocations == 0, "no allocation per event");
+    check(matched > 0, "pairs matched");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Lead-Lag Test ===" << std::endl;
+
+    testPairs();
+    testErrors();
+    testThousandsOfPairs();
+
+    return testSummary();
+}
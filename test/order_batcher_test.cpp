@@ -0,0 +1,134 @@
+/**
+ * Order Batcher Test
+ * Checks per-symbol netting of opposing orders, the batch message layout
+ * the execution engine decodes, the per-batch symbol limit, and that a
+ * batch larger than one MTU decodes only once its fragments are joined.
+ *
+ * Build: g++ -std=c++17 -O2 -Iinclude test/order_batcher_test.cpp src/strategy/OrderBatcher.cpp
+ */
+
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "strategy/OrderBatcher.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+TradingOrder makeOrder(const char* symbol, SignalType signal, double quantity, double price, std::int64_t timestamp) {
+    TradingOrder order{};
+    order.timestamp = timestamp;
+    order.signal = signal;
+    order.price = price;
+    order.quantity = quantity;
+    std::strncpy(order.symbol, symbol, sizeof(order.symbol) - 1);
+    order.hops.feed_receive_ns = timestamp;
+    return order;
+}
+
+void testNetting() {
+    std::cout << "\n1. Netting" << std::endl;
+    OrderBatcher batcher(16, 64);
+
+    batcher.add(0, makeOrder("EURUSD", SignalType::BUY, 100.0, 1.10, 1));
+    batcher.add(1, makeOrder("GBPUSD", SignalType::SELL, 50.0, 1.30, 2));
+    batcher.add(0, makeOrder("EURUSD", SignalType::SELL, 30.0, 1.11, 3));
+    batcher.add(2, makeOrder("USDJPY", SignalType::BUY, 10.0, 150.0, 4));
+    batcher.add(2, makeOrder("USDJPY", SignalType::SELL, 10.0, 150.1, 5));
+    batcher.add(1, makeOrder("GBPUSD", SignalType::SELL, 20.0, 1.29, 6));
+    check(batcher.pending() == 3, "one entry per symbol");
+
+    OrderBatcher::Batch batch = batcher.build();
+    check(batch.count == 2 && batch.netted == 3, "opposite orders netted, flat symbol dropped, same side not netted");
+    check(batch.symbols[0] == 0 && batch.orders[0].signal == SignalType::BUY &&
+          batch.orders[0].quantity == 70.0, "net buy of 70");
+    check(batch.orders[0].price == 1.11 && batch.orders[0].hops.feed_receive_ns == 1,
+          "latest price, first order's hops");
+    check(batch.symbols[1] == 1 && batch.orders[1].signal == SignalType::SELL &&
+          batch.orders[1].quantity == 70.0, "same-side orders merged");
+    check(batcher.empty() && batcher.build().count == 0, "build starts a new batch");
+}
+
+void testMessageLayout() {
+    std::cout << "\n2. Message layout" << std::endl;
+    OrderBatcher batcher(16, 64);
+    batcher.add(5, makeOrder("EURUSD", SignalType::BUY, 100.0, 1.10, 1));
+    batcher.add(7, makeOrder("AUDUSD", SignalType::SELL, 25.0, 0.65, 2));
+    OrderBatcher::Batch batch = batcher.build();
+
+    TradingOrderBatchHeader header;
+    std::memcpy(&header, batch.data, sizeof(header));
+    check(header.magic == kTradingOrderBatchMagic && header.count == 2, "header");
+    check(batch.length == sizeof(header) + 2 * sizeof(TradingOrder) && batch.length != sizeof(TradingOrder),
+          "length distinguishes a batch from a single order");
+
+    TradingOrder second;
+    std::memcpy(&second, batch.data + sizeof(header) + sizeof(TradingOrder), sizeof(second));
+    check(std::strcmp(second.symbol, "AUDUSD") == 0 && second.quantity == 25.0, "orders follow the header");
+}
+
+void testCapacity() {
+    std::cout << "\n3. Symbols per batch" << std::endl;
+    OrderBatcher batcher(2, 64);
+    check(batcher.add(0, makeOrder("A", SignalType::BUY, 1.0, 1.0, 1)) &&
+          batcher.add(1, makeOrder("B", SignalType::BUY, 1.0, 1.0, 1)), "fill the batch");
+    check(batcher.add(1, makeOrder("B", SignalType::BUY, 1.0, 1.0, 2)), "existing symbol still nets");
+    check(!batcher.add(2, makeOrder("C", SignalType::BUY, 1.0, 1.0, 3)), "new symbol refused when full");
+    check(!batcher.add(64, makeOrder("D", SignalType::BUY, 1.0, 1.0, 3)), "symbol id outside the table refused");
+    check(batcher.build().count == 2 && batcher.add(2, makeOrder("C", SignalType::BUY, 1.0, 1.0, 4)),
+          "room again after build");
+}
+
+void testFragmentedBatch() {
+    std::cout << "\n4. Batch larger than one MTU" << std::endl;
+    constexpr std::size_t kMtuPayload = 1376;  // Aeron's default 1408-byte MTU less its frame header
+    OrderBatcher batcher(kMaxOrdersPerBatch, 1024);
+    for (SymbolId id = 0; id < kMaxOrdersPerBatch; ++id) {
+        batcher.add(id, makeOrder("EURUSD", SignalType::BUY, 1.0 + id, 1.10, id));
+    }
+    OrderBatcher::Batch batch = batcher.build();
+    check(batch.count == kMaxOrdersPerBatch && batch.length > 14 * kMtuPayload, "full batch spans many fragments");
+
+    // Fragments delivered one by one, as a poll without an assembler would
+    std::vector<TradingOrder> decoded;
+    auto collect = [&decoded](const TradingOrder& order) { decoded.push_back(order); };
+    int refused = 0;
+    int fragments = 0;
+    for (std::size_t offset = 0; offset < batch.length; offset += kMtuPayload, ++fragments) {
+        const std::size_t length = std::min(kMtuPayload, batch.length - offset);
+        refused += decodeOrderMessage(batch.data + offset, length, collect) ? 0 : 1;
+    }
+    check(refused == fragments && decoded.empty(), "no fragment is read as orders");
+
+    // Joined again, as the execution engine's fragment assembler delivers it
+    std::vector<std::uint8_t> joined(batch.data, batch.data + batch.length);
+    check(decodeOrderMessage(joined.data(), joined.size(), collect) && decoded.size() == kMaxOrdersPerBatch,
+          "reassembled batch decodes every order");
+    check(decoded.back().quantity == kMaxOrdersPerBatch && decoded.back().hops.feed_receive_ns == kMaxOrdersPerBatch - 1,
+          "orders intact");
+
+    check(!decodeOrderMessage(joined.data(), sizeof(TradingOrder) + 8, collect) &&
+          !decodeOrderMessage(joined.data(), sizeof(TradingOrder) - 8, collect), "only exact lengths accepted");
+    TradingOrder single = makeOrder("GBPUSD", SignalType::SELL, 5.0, 1.27, 9);
+    decoded.clear();
+    check(decodeOrderMessage(reinterpret_cast<const std::uint8_t*>(&single), sizeof(single), collect) &&
+          decoded.size() == 1 && decoded[0].quantity == 5.0, "bare order");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Order Batcher Test ===" << std::endl;
+
+    testNetting();
+    testMessageLayout();
+    testCapacity();
+    testFragmentedBatch();
+
+    return testSummary();
+}
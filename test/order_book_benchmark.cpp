@@ -0,0 +1,141 @@
+/**
+ * Order Book Benchmark
+ * Measures book events per second on one core for the simulation matching
+ * engine: a raw mixed add/cancel/aggress workload around a drifting price,
+ * and the full market data path where every tick requotes a symbol's book
+ * while simulated orders rest in and trade against it.
+ *
+ * Build: g++ -std=c++17 -O3 -Iinclude test/order_book_benchmark.cpp src/execution/OrderBook.cpp \
+ *            src/execution/ExchangeSimulator.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include "execution/ExchangeSimulator.h"
+#include "execution/OrderBook.h"
+
+using namespace trading;
+
+namespace {
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void runRawBook() {
+    constexpr int kEvents = 10000000;
+    OrderBook book(4096, 65536);
+    DeterministicRng rng(1);
+
+    std::vector<OrderBook::OrderHandle> live;
+    live.reserve(65536);
+    std::uint64_t matches = 0;
+    auto on_match = [&](const OrderBook::Match&) { matches++; };
+
+    std::int64_t mid = 100000;
+    std::uint64_t adds = 0, cancels = 0, aggressions = 0;
+
+    const std::int64_t start = nowNs();
+    for (int i = 0; i < kEvents; ++i) {
+        if ((i & 255) == 0) {
+            mid += rng.uniformInt(-2, 2);
+        }
+
+        const std::uint64_t action = rng.next() % 100;
+        if (action < 55 || live.empty()) {
+            // Passive add a few ticks away from the touch
+            const bool buy = rng.next() & 1;
+            const std::int64_t offset = 1 + rng.uniformInt(0, 20);
+            OrderBook::AddResult result = book.addLimit(buy ? OrderBook::Side::BUY : OrderBook::Side::SELL,
+                                                        buy ? mid - offset : mid + offset,
+                                                        1.0 + static_cast<double>(rng.next() % 10), 1, on_match);
+            if (result.handle != OrderBook::kInvalidOrder && live.size() < 60000) {
+                live.push_back(result.handle);
+            }
+            adds++;
+        } else if (action < 95) {
+            // Cancel a random order; a stale handle may hit a newer order, which is fine for load
+            const std::size_t index = rng.next() % live.size();
+            book.cancel(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+            cancels++;
+        } else {
+            const bool buy = rng.next() & 1;
+            book.match(buy ? OrderBook::Side::BUY : OrderBook::Side::SELL,
+                       buy ? mid + 5 : mid - 5, 20.0, 2, on_match);
+            aggressions++;
+        }
+    }
+    const std::int64_t elapsed = nowNs() - start;
+
+    std::cout << "Raw book: " << kEvents << " events (" << adds << " adds, " << cancels
+              << " cancels, " << aggressions << " aggressions, " << matches << " matches)" << std::endl;
+    std::cout << "  " << std::fixed << std::setprecision(1)
+              << static_cast<double>(elapsed) / kEvents << " ns/event, "
+              << static_cast<double>(kEvents) * 1000.0 / elapsed << " M events/s" << std::endl;
+}
+
+void runMarketDataPath() {
+    constexpr int kTicks = 2000000;
+    const char* symbols[] = {"EURUSD", "GBPUSD", "USDJPY", "AUDUSD"};
+
+    ExchangeSimulator::Settings settings = ExchangeSimulator::Settings::defaults();
+    settings.match_against_book = true;
+    settings.resting_timeout_ns = 50000000;
+    ExchangeSimulator venue(settings);
+    DeterministicRng rng(2);
+
+    double prices[] = {1.1000, 1.2700, 150.00, 0.6600};
+    std::uint64_t fills = 0;
+    std::uint64_t sequence = 0;
+    std::int64_t now = 0;
+
+    const std::int64_t start = nowNs();
+    for (int i = 0; i < kTicks; ++i) {
+        const int s = i & 3;
+        prices[s] *= 1.0 + (rng.uniform() - 0.5) * 2e-4;
+        now += 1000;
+
+        MarketDataMessage tick{};
+        tick.sequence_number = static_cast<std::uint64_t>(i) + 1;
+        tick.price = prices[s];
+        tick.volume = 1000.0;
+        std::strncpy(tick.symbol, symbols[s], sizeof(tick.symbol) - 1);
+        venue.onMarketData(tick, now);
+
+        if ((i & 63) == 0) {
+            TradingOrder order{};
+            order.signal = (rng.next() & 1) ? SignalType::BUY : SignalType::SELL;
+            order.price = prices[s];
+            order.quantity = 2500.0;
+            std::strncpy(order.symbol, symbols[s], sizeof(order.symbol) - 1);
+            venue.submitOrder(order, ++sequence, now);
+        }
+        fills += static_cast<std::uint64_t>(venue.poll(now, [](const SimulatedFill&) {}));
+    }
+    const std::int64_t elapsed = nowNs() - start;
+
+    ExchangeSimulator::Statistics stats = venue.getStatistics();
+    std::cout << "Market data path: " << kTicks << " ticks, " << stats.book_events << " book events, "
+              << sequence << " orders, " << fills << " fills (" << stats.partial_fills << " partial, "
+              << stats.orders_expired << " expired)" << std::endl;
+    std::cout << "  " << std::fixed << std::setprecision(1)
+              << static_cast<double>(elapsed) / kTicks << " ns/tick, "
+              << static_cast<double>(stats.book_events) * 1000.0 / elapsed << " M book events/s" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Order Book Benchmark ===" << std::endl;
+    runRawBook();
+    runMarketDataPath();
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * Parameter Reload Test
+ * Swaps a strategy instance's parameters while its thread keeps trading:
+ * orders must switch to the new leverage without a stop, every signal must
+ * see one consistent parameter block, bad updates must be refused, and the
+ * config watcher must report in-place writes and renames of the file only.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/parameter_reload_test.cpp src/strategy/StrategyInstance.cpp src/strategy/OrderBatcher.cpp src/strategy/RiskGate.cpp src/strategy/RuleTable.cpp src/common/ConfigWatcher.cpp src/common/TimeUtils.cpp src/common/Logger.cpp -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "common/ConfigWatcher.h"
+#include "strategy/StrategyInstance.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+// Written by the instance's thread only
+class CapturingPublisher : public OrderPublisher {
+public:
+    bool publish(const std::uint8_t* data, std::size_t length) override {
+        if (length == sizeof(TradingOrder)) {
+            TradingOrder order;
+            std::memcpy(&order, data, sizeof(order));
+            quantities.push_back(order.quantity);
+        }
+        return true;
+    }
+
+    std::vector<double> quantities;
+};
+
+DCSignalMessage signal(DCEventType type) {
+    DCSignalMessage message{};
+    message.event_type = type;
+    message.time_adjusted_return = type == DCEventType::UPTURN ? 0.5 : -0.5;
+    message.price = 10.0;
+    message.theta = 0.004;
+    std::strncpy(message.symbol, "EURUSD", sizeof(message.symbol) - 1);
+    return message;
+}
+
+StrategyInstanceSettings trend(double leverage) {
+    return StrategyInstanceSettings{DCTrendStrategy::kName, leverage, false, {}, nullptr, false};
+}
+
+void testUpdateWhileRunning() {
+    std::cout << "\n1. Parameters swapped under a running strategy" << std::endl;
+    RcuDomain rcu;
+    RcuDomain::ReaderId reader = rcu.registerReader();
+    CapturingPublisher publisher;
+
+    StrategyVariant strategy;
+    makeStrategy(DCTrendStrategy::kName, strategy);
+    StrategyInstance instance(0, strategy, trend(1.0), rcu, publisher, 64);
+    instance.setReportMode(false, false);
+    instance.enableRiskChecks(false);
+
+    // Alternating signals each reverse the whole position, so every order is
+    // twice the current target: 200 at leverage 1, 400 at leverage 2
+    std::atomic<bool> running(true);
+    std::atomic<int> cycles(0);
+    std::thread engine([&]() {
+        rcu.online(reader);
+        const DCSignalMessage up = signal(DCEventType::UPTURN);
+        const DCSignalMessage down = signal(DCEventType::DOWNTURN);
+        while (running.load()) {
+            rcu.quiescent(reader);
+            for (int i = 0; i < 16; ++i) {
+                instance.onSignal(i % 2 == 0 ? up : down, 0, MarketState::UNKNOWN, 1.0, 0);
+            }
+            cycles++;
+            std::this_thread::yield();
+        }
+        rcu.offline(reader);
+    });
+
+    while (cycles.load() < 100) {
+        std::this_thread::yield();
+    }
+    auto start = std::chrono::steady_clock::now();
+    const bool updated = instance.updateParameters(trend(2.0));
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    const int cycles_at_update = cycles.load();
+    while (cycles.load() < cycles_at_update + 100) {
+        std::this_thread::yield();
+    }
+    running.store(false);
+    engine.join();
+
+    std::cout << std::fixed << std::setprecision(1) << "update returned after " << us << " us, "
+              << publisher.quantities.size() << " orders" << std::endl;
+    check(updated, "update accepted while running");
+
+    // One switch from the old sizes to the new ones, nothing in between
+    std::size_t switches = 0;
+    bool consistent = true;
+    for (std::size_t i = 1; i < publisher.quantities.size(); ++i) {
+        const double previous = publisher.quantities[i - 1];
+        const double current = publisher.quantities[i];
+        consistent = consistent && (current == 100.0 || current == 200.0 || current == 300.0 || current == 400.0);
+        switches += (previous <= 200.0) != (current <= 200.0) ? 1 : 0;
+    }
+    check(publisher.quantities.front() == 100.0 && publisher.quantities.back() == 400.0,
+          "orders sized at leverage 1, then leverage 2");
+    check(consistent && switches == 1, "every signal saw one parameter version");
+    check(instance.tradesTheta(0.002), "no thetas trades every threshold");
+}
+
+void testRefusedUpdates() {
+    std::cout << "\n2. Updates that need a restart" << std::endl;
+    RcuDomain rcu;
+    CapturingPublisher publisher;
+    StrategyVariant strategy;
+    makeStrategy(DCTrendStrategy::kName, strategy);
+    StrategyInstance instance(0, strategy, trend(1.0), rcu, publisher, 64);
+
+    StrategyInstanceSettings contrarian{DCContrarianStrategy::kName, 1.0, false, {}, nullptr, false};
+    check(!instance.updateParameters(contrarian), "another strategy refused");
+
+    StrategyInstanceSettings subset = trend(1.0);
+    subset.thetas = {0.002};
+    subset.enable_hmm = true;
+    check(instance.updateParameters(subset) && instance.usesRegime(), "regime use updated");
+    check(instance.tradesTheta(0.002) && !instance.tradesTheta(0.004), "theta subset updated");
+}
+
+void testWatcher() {
+    std::cout << "\n3. Config file watcher" << std::endl;
+    char directory[] = "/tmp/config_watcher_XXXXXX";
+    check(::mkdtemp(directory) != nullptr, "temporary directory");
+    const std::string path = std::string(directory) + "/system_config.json";
+    const std::string staged = std::string(directory) + "/system_config.json.tmp";
+    const std::string other = std::string(directory) + "/other.json";
+    std::ofstream(path) << "{}";
+
+    ConfigWatcher watcher;
+    check(watcher.watch(path), "watching");
+    check(!watcher.changed(), "no change yet");
+
+    std::ofstream(path) << "{\"dc_strategy\": {\"theta\": 0.002}}";
+    std::ofstream(path, std::ios::app) << "\n";
+    check(watcher.changed(), "in-place write seen");
+    check(!watcher.changed(), "several writes reported once");
+
+    std::ofstream(other) << "{}";
+    check(!watcher.changed(), "other files ignored");
+
+    std::ofstream(staged) << "{\"dc_strategy\": {\"theta\": 0.003}}";
+    check(!watcher.changed(), "staged copy ignored");
+    check(std::rename(staged.c_str(), path.c_str()) == 0 && watcher.changed(), "rename over the file seen");
+
+    watcher.close();
+    std::remove(path.c_str());
+    std::remove(other.c_str());
+    ::rmdir(directory);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Parameter Reload Test ===" << std::endl;
+
+    testUpdateWhileRunning();
+    testRefusedUpdates();
+    testWatcher();
+
+    return testSummary();
+}
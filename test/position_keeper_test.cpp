@@ -0,0 +1,96 @@
+/**
+ * Position Keeper Test
+ * Checks per-symbol average-cost accounting (adds, partial closes, flips
+ * through flat) and that the incrementally maintained portfolio totals
+ * match a full scan after a long random sequence of fills and ticks.
+ *
+ * Build: g++ -std=c++17 -O2 -Iinclude test/position_keeper_test.cpp src/execution/PositionKeeper.cpp
+ */
+
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "execution/PositionKeeper.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+bool close(double a, double b, double tolerance = 1e-9) {
+    return std::fabs(a - b) <= tolerance * std::max(1.0, std::fabs(b));
+}
+
+void testAverageCost() {
+    std::cout << "\n1. Average cost accounting" << std::endl;
+    PositionKeeper keeper;
+
+    check(keeper.onFill(0, 100.0, 10.0) == 0.0, "opening fill realizes nothing");
+    keeper.onFill(0, 100.0, 12.0);
+    check(keeper.position(0) == 200.0 && close(keeper.averageCost(0), 11.0), "adding blends the cost");
+
+    check(close(keeper.onFill(0, -50.0, 13.0), 100.0), "partial close realizes against the cost");
+    check(keeper.position(0) == 150.0 && close(keeper.averageCost(0), 11.0), "cost unchanged on a reduce");
+
+    check(close(keeper.onFill(0, -200.0, 9.0), -300.0), "flip realizes the closed quantity only");
+    check(keeper.position(0) == -50.0 && close(keeper.averageCost(0), 9.0), "remainder opens at the fill price");
+
+    keeper.onPrice(0, 8.0);
+    check(close(keeper.unrealizedPnl(0), 50.0), "short gains when the price falls");
+    check(close(keeper.onFill(0, 50.0, 8.0), 50.0) && keeper.position(0) == 0.0 &&
+          keeper.unrealizedPnl(0) == 0.0, "closing to flat");
+    check(close(keeper.realizedPnl(0), -150.0) && close(keeper.portfolio().realized_pnl, -150.0),
+          "realized PnL accumulates per symbol and in total");
+}
+
+void testIncrementalTotals() {
+    std::cout << "\n2. Incremental portfolio totals" << std::endl;
+    constexpr SymbolId kSymbols = 50;
+    PositionKeeper keeper;
+    std::mt19937_64 rng(5);
+    std::uniform_int_distribution<SymbolId> symbol(0, kSymbols - 1);
+    std::uniform_int_distribution<int> lots(-5, 5);
+    std::normal_distribution<double> move(0.0, 0.001);
+    std::vector<double> prices(kSymbols, 100.0);
+
+    for (int i = 0; i < 200000; ++i) {
+        SymbolId id = symbol(rng);
+        prices[id] *= 1.0 + move(rng);
+        if (i % 3 == 0) {
+            keeper.onFill(id, 10.0 * lots(rng), prices[id]);
+        } else {
+            keeper.onPrice(id, prices[id]);
+        }
+    }
+
+    double unrealized = 0.0, gross = 0.0, net = 0.0, realized = 0.0;
+    std::size_t open = 0;
+    for (SymbolId id = 0; id < kSymbols; ++id) {
+        unrealized += keeper.unrealizedPnl(id);
+        realized += keeper.realizedPnl(id);
+        gross += std::fabs(keeper.position(id)) * keeper.lastPrice(id);
+        net += keeper.position(id) * keeper.lastPrice(id);
+        open += keeper.position(id) != 0.0 ? 1 : 0;
+    }
+
+    const PortfolioSnapshot& totals = keeper.portfolio();
+    check(close(totals.unrealized_pnl, unrealized, 1e-6) && close(totals.realized_pnl, realized, 1e-6),
+          "PnL totals match a full scan");
+    check(close(totals.gross_exposure, gross, 1e-6) && close(totals.net_exposure, net, 1e-6),
+          "exposure totals match a full scan");
+    check(totals.open_positions == open, "open position count");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Position Keeper Test ===" << std::endl;
+
+    testAverageCost();
+    testIncrementalTotals();
+
+    return testSummary();
+}
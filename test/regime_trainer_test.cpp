@@ -0,0 +1,162 @@
+/**
+ * Regime Trainer Test
+ * Checks the work-stealing pool, then trains per-symbol regime models from
+ * sampled DC features in parallel: each symbol's own model must be
+ * recovered, thin symbols must fall back to the default, and the result
+ * must not depend on the thread count.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/regime_trainer_test.cpp src/strategy/RegimeTrainer.cpp src/strategy/RegimeModel.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/WorkStealingPool.h"
+#include "strategy/RegimeTrainer.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+using Parameters = HmmParameters<2, kRegimeFeatures>;
+
+Parameters regimes(double volatile_tmv) {
+    Parameters p;
+    p.initial = {0.5, 0.5};
+    p.transition = {{{0.97, 0.03}, {0.05, 0.95}}};
+    p.mean = {{{-5.5, 2.0}, {volatile_tmv, 0.0}}};
+    p.variance = {{{0.05, 0.25}, {0.05, 0.25}}};
+    return p;
+}
+
+std::vector<RegimeObservation> sample(const Parameters& p, std::size_t length, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    std::vector<RegimeObservation> observations;
+    std::size_t state = uniform(rng) < p.initial[0] ? 0 : 1;
+    for (std::size_t t = 0; t < length; ++t) {
+        RegimeObservation x;
+        for (std::size_t d = 0; d < kRegimeFeatures; ++d) {
+            x[d] = p.mean[state][d] + std::sqrt(p.variance[state][d]) * normal(rng);
+        }
+        observations.push_back(x);
+        state = uniform(rng) < p.transition[state][0] ? 0 : 1;
+    }
+    return observations;
+}
+
+void testPool() {
+    std::cout << "\n1. Work-stealing pool" << std::endl;
+    WorkStealingPool pool(4);
+    std::atomic<int> sum{0};
+
+    // Tasks submitted from one task all land in that worker's deque; the
+    // other workers only get them by stealing
+    pool.submit([&]() {
+        for (int i = 1; i <= 200; ++i) {
+            pool.submit([&, i]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                sum.fetch_add(i);
+            });
+        }
+    });
+    pool.wait();
+
+    const WorkStealingPool::Statistics stats = pool.getStatistics();
+    std::cout << stats.executed << " tasks, " << stats.stolen << " stolen" << std::endl;
+    check(sum.load() == 200 * 201 / 2, "every nested task ran once");
+    check(stats.executed == 201, "executed count");
+    check(stats.stolen > 0, "idle workers stole queued tasks");
+
+    pool.wait();
+    check(true, "wait() with nothing pending returns");
+}
+
+void testTraining() {
+    std::cout << "\n2. Per-symbol training" << std::endl;
+    RegimeTrainer trainer;
+    const char* names[] = {"EURUSD", "GBPUSD", "USDJPY", "AUDUSD", "USDCHF", "NZDUSD"};
+    for (int s = 0; s < 6; ++s) {
+        // Each symbol's volatile regime sits at a different TMV level
+        trainer.addSequence(names[s], sample(regimes(-4.6 + 0.2 * s), 4000, 100 + s));
+    }
+    trainer.addSequence("THIN", sample(regimes(-4.0), 50, 99));
+    trainer.addSequence("EMPTY", {});
+
+    RegimeTrainingOptions options{2, 200, 1e-7, 4, 200, 4, 7};
+    RegimeModelSet models;
+    RegimeTrainingReport report;
+    auto start = std::chrono::steady_clock::now();
+    check(trainer.train(options, models, report), "training succeeded");
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << report.jobs << " jobs, " << report.converged_jobs << " converged, " << report.iterations
+              << " iterations, " << report.stolen_jobs << " stolen, " << std::fixed << std::setprecision(3)
+              << seconds << " s" << std::endl;
+    check(report.symbols == 7 && report.symbol_models == 6 && report.jobs == 28, "job and model counts");
+    check(report.converged_jobs == report.jobs, "every restart converged");
+    check(&models.lookup("THIN") == &models.lookup("UNKNOWN"), "thin symbol uses the default model");
+
+    // The volatile regime of each symbol should be found where it was sampled
+    bool recovered = true;
+    for (int s = 0; s < 6; ++s) {
+        RegimeBelief belief;
+        const RegimeModel& model = models.lookup(names[s]);
+        model.reset(belief);
+        recovered = recovered && model.update(belief, RegimeObservation{-4.6 + 0.2 * s, 0.0}) == 1 &&
+                    model.update(belief, RegimeObservation{-5.5, 2.0}) == 0;
+    }
+    check(recovered, "symbol models separate their regimes");
+
+    // Restarts are seeded by job, not by thread
+    options.threads = 1;
+    RegimeModelSet serial;
+    RegimeTrainingReport serial_report;
+    trainer.train(options, serial, serial_report);
+    const std::string parallel_path = "/tmp/regime_trainer_parallel.rhmm";
+    const std::string serial_path = "/tmp/regime_trainer_serial.rhmm";
+    models.save(parallel_path);
+    serial.save(serial_path);
+    RegimeModelSet a;
+    RegimeModelSet b;
+    std::string error;
+    a.load(parallel_path, error);
+    b.load(serial_path, error);
+    bool identical = serial_report.iterations == report.iterations;
+    for (int s = 0; s < 6; ++s) {
+        std::vector<double> va;
+        std::vector<double> vb;
+        a.lookup(names[s]).serialize(va);
+        b.lookup(names[s]).serialize(vb);
+        identical = identical && va == vb;
+    }
+    check(identical, "same models with 1 and 4 threads");
+    std::remove(parallel_path.c_str());
+    std::remove(serial_path.c_str());
+
+    options.states = 5;
+    check(!trainer.train(options, serial, serial_report), "unsupported state count refused");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Regime Trainer Test ===" << std::endl;
+
+    testPool();
+    testTraining();
+
+    return testSummary();
+}
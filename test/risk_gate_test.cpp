@@ -0,0 +1,152 @@
+/**
+ * Risk Gate Test
+ * Checks each pre-trade limit, swapping the limit table through RCU while
+ * another thread keeps checking orders, and times a check per order with
+ * 1000 symbols in the table.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/risk_gate_test.cpp src/strategy/RiskGate.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "strategy/RiskGate.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+constexpr std::int64_t kSecond = 1000000000;
+
+void testLimits() {
+    std::cout << "\n1. Limits" << std::endl;
+    RcuDomain domain;
+    RiskGate gate(domain, RiskLimits{250.0, 20000.0, 3, 100.0});
+
+    check(gate.check(0, "EURUSD", 100.0, 100.0, 0) == RiskCheckResult::ACCEPTED, "order inside every limit");
+    check(gate.check(0, "EURUSD", 250.0, 100.0, 1) == RiskCheckResult::MAX_NOTIONAL, "notional over the limit");
+    check(gate.check(0, "EURUSD", 200.0, 100.0, 2) == RiskCheckResult::MAX_POSITION, "projected position over the limit");
+    check(gate.position(0) == 100.0, "rejected orders leave the position alone");
+
+    gate.onPosition(0, 400.0);  // Reported position already over the limit
+    check(gate.check(0, "EURUSD", -100.0, 100.0, 3) == RiskCheckResult::ACCEPTED, "reducing an over-limit position");
+    gate.check(0, "EURUSD", -10.0, 100.0, 4);
+    check(gate.check(0, "EURUSD", -10.0, 100.0, 5) == RiskCheckResult::ORDER_RATE, "fourth order in one second");
+    check(gate.check(0, "EURUSD", -10.0, 100.0, kSecond) == RiskCheckResult::ACCEPTED, "rate window rolls over");
+
+    gate.onReferencePrice(0, 100.0);
+    check(gate.check(0, "EURUSD", -10.0, 101.5, kSecond + 1) == RiskCheckResult::PRICE_BAND, "price outside the band");
+    check(gate.check(0, "EURUSD", -10.0, 100.5, kSecond + 2) == RiskCheckResult::ACCEPTED, "price inside the band");
+
+    auto table = std::make_unique<RiskLimitTable>(RiskLimits{0.0, 0.0, 0, 0.0});
+    table->set("GBPUSD", RiskLimits{50.0, 0.0, 0, 0.0});
+    gate.updateLimits(std::move(table));
+    check(gate.check(1, "GBPUSD", 60.0, 1.0, 0) == RiskCheckResult::MAX_POSITION, "per-symbol override");
+    check(gate.check(0, "EURUSD", 1e6, 1e6, kSecond + 3) == RiskCheckResult::ACCEPTED, "zero disables a default limit");
+
+    const RiskGate::Statistics& stats = gate.getStatistics();
+    check(stats.checks == 11 && stats.rejected_notional == 1 && stats.rejected_position == 2 &&
+          stats.rejected_rate == 1 && stats.rejected_price_band == 1, "rejections counted by reason");
+}
+
+void testSwapWhileChecking() {
+    std::cout << "\n2. Limit table swaps while checking" << std::endl;
+    RcuDomain domain;
+    RiskGate gate(domain, RiskLimits{100.0, 0.0, 0, 0.0});
+    RcuDomain::ReaderId reader = domain.registerReader();
+
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> checked{0};
+    bool consistent = true;
+
+    std::thread checker([&]() {
+        domain.online(reader);
+        std::int64_t now = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            domain.quiescent(reader);
+            // Every table a writer publishes allows exactly max_position units
+            for (int i = 0; i < 64; ++i) {
+                gate.onPosition(0, 0.0);
+                const bool small = gate.check(0, "EURUSD", 10.0, 1.0, now++) == RiskCheckResult::ACCEPTED;
+                gate.onPosition(0, 0.0);
+                const bool large = gate.check(0, "EURUSD", 2000.0, 1.0, now++) == RiskCheckResult::ACCEPTED;
+                consistent = consistent && small && !large;
+            }
+            checked.fetch_add(128, std::memory_order_relaxed);
+        }
+        domain.offline(reader);
+    });
+
+    // Wait for the checker to start before the first swap
+    while (checked.load() == 0) {
+    }
+
+    constexpr int kSwaps = 200;
+    for (int swap = 0; swap < kSwaps; ++swap) {
+        auto table = std::make_unique<RiskLimitTable>(RiskLimits{100.0 + swap % 500, 0.0, 0, 0.0});
+        gate.updateLimits(std::move(table));
+    }
+    done.store(true);
+    checker.join();
+
+    std::cout << kSwaps << " swaps during " << checked.load() << " checks" << std::endl;
+    check(consistent, "every check saw a complete table");
+}
+
+void testCost() {
+    std::cout << "\n3. Cost per check (1000 symbols)" << std::endl;
+    constexpr int kSymbols = 1000;
+    constexpr int kOrders = 10000000;
+
+    RcuDomain domain;
+    RiskGate gate(domain, RiskLimits{1e9, 1e12, 0, 0.0});
+    auto table = std::make_unique<RiskLimitTable>(RiskLimits{1e9, 1e12, 1000000, 500.0});
+
+    std::vector<std::string> names;
+    for (int i = 0; i < kSymbols; ++i) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "SYM%05d", i);
+        names.emplace_back(name);
+        if (i % 2 == 0) {
+            table->set(name, RiskLimits{1e9, 1e12, 1000000, 1000.0});
+        }
+    }
+    gate.updateLimits(std::move(table));
+    for (SymbolId id = 0; id < kSymbols; ++id) {
+        gate.onReferencePrice(id, 100.0);
+    }
+
+    std::uint64_t accepted = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOrders; ++i) {
+        const SymbolId id = static_cast<SymbolId>((i * 7919u) % kSymbols);
+        const double quantity = (i & 1) ? 10.0 : -10.0;
+        accepted += gate.check(id, names[id].c_str(), quantity, 100.0 + (i & 7) * 0.01, i) == RiskCheckResult::ACCEPTED;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kOrders;
+
+    std::cout << std::fixed << std::setprecision(1) << ns << " ns/check, "
+              << accepted << " of " << kOrders << " accepted" << std::endl;
+    check(accepted == static_cast<std::uint64_t>(kOrders), "all benchmark orders accepted");
+    check(ns < 50.0, "check under 50 ns");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Risk Gate Test ===" << std::endl;
+
+    testLimits();
+    testSwapWhileChecking();
+    testCost();
+
+    return testSummary();
+}
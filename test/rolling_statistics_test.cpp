@@ -0,0 +1,148 @@
+/**
+ * Rolling Statistics Test
+ * Checks the O(1) rolling mean/variance/downside statistics against a
+ * full rescan of the window, checks the drawdown tracker, and times both
+ * approaches per fill for a 252-sample window.
+ *
+ * Build: g++ -std=c++17 -O2 -Iinclude test/rolling_statistics_test.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/RollingStatistics.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+struct Rescan {
+    double mean;
+    double stddev;
+    double downside;
+};
+
+Rescan rescan(const std::deque<double>& window) {
+    Rescan r{0.0, 0.0, 0.0};
+    for (double x : window) {
+        r.mean += x;
+        r.downside += x < 0.0 ? x * x : 0.0;
+    }
+    r.mean /= window.size();
+    r.downside = std::sqrt(r.downside / window.size());
+    double variance = 0.0;
+    for (double x : window) {
+        variance += (x - r.mean) * (x - r.mean);
+    }
+    r.stddev = window.size() > 1 ? std::sqrt(variance / (window.size() - 1)) : 0.0;
+    return r;
+}
+
+bool close(double a, double b) {
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b));
+}
+
+void testAgainstRescan() {
+    std::cout << "\n1. Matches a full rescan" << std::endl;
+    std::mt19937_64 rng(11);
+    std::normal_distribution<double> returns(0.0002, 0.01);
+
+    RollingStatistics stats(252);
+    std::deque<double> window;
+    bool matches = true;
+
+    for (int i = 0; i < 100000; ++i) {
+        // Shift the regime now and then so evictions move the mean a lot
+        double x = returns(rng) + ((i / 5000) % 2 ? 0.05 : 0.0);
+        stats.add(x);
+        window.push_back(x);
+        if (window.size() > 252) {
+            window.pop_front();
+        }
+        if (i % 97 == 0 || i < 300) {
+            Rescan r = rescan(window);
+            matches = matches && close(stats.mean(), r.mean) && close(stats.stddev(), r.stddev) &&
+                      close(stats.downsideDeviation(), r.downside);
+        }
+    }
+    check(matches, "mean, stddev and downside deviation agree over 100k samples");
+    check(stats.full() && stats.count() == 252, "window stays at capacity");
+    check(close(stats.sharpeRatio(), stats.mean() / stats.stddev()) &&
+          close(stats.sortinoRatio(), stats.mean() / stats.downsideDeviation()), "ratios");
+
+    RollingStatistics flat(4);
+    flat.add(1.0);
+    flat.add(1.0);
+    check(flat.sharpeRatio() == 0.0 && flat.sortinoRatio() == 0.0, "undefined ratios reported as 0");
+}
+
+void testDrawdown() {
+    std::cout << "\n2. Drawdown" << std::endl;
+    DrawdownTracker drawdown(100.0);
+    for (double equity : {110.0, 99.0, 105.0, 120.0, 108.0}) {
+        drawdown.update(equity);
+    }
+    check(close(drawdown.max(), 0.1) && close(drawdown.current(), 0.1) && drawdown.peak() == 120.0,
+          "peak-to-trough from the running peak");
+}
+
+void testCost() {
+    std::cout << "\n3. Cost per fill (252-sample window)" << std::endl;
+    constexpr int kFills = 2000000;
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> returns(0.0, 0.01);
+    std::vector<double> input(kFills);
+    for (double& x : input) {
+        x = returns(rng);
+    }
+
+    // Previous approach: vector with erase(begin()) and a full rescan per fill
+    std::vector<double> window;
+    double sink = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (double x : input) {
+        window.push_back(x);
+        if (window.size() > 252) {
+            window.erase(window.begin());
+        }
+        double mean = 0.0;
+        for (double v : window) mean += v;
+        mean /= window.size();
+        double variance = 0.0;
+        for (double v : window) variance += (v - mean) * (v - mean);
+        sink += window.size() > 1 ? mean / std::sqrt(variance / (window.size() - 1)) : 0.0;
+    }
+    double rescan_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kFills;
+
+    RollingStatistics stats(252);
+    start = std::chrono::steady_clock::now();
+    for (double x : input) {
+        stats.add(x);
+        sink += stats.sharpeRatio() + stats.sortinoRatio();
+    }
+    double rolling_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kFills;
+
+    std::cout << std::fixed << std::setprecision(1) << "Rescan: " << rescan_ns << " ns/fill, rolling: "
+              << rolling_ns << " ns/fill (" << (sink != 0.0 ? "ok" : "") << ")" << std::endl;
+    check(rolling_ns < rescan_ns, "rolling update is cheaper than a rescan");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Rolling Statistics Test ===" << std::endl;
+
+    testAgainstRescan();
+    testDrawdown();
+    testCost();
+
+    return testSummary();
+}
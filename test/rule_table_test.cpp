@@ -0,0 +1,191 @@
+/**
+ * Rule Table Test
+ * Compiles configured trading rules into a decision table: a rule set
+ * written to mirror DC_Strategy_v1 must trade exactly like it, first
+ * matching rule must win, position and TMV conditions must apply, bad
+ * rules must be refused, and a lookup must stay a few nanoseconds.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/rule_table_test.cpp src/strategy/RuleTable.cpp src/common/Logger.cpp -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "strategy/DCStrategies.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+Config::TradingRuleConfig rule(const std::string& event, const std::string& regime, double min_return,
+                               double max_return, const std::string& action, double size) {
+    return Config::TradingRuleConfig{event, regime, "any", min_return, max_return, -kInfinity, kInfinity,
+                                     action, size};
+}
+
+// DC_Strategy_v1 as rules; strict > 0 becomes >= the smallest positive double
+std::vector<Config::TradingRuleConfig> trendRules() {
+    const double above_zero = std::numeric_limits<double>::denorm_min();
+    return {
+        rule("upturn", "low", above_zero, kInfinity, "buy", 1.5),
+        rule("upturn", "high", above_zero, kInfinity, "buy", 0.5),
+        rule("upturn", "any", above_zero, kInfinity, "buy", 1.0),
+        rule("downturn", "low", -kInfinity, 0.0, "sell", 1.5),
+        rule("downturn", "high", -kInfinity, 0.0, "sell", 0.5),
+        rule("downturn", "any", -kInfinity, 0.0, "sell", 1.0),
+    };
+}
+
+DCSignalMessage signal(DCEventType type, double time_adjusted_return, double price, double tmv = 1.0) {
+    DCSignalMessage message{};
+    message.event_type = type;
+    message.time_adjusted_return = time_adjusted_return;
+    message.price = price;
+    message.tmv_ext = tmv;
+    return message;
+}
+
+struct Decision {
+    SignalType signal;
+    double quantity;
+};
+
+Decision decide(const StrategyVariant& strategy, const DCSignalMessage& message, const StrategyContext& context) {
+    return std::visit([&](const auto& s) {
+        const SignalType result = s.generateSignal(message, context);
+        return Decision{result, result != SignalType::NONE ? s.orderQuantity(message, context) : 0.0};
+    }, strategy);
+}
+
+void testMirrorsTrend() {
+    std::cout << "\n1. Rules mirroring DC_Strategy_v1" << std::endl;
+    auto table = std::make_shared<RuleTable>();
+    std::string error;
+    check(table->compile(trendRules(), error), "rules compile");
+    std::cout << table->rules() << " rules, " << table->cells() << " cells" << std::endl;
+
+    StrategyVariant rules;
+    StrategyVariant trend;
+    check(makeStrategy(DCRuleStrategy::kName, rules, table) && makeStrategy(DCTrendStrategy::kName, trend),
+          "rule strategy selected by name");
+    StrategyVariant unused;
+    check(!makeStrategy(DCRuleStrategy::kName, unused), "rule strategy refused without rules");
+
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> pick(0, 3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    const MarketState states[] = {MarketState::UNKNOWN, MarketState::LOW_VOLATILITY,
+                                  MarketState::HIGH_VOLATILITY, MarketState::NORMAL_VOLATILITY};
+    const DCEventType events[] = {DCEventType::NONE, DCEventType::UPTURN, DCEventType::DOWNTURN,
+                                  DCEventType::UPTURN};
+
+    int mismatches = 0;
+    for (int i = 0; i < 100000; ++i) {
+        const DCSignalMessage message = signal(events[pick(rng)], normal(rng), 20.0 + 100.0 * std::fabs(normal(rng)));
+        const StrategyContext context{states[pick(rng)], 1.0 + pick(rng) * 0.5, normal(rng) * 100.0};
+        const Decision a = decide(rules, message, context);
+        const Decision b = decide(trend, message, context);
+        mismatches += (a.signal != b.signal || a.quantity != b.quantity) ? 1 : 0;
+    }
+    check(mismatches == 0, "same signals and sizes over 100000 random signals");
+}
+
+void testConditions() {
+    std::cout << "\n2. Conditions and precedence" << std::endl;
+    std::vector<Config::TradingRuleConfig> spec = {
+        // Only add to a long on a large move, never flip it on an upturn
+        {"upturn", "any", "long", -kInfinity, kInfinity, 0.01, kInfinity, "buy", 2.0},
+        {"upturn", "any", "long", -kInfinity, kInfinity, -kInfinity, kInfinity, "none", 1.0},
+        {"upturn", "any", "any", -kInfinity, kInfinity, -kInfinity, kInfinity, "buy", 1.0},
+        {"downturn", "any", "flat", -kInfinity, kInfinity, -kInfinity, kInfinity, "sell", 1.0},
+    };
+    RuleTable table;
+    std::string error;
+    check(table.compile(spec, error), "rules compile");
+
+    auto lookup = [&](DCEventType type, double tmv, double position) {
+        return table.lookup(signal(type, 0.1, 10.0, tmv), StrategyContext{MarketState::UNKNOWN, 1.0, position});
+    };
+    check(lookup(DCEventType::UPTURN, 0.02, 100.0).signal == SignalType::BUY &&
+          lookup(DCEventType::UPTURN, 0.02, 100.0).size == 2.0f, "long, large move adds");
+    check(lookup(DCEventType::UPTURN, -0.02, 100.0).size == 2.0f, "|TMV| is used");
+    check(lookup(DCEventType::UPTURN, 0.005, 100.0).signal == SignalType::NONE, "long, small move holds");
+    check(lookup(DCEventType::UPTURN, 0.005, 0.5).signal == SignalType::BUY, "flat falls through to later rule");
+    check(lookup(DCEventType::DOWNTURN, 0.005, -5.0).signal == SignalType::NONE, "no matching rule, no trade");
+    check(lookup(DCEventType::DOWNTURN, 0.005, 0.0).signal == SignalType::SELL, "flat sells on downturn");
+    check(lookup(DCEventType::NONE, 0.02, 100.0).signal == SignalType::NONE, "non-events never trade");
+}
+
+void testErrors() {
+    std::cout << "\n3. Malformed rules" << std::endl;
+    RuleTable table;
+    std::string error;
+    table.compile(trendRules(), error);
+    const std::size_t cells = table.cells();
+
+    check(!table.compile({rule("sideways", "any", -kInfinity, kInfinity, "buy", 1.0)}, error), "unknown event");
+    std::cout << "  " << error << std::endl;
+    check(!table.compile({rule("upturn", "calm", -kInfinity, kInfinity, "buy", 1.0)}, error), "unknown regime");
+    check(!table.compile({rule("upturn", "any", -kInfinity, kInfinity, "short", 1.0)}, error), "unknown action");
+    check(!table.compile({rule("upturn", "any", 1.0, 1.0, "buy", 1.0)}, error), "empty range");
+    check(!table.compile({rule("upturn", "any", -kInfinity, kInfinity, "buy", 0.0)}, error), "zero size");
+
+    std::vector<Config::TradingRuleConfig> many;
+    for (int i = 0; i < 16; ++i) {
+        many.push_back(rule("upturn", "any", i, i + 0.5, "buy", 1.0));
+    }
+    check(!table.compile(many, error), "too many bounds");
+    std::cout << "  " << error << std::endl;
+    check(table.cells() == cells, "failed compile keeps the previous table");
+}
+
+void testCost() {
+    std::cout << "\n4. Cost per signal (benchmark)" << std::endl;
+    auto table = std::make_shared<RuleTable>();
+    std::string error;
+    table->compile(trendRules(), error);
+    StrategyVariant strategy;
+    makeStrategy(DCRuleStrategy::kName, strategy, table);
+
+    std::vector<DCSignalMessage> messages;
+    for (int i = 0; i < 1024; ++i) {
+        messages.push_back(signal(i % 3 == 0 ? DCEventType::UPTURN : DCEventType::DOWNTURN,
+                                  (i % 5) - 2.0, 50.0 + i % 100));
+    }
+    const StrategyContext context{MarketState::NORMAL_VOLATILITY, 1.0, 0.0};
+
+    constexpr int kSignals = 20000000;
+    double total = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kSignals; ++i) {
+        total += decide(strategy, messages[i & 1023], context).quantity;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kSignals;
+
+    // Reported, not checked: timing depends on the machine and its load
+    std::cout << std::fixed << std::setprecision(2) << ns << " ns/signal (budget 30 ns), checksum " << total
+              << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Rule Table Test ===" << std::endl;
+
+    testMirrorsTrend();
+    testConditions();
+    testErrors();
+    testCost();
+
+    return testSummary();
+}
@@ -0,0 +1,228 @@
+/**
+ * Strategy Fan-out Test
+ * Checks the SPSC ring that feeds strategy worker threads, then runs two
+ * strategy instances over the same decoded signals: orders must carry each
+ * instance's id, theta subsets must be honoured and each instance must
+ * track its own position from its own fills. Signals of synthetic
+ * instruments reach only instances that opted in.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/strategy_fanout_test.cpp src/strategy/StrategyInstance.cpp src/strategy/OrderBatcher.cpp src/strategy/RiskGate.cpp src/common/TimeUtils.cpp src/common/Logger.cpp -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/SpscRing.h"
+#include "strategy/StrategyInstance.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+class CapturingPublisher : public OrderPublisher {
+public:
+    bool publish(const std::uint8_t* data, std::size_t length) override {
+        if (length == sizeof(TradingOrder)) {
+            TradingOrder order;
+            std::memcpy(&order, data, sizeof(order));
+            orders.push_back(order);
+        }
+        return true;
+    }
+
+    std::vector<TradingOrder> orders;
+};
+
+DCSignalMessage signal(DCEventType type, double theta) {
+    DCSignalMessage message{};
+    message.event_type = type;
+    message.time_adjusted_return = type == DCEventType::UPTURN ? 0.5 : -0.5;
+    message.price = 10.0;
+    message.theta = theta;
+    std::strncpy(message.symbol, "EURUSD", sizeof(message.symbol) - 1);
+    return message;
+}
+
+ExecutionReport fill(const TradingOrder& order) {
+    ExecutionReport report{};
+    report.quantity = order.quantity;
+    report.position = 12345.0;  // Engine-wide; instances sharing a symbol must ignore it
+    std::memcpy(report.symbol, order.symbol, sizeof(report.symbol));
+    report.signal = order.signal;
+    report.strategy_id = order.strategy_id;
+    report.status = ExecutionStatus::FILLED;
+    return report;
+}
+
+void testRing() {
+    std::cout << "\n1. SPSC ring" << std::endl;
+    SpscRing<int> small(3);
+    check(small.capacity() == 4, "capacity rounded to a power of two");
+    int value = 0;
+    check(!small.tryPop(value), "empty ring pops nothing");
+    for (int i = 0; i < 4; ++i) {
+        small.tryPush(i);
+    }
+    check(!small.tryPush(4), "full ring refuses a push");
+    check(small.tryPop(value) && value == 0 && small.tryPush(4), "pop frees a slot");
+
+    constexpr int kEvents = 5000000;
+    SpscRing<std::uint64_t> ring(4096);
+    std::uint64_t sum = 0;
+    bool ordered = true;
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]() {
+        std::uint64_t expected = 0;
+        std::uint64_t item = 0;
+        while (expected < kEvents) {
+            if (ring.tryPop(item)) {
+                ordered = ordered && item == expected;
+                sum += item;
+                expected++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (std::uint64_t i = 0; i < kEvents; ++i) {
+        while (!ring.tryPush(i)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kEvents;
+
+    std::cout << std::fixed << std::setprecision(2) << ns << " ns/event across threads" << std::endl;
+    check(ordered && sum == static_cast<std::uint64_t>(kEvents) * (kEvents - 1) / 2, "every event once, in order");
+}
+
+void testFanout() {
+    std::cout << "\n2. Two strategies over one signal stream" << std::endl;
+    RcuDomain rcu;
+    RcuDomain::ReaderId reader = rcu.registerReader();
+    CapturingPublisher publisher;
+
+    StrategyVariant trend;
+    StrategyVariant contrarian;
+    makeStrategy("DC_Strategy_v1", trend);
+    makeStrategy("DC_Contrarian_v1", contrarian);
+    StrategyInstance a(0, trend, StrategyInstanceSettings{"DC_Strategy_v1", 2.0, false, {}, nullptr, false},
+                       rcu, publisher, 64);
+    const StrategyInstanceSettings contrarian_settings{"DC_Contrarian_v1", 1.0, true, {0.002}, nullptr, false};
+    StrategyInstance b(1, contrarian, contrarian_settings, rcu, publisher, 64);
+    for (StrategyInstance* instance : {&a, &b}) {
+        instance->setReportMode(true, true);
+        instance->enableRiskChecks(false);
+    }
+    rcu.online(reader);
+
+    check(a.tradesTheta(0.004) && a.tradesTheta(0.002), "no subset trades every theta");
+    check(b.tradesTheta(0.002) && !b.tradesTheta(0.004), "subset trades only its thetas");
+
+    // The engine hands the same decoded signal to every instance
+    auto deliver = [&](const DCSignalMessage& message, MarketState state) {
+        for (StrategyInstance* instance : {&a, &b}) {
+            if (instance->tradesSignal(message)) {
+                instance->onSignal(message, 0, state, 1.0, 0);
+            }
+        }
+    };
+
+    deliver(signal(DCEventType::UPTURN, 0.002), MarketState::LOW_VOLATILITY);
+    check(publisher.orders.size() == 2, "both strategies traded the signal");
+    const TradingOrder first = publisher.orders[0];
+    const TradingOrder second = publisher.orders[1];
+    check(first.strategy_id == 0 && first.signal == SignalType::BUY && first.quantity == 200.0,
+          "trend order tagged 0, regime ignored");
+    check(second.strategy_id == 1 && second.signal == SignalType::SELL && second.quantity == 50.0,
+          "contrarian order tagged 1, sized by regime");
+
+    deliver(signal(DCEventType::DOWNTURN, 0.004), MarketState::LOW_VOLATILITY);
+    check(publisher.orders.size() == 2, "signals wait for working orders");
+    check(a.getStatistics().signals_processed == 2 && b.getStatistics().signals_processed == 1,
+          "per-strategy signal counts");
+
+    // Each instance's fills come back to it alone
+    a.onExecutionReport(fill(first), 0);
+    b.onExecutionReport(fill(second), 0);
+    deliver(signal(DCEventType::UPTURN, 0.002), MarketState::LOW_VOLATILITY);
+    check(publisher.orders.size() == 2, "own filled positions already at target");
+
+    deliver(signal(DCEventType::DOWNTURN, 0.002), MarketState::LOW_VOLATILITY);
+    check(publisher.orders.size() == 4, "both reverse");
+    check(publisher.orders[2].strategy_id == 0 && publisher.orders[2].quantity == 400.0,
+          "trend reverses its own 200");
+    check(publisher.orders[3].strategy_id == 1 && publisher.orders[3].quantity == 100.0,
+          "contrarian reverses its own -50");
+
+    const StrategyStatistics stats = a.getStatistics();
+    check(stats.orders_generated == 2 && stats.execution_reports == 1 && stats.orders_suppressed == 2,
+          "per-strategy order counts");
+    rcu.offline(reader);
+
+    check(offsetof(TradeExecution, executed_price) == 24 && sizeof(ExecutionReport) == 64,
+          "tags fit in existing padding");
+}
+
+void testSyntheticSignals() {
+    std::cout << "\n3. Synthetic instruments' signals" << std::endl;
+    RcuDomain rcu;
+    RcuDomain::ReaderId reader = rcu.registerReader();
+    CapturingPublisher publisher;
+
+    StrategyVariant trend;
+    makeStrategy("DC_Strategy_v1", trend);
+    StrategyInstance real_only(0, trend, StrategyInstanceSettings{"DC_Strategy_v1", 1.0, false, {}, nullptr, false},
+                               rcu, publisher, 64);
+    StrategyInstance opted_in(1, trend, StrategyInstanceSettings{"DC_Strategy_v1", 1.0, false, {}, nullptr, true},
+                              rcu, publisher, 64);
+    for (StrategyInstance* instance : {&real_only, &opted_in}) {
+        instance->setReportMode(false, false);
+        instance->enableRiskChecks(false);
+    }
+    rcu.online(reader);
+
+    DCSignalMessage synthetic = signal(DCEventType::UPTURN, 0.004);
+    std::strncpy(synthetic.symbol, "EURGBP_X", sizeof(synthetic.symbol) - 1);
+    synthetic.synthetic = 1;
+    const DCSignalMessage real = signal(DCEventType::UPTURN, 0.004);
+    check(!real_only.tradesSignal(synthetic) && real_only.tradesSignal(real), "synthetics not traded by default");
+    check(opted_in.tradesSignal(synthetic) && opted_in.tradesSignal(real), "opted-in instance trades both");
+
+    // Delivered the way StrategyEngine::run delivers them
+    for (StrategyInstance* instance : {&real_only, &opted_in}) {
+        if (instance->tradesSignal(synthetic)) {
+            instance->onSignal(synthetic, 1, MarketState::UNKNOWN, 1.0, 0);
+        }
+    }
+    check(publisher.orders.size() == 1 && publisher.orders[0].strategy_id == 1,
+          "only the opted-in instance orders the synthetic");
+    check(real_only.getStatistics().signals_processed == 0, "other instance never sees it");
+    rcu.offline(reader);
+
+    // A reload waits for a grace period, so it runs with the reader offline
+    const StrategyInstanceSettings reloaded{"DC_Strategy_v1", 1.0, false, {}, nullptr, true};
+    check(real_only.updateParameters(reloaded) && real_only.tradesSignal(synthetic), "opt-in follows a reload");
+
+    check(offsetof(DCSignalMessage, price) == 16 && sizeof(DCSignalMessage) == 112, "flag fits in existing padding");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Strategy Fan-out Test ===" << std::endl;
+
+    testRing();
+    testFanout();
+    testSyntheticSignals();
+
+    return testSummary();
+}
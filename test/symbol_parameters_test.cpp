@@ -0,0 +1,202 @@
+/**
+ * Symbol Parameters Test
+ * Loads per-symbol thresholds and leverage: unlisted symbols must inherit
+ * the defaults, bad rows must be refused without touching the table, a
+ * symbol's leverage must scale every strategy's orders, and at 10k
+ * symbols resolving parameters once per symbol must leave ticks at one
+ * indexed load.
+ *
+ * Build: g++ -std=c++17 -O3 -pthread -Iinclude test/symbol_parameters_test.cpp src/common/SymbolParameters.cpp src/common/DCIndicator.cpp src/strategy/StrategyInstance.cpp src/strategy/OrderBatcher.cpp src/strategy/RiskGate.cpp src/strategy/RuleTable.cpp src/common/TimeUtils.cpp src/common/Logger.cpp -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/DCIndicator.h"
+#include "common/SymbolParameters.h"
+#include "strategy/StrategyInstance.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+class CapturingPublisher : public OrderPublisher {
+public:
+    bool publish(const std::uint8_t* data, std::size_t length) override {
+        if (length == sizeof(TradingOrder)) {
+            TradingOrder order;
+            std::memcpy(&order, data, sizeof(order));
+            quantities.push_back(order.quantity);
+        }
+        return true;
+    }
+
+    std::vector<double> quantities;
+};
+
+std::string symbolName(int i) {
+    char name[kSymbolLength + 1];
+    std::snprintf(name, sizeof(name), "SYM%05d", i);
+    return name;
+}
+
+void testLoad() {
+    std::cout << "\n1. Loading and inheritance" << std::endl;
+    SymbolParameterTable table(SymbolParameters{0.004, 1.0});
+    std::string error;
+    check(table.load({{"EURCHF", 0.002, 1.5}, {"GBPJPY", 0.008, 0.5}}, error), "rows load");
+    check(table.size() == 2, "two symbols with their own row");
+    check(table.lookup("EURCHF").theta == 0.002 && table.lookup("EURCHF").leverage_factor == 1.5,
+          "listed symbol has its own row");
+    check(table.lookup("EURUSD").theta == 0.004 && table.lookup("EURUSD").leverage_factor == 1.0,
+          "unlisted symbol inherits the defaults");
+
+    check(!table.load({{"AUDUSD", 0.0, 1.0}}, error), "zero theta refused");
+    std::cout << "  " << error << std::endl;
+    check(!table.load({{"AUDUSD", 1.5, 1.0}}, error), "theta of 100% or more refused");
+    check(!table.load({{"AUDUSD", 0.004, -1.0}}, error), "negative leverage refused");
+    check(!table.load({{"", 0.004, 1.0}}, error), "empty symbol refused");
+    check(!table.load({{"A_VERY_LONG_SYMBOL_NAME", 0.004, 1.0}}, error), "overlong symbol refused");
+    SymbolParameterTable longest(SymbolParameters{0.004, 1.0});
+    check(!table.load({{"SIXTEEN_CHARS_XY", 0.004, 1.0}}, error) &&
+          longest.load({{"FIFTEEN_CHARS_X", 0.004, 1.0}}, error), "names fit a null-terminated char[16]");
+    check(!table.load({{"AUDUSD", 0.004, 1.0}, {"AUDUSD", 0.003, 1.0}}, error), "repeated symbol refused");
+    std::cout << "  " << error << std::endl;
+    check(!table.load({{"NZDUSD", 0.003, 1.0}, {"AUDUSD", 2.0, 1.0}}, error) &&
+          table.size() == 2 && table.lookup("NZDUSD").theta == 0.004, "failed load adds nothing");
+
+    SymbolParameterTable bad_defaults(SymbolParameters{0.0, 1.0});
+    check(!bad_defaults.load({}, error), "bad defaults refused");
+}
+
+void testSymbolLeverage() {
+    std::cout << "\n2. Symbol leverage scales strategy leverage" << std::endl;
+    RcuDomain rcu;
+    RcuDomain::ReaderId reader = rcu.registerReader();
+    CapturingPublisher publisher;
+    StrategyVariant strategy;
+    makeStrategy(DCTrendStrategy::kName, strategy);
+    const StrategyInstanceSettings settings{DCTrendStrategy::kName, 2.0, false, {}, nullptr, false};
+    StrategyInstance instance(0, strategy, settings, rcu, publisher, 64);
+    instance.setReportMode(false, false);
+    instance.enableRiskChecks(false);
+    rcu.online(reader);
+
+    DCSignalMessage message{};
+    message.event_type = DCEventType::UPTURN;
+    message.time_adjusted_return = 0.5;
+    message.price = 10.0;
+    instance.onSignal(message, 0, MarketState::UNKNOWN, 1.0, 0);
+    instance.onSignal(message, 1, MarketState::UNKNOWN, 0.25, 0);
+    rcu.offline(reader);
+
+    check(publisher.quantities.size() == 2 && publisher.quantities[0] == 200.0 && publisher.quantities[1] == 50.0,
+          "strategy leverage 2 times symbol leverage 0.25");
+}
+
+void testTenThousandSymbols() {
+    std::cout << "\n3. 10k symbols" << std::endl;
+    constexpr int kSymbols = 10000;
+    std::mt19937_64 rng(46);
+    std::uniform_real_distribution<double> thetas(0.001, 0.02);
+
+    std::vector<Config::SymbolParameterConfig> rows;
+    for (int i = 0; i < kSymbols; ++i) {
+        rows.push_back({symbolName(i), thetas(rng), 0.5 + (i % 4) * 0.25});
+    }
+    SymbolParameterTable table(SymbolParameters{0.004, 1.0});
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    check(table.load(rows, error), "10k rows load");
+    double load_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Engine ids come in arrival order, unrelated to the config order
+    std::vector<int> arrival(kSymbols);
+    for (int i = 0; i < kSymbols; ++i) {
+        arrival[i] = i;
+    }
+    std::shuffle(arrival.begin(), arrival.end(), rng);
+    SymbolTable symbols(16384);
+    std::vector<std::string> names;
+    for (int i : arrival) {
+        symbols.findOrInsert(symbolName(i).c_str());
+        names.push_back(symbolName(i));
+    }
+
+    // What a reload costs the engine thread: one lookup per known symbol
+    std::vector<DCIndicator> indicators(kSymbols);
+    std::vector<double> leverage(kSymbols);
+    start = std::chrono::steady_clock::now();
+    for (SymbolId id = 0; id < kSymbols; ++id) {
+        const SymbolParameters& parameters = table.lookup(symbols.name(id).c_str());
+        indicators[id].setTheta(parameters.theta);
+        leverage[id] = parameters.leverage_factor;
+    }
+    double flatten_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    bool resolved = true;
+    for (SymbolId id = 0; id < kSymbols; ++id) {
+        const int row = arrival[id];
+        resolved = resolved && indicators[id].getTheta() == rows[row].theta &&
+                   leverage[id] == rows[row].leverage_factor;
+    }
+    check(resolved, "every engine id resolved to its own row");
+
+    // Per tick: the flattened load against probing the table by name
+    constexpr int kTicks = 20000000;
+    std::vector<SymbolId> ticks(1 << 16);
+    for (SymbolId& id : ticks) {
+        id = static_cast<SymbolId>(rng() % kSymbols);
+    }
+    double sum = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTicks; ++i) {
+        sum += leverage[ticks[i & 0xFFFF]];
+    }
+    double dense_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kTicks;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTicks; ++i) {
+        sum += table.lookup(names[ticks[i & 0xFFFF]].c_str()).leverage_factor;
+    }
+    double probe_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kTicks;
+
+    // Detection with a different theta per symbol
+    std::normal_distribution<double> step(0.0, 0.001);
+    std::vector<double> prices(kSymbols, 100.0);
+    std::uint64_t events = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTicks / 10; ++i) {
+        const SymbolId id = ticks[i & 0xFFFF];
+        prices[id] *= 1.0 + step(rng);
+        events += indicators[id].processDataPoint(MarketDataPoint(i, prices[id])).type != DCEventType::NONE;
+    }
+    double tick_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                     (kTicks / 10);
+
+    std::cout << std::fixed << std::setprecision(2) << "load " << load_ms << " ms, reload " << flatten_ms
+              << " ms; leverage " << dense_ns << " ns/tick flattened vs " << probe_ns << " ns/tick probed; "
+              << "DC detection " << tick_ns << " ns/tick, " << events << " events, checksum " << sum << std::endl;
+    check(flatten_ms < 50.0, "reload of 10k symbols under 50 ms");
+    check(dense_ns < probe_ns, "flattened load cheaper than a table probe");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Symbol Parameters Test ===" << std::endl;
+
+    testLoad();
+    testSymbolLeverage();
+    testTenThousandSymbols();
+
+    return testSummary();
+}
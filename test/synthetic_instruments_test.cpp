@@ -0,0 +1,328 @@
+/**
+ * Synthetic Instruments Test
+ * Prices spreads, ratios and baskets from their legs' ticks: the running
+ * values must match a sum over every leg, a synthetic must wait for all
+ * its legs, a tick must reach exactly the synthetics built on its symbol,
+ * bad definitions must be refused, a spread must give DC events of its
+ * own, and with thousands of synthetics a tick must stay cheap and
+ * allocate nothing. Also loads the shipped configuration's synthetics.
+ * Run from the repository root.
+ *
+ * Build: g++ -std=c++17 -O3 -march=native -pthread -Iinclude test/synthetic_instruments_test.cpp src/market_data/SyntheticInstruments.cpp src/common/DCIndicator.cpp \
+ *            src/common/Config.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/DCIndicator.h"
+#include "market_data/SyntheticInstruments.h"
+
+#define TEST_HARNESS_COUNT_ALLOCATIONS
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+bool near(double a, double b) {
+    return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b));
+}
+
+void testValues() {
+    std::cout << "\n1. Spread, ratio and basket values" << std::endl;
+    SymbolTable symbols(64);
+    SyntheticInstruments synthetics;
+    std::string error;
+    check(synthetics.configure({
+              {"EURUSD_GBPUSD", "spread", 1.0, {{"EURUSD", 1.0}, {"GBPUSD", 0.85}}},
+              {"EURGBP_X", "ratio", 0.0, {{"EURUSD", 1.0}, {"GBPUSD", 1.0}}},
+              {"USD_BASKET", "basket", 0.0, {{"EURUSD", 0.5}, {"GBPUSD", 0.3}, {"AUDUSD", -0.2}}}},
+              symbols, error), "synthetics configured");
+    const SymbolId eurusd = symbols.find("EURUSD");
+    const SymbolId gbpusd = symbols.find("GBPUSD");
+    const SymbolId audusd = symbols.find("AUDUSD");
+    check(symbols.find("EURGBP_X") != kInvalidSymbolId && synthetics.isSynthetic(symbols.find("EURGBP_X")) &&
+          !synthetics.isSynthetic(eurusd), "synthetics have symbol ids of their own");
+    check(synthetics.dependents(eurusd) == 3 && synthetics.dependents(audusd) == 1, "legs know their synthetics");
+
+    std::vector<SymbolId> priced;
+    auto collect = [&](SymbolId id, double) { priced.push_back(id); };
+    synthetics.onTick(eurusd, 1.08, collect);
+    check(priced.empty() && !synthetics.priced(0), "nothing priced with one leg");
+    synthetics.onTick(gbpusd, 1.27, collect);
+    check(priced.size() == 2 && synthetics.priced(0) && synthetics.priced(1) && !synthetics.priced(2),
+          "spread and ratio priced once both legs are");
+    check(near(synthetics.value(0), 1.08 - 0.85 * 1.27 + 1.0), "spread w0*p0 - w1*p1 + offset");
+    check(near(synthetics.value(1), 1.08 / 1.27), "ratio p0 / p1");
+    synthetics.onTick(audusd, 0.66, collect);
+    check(near(synthetics.value(2), 0.5 * 1.08 + 0.3 * 1.27 - 0.2 * 0.66), "basket sum wi*pi");
+    synthetics.onTick(eurusd, 0.0, collect);
+    check(near(synthetics.value(1), 1.08 / 1.27), "non-positive prices ignored");
+
+    // Running sums against a full recompute over a long random walk, past many refreshes
+    std::mt19937_64 rng(50);
+    std::normal_distribution<double> normal(0.0, 0.0005);
+    double prices[3] = {1.08, 1.27, 0.66};
+    const SymbolId ids[3] = {eurusd, gbpusd, audusd};
+    double worst = 0.0;
+    for (int i = 0; i < 200000; ++i) {
+        const int leg = static_cast<int>(rng() % 3);
+        prices[leg] *= std::exp(normal(rng));
+        synthetics.onTick(ids[leg], prices[leg], [](SymbolId, double) {});
+        for (std::size_t s = 0; s < synthetics.size(); ++s) {
+            worst = std::max(worst, std::fabs(synthetics.value(s) - synthetics.recompute(s)));
+        }
+    }
+    std::cout << std::scientific << std::setprecision(2) << "largest drift from a full recompute " << worst
+              << std::defaultfloat << std::endl;
+    check(worst < 1e-12, "incremental values equal full recomputes");
+    check(near(synthetics.recompute(1), prices[0] / prices[1]), "recompute reads the last leg prices");
+}
+
+void testDependencies() {
+    std::cout << "\n2. A tick touches only its dependents" << std::endl;
+    constexpr int kSymbols = 300;
+    constexpr int kSynthetics = 600;
+    std::mt19937_64 rng(5);
+    auto name = [](const char* prefix, int i) {
+        char buffer[kSymbolLength + 1];
+        std::snprintf(buffer, sizeof(buffer), "%s%05d", prefix, i);
+        return std::string(buffer);
+    };
+    std::vector<Config::SyntheticConfig> definitions;
+    std::vector<std::vector<int>> legs_of(kSynthetics);
+    for (int s = 0; s < kSynthetics; ++s) {
+        Config::SyntheticConfig definition{name("SYN", s), "basket", 0.0, {}};
+        const int legs = 1 + static_cast<int>(rng() % 6);
+        while (static_cast<int>(definition.legs.size()) < legs) {
+            const int leg = static_cast<int>(rng() % kSymbols);
+            bool listed = false;
+            for (int other : legs_of[s]) {
+                listed = listed || other == leg;
+            }
+            if (!listed) {
+                legs_of[s].push_back(leg);
+                definition.legs.push_back({name("SYM", leg), 1.0});
+            }
+        }
+        definitions.push_back(definition);
+    }
+
+    SymbolTable symbols(4096);
+    SyntheticInstruments synthetics;
+    std::string error;
+    check(synthetics.configure(definitions, symbols, error), "600 baskets over 300 symbols");
+    for (int leg = 0; leg < kSymbols; ++leg) {
+        synthetics.onTick(symbols.find(name("SYM", leg).c_str()), 1.0, [](SymbolId, double) {});
+    }
+
+    int mismatches = 0;
+    for (int leg = 0; leg < kSymbols; ++leg) {
+        std::vector<SymbolId> expected;
+        for (int s = 0; s < kSynthetics; ++s) {
+            for (int other : legs_of[s]) {
+                if (other == leg) {
+                    expected.push_back(symbols.find(name("SYN", s).c_str()));
+                }
+            }
+        }
+        std::vector<SymbolId> touched;
+        synthetics.onTick(symbols.find(name("SYM", leg).c_str()), 1.5, [&](SymbolId id, double) {
+            touched.push_back(id);
+        });
+        mismatches += touched != expected ? 1 : 0;
+    }
+    check(mismatches == 0, "each tick reaches exactly the synthetics using its symbol, in order");
+    check(synthetics.dependents(symbols.findOrInsert("UNRELATED")) == 0, "other symbols reach none");
+}
+
+void testErrors() {
+    std::cout << "\n3. Invalid definitions" << std::endl;
+    SymbolTable symbols(64);
+    SyntheticInstruments synthetics;
+    std::string error;
+    synthetics.configure({{"S1", "spread", 0.0, {{"A", 1.0}, {"B", 1.0}}}}, symbols, error);
+
+    check(!synthetics.configure({{"S2", "butterfly", 0.0, {{"A", 1.0}, {"B", 1.0}}}}, symbols, error),
+          "unknown type refused");
+    std::cout << "  " << error << std::endl;
+    check(!synthetics.configure({{"S2", "spread", 0.0, {{"A", 1.0}}}}, symbols, error), "one-legged spread refused");
+    check(!synthetics.configure({{"S2", "basket", 0.0, {}}}, symbols, error), "empty basket refused");
+    check(!synthetics.configure({{"S2", "basket", 0.0, std::vector<Config::SyntheticLegConfig>(17, {"A", 1.0})}},
+                                symbols, error), "basket over 16 legs refused");
+    check(!synthetics.configure({{"S2", "basket", 0.0, {{"A", 1.0}, {"A", 2.0}}}}, symbols, error),
+          "repeated leg refused");
+    check(!synthetics.configure({{"S2", "ratio", 0.0, {{"A", 1.0}, {"B", -1.0}}}}, symbols, error),
+          "negative ratio weight refused");
+    check(!synthetics.configure({{"S2", "ratio", 1.0, {{"A", 1.0}, {"B", 1.0}}}}, symbols, error),
+          "ratio offset refused");
+    check(!synthetics.configure({{"S2", "basket", 0.0, {{"A", 0.0}}}}, symbols, error), "zero weight refused");
+    check(!synthetics.configure({{"S2", "spread", 0.0, {{"A", 1.0}, {"B", 1.0}}},
+                                 {"S3", "spread", 0.0, {{"S2", 1.0}, {"B", 1.0}}}}, symbols, error),
+          "synthetic of a synthetic refused");
+    std::cout << "  " << error << std::endl;
+    check(!synthetics.configure({{"S2", "spread", 0.0, {{"A", 1.0}, {"B", 1.0}}},
+                                 {"S2", "spread", 0.0, {{"A", 1.0}, {"C", 1.0}}}}, symbols, error),
+          "repeated name refused");
+    check(!synthetics.configure({{"A_VERY_LONG_SYNTHETIC", "spread", 0.0, {{"A", 1.0}, {"B", 1.0}}}}, symbols, error),
+          "overlong name refused");
+    check(!synthetics.configure({{"SIXTEEN_CHARS_XY", "spread", 0.0, {{"A", 1.0}, {"B", 1.0}}}}, symbols, error),
+          "16-character name refused, as char[16] messages truncate it");
+    check(synthetics.size() == 1 && synthetics.dependents(symbols.find("A")) == 1,
+          "failed configure keeps the current synthetics");
+    check(symbols.find("S2") == kInvalidSymbolId && symbols.find("C") == kInvalidSymbolId,
+          "failed configure adds no symbols");
+
+    SymbolTable small(2);
+    check(!synthetics.configure({{"S2", "spread", 0.0, {{"A", 1.0}, {"B", 1.0}}}}, small, error),
+          "full symbol table refused");
+}
+
+void testSpreadEvents() {
+    std::cout << "\n4. DC events on a spread" << std::endl;
+    SymbolTable symbols(64);
+    SyntheticInstruments synthetics;
+    std::string error;
+    synthetics.configure({{"A_B", "spread", 10.0, {{"A", 1.0}, {"B", 1.0}}}}, symbols, error);
+    const SymbolId a = symbols.find("A");
+    const SymbolId b = symbols.find("B");
+
+    // Two legs sharing a common move, their spread mean-reverting around 10
+    std::mt19937_64 rng(3);
+    std::normal_distribution<double> common(0.0, 0.0001);
+    std::normal_distribution<double> noise(0.0, 0.005);
+    DCIndicator leg_indicator(0.004);
+    DCIndicator spread_indicator(0.004);
+    int leg_events = 0;
+    int spread_events = 0;
+    double level = 100.0;
+    double spread = 0.0;
+    for (std::int64_t i = 0; i < 100000; ++i) {
+        level *= std::exp(common(rng));
+        spread = 0.95 * spread + noise(rng);
+        leg_events += leg_indicator.processDataPoint(MarketDataPoint(i, level + spread)).type != DCEventType::NONE;
+        auto detect = [&](SymbolId, double value) {
+            spread_events += spread_indicator.processDataPoint(MarketDataPoint(i, value)).type != DCEventType::NONE;
+        };
+        synthetics.onTick(a, level + spread, detect);
+        synthetics.onTick(b, level, detect);
+    }
+    std::cout << "leg A " << leg_events << " DC events, spread " << spread_events << std::endl;
+    check(spread_events > 0, "the spread has DC events of its own");
+    check(spread_events != leg_events, "not the legs' events");
+}
+
+void testThousandsOfSynthetics() {
+    std::cout << "\n5. 2000 symbols, 4000 synthetics" << std::endl;
+    constexpr int kSymbols = 2000;
+    constexpr int kSynthetics = 4000;
+    std::mt19937_64 rng(50);
+    auto name = [](const char* prefix, int i) {
+        char buffer[kSymbolLength + 1];
+        std::snprintf(buffer, sizeof(buffer), "%s%05d", prefix, i);
+        return std::string(buffer);
+    };
+    std::vector<Config::SyntheticConfig> definitions;
+    for (int s = 0; s < kSynthetics; ++s) {
+        const int first = static_cast<int>(rng() % kSymbols);
+        const int second = (first + 1 + static_cast<int>(rng() % (kSymbols - 1))) % kSymbols;
+        switch (s % 3) {
+        case 0:
+            definitions.push_back({name("SPR", s), "spread", 5.0, {{name("SYM", first), 1.0}, {name("SYM", second), 0.9}}});
+            break;
+        case 1:
+            definitions.push_back({name("RAT", s), "ratio", 0.0, {{name("SYM", first), 1.0}, {name("SYM", second), 1.0}}});
+            break;
+        default: {
+            Config::SyntheticConfig basket{name("BSK", s), "basket", 0.0, {}};
+            for (int leg = 0; leg < 8; ++leg) {
+                basket.legs.push_back({name("SYM", (first + leg * 97) % kSymbols), 0.125});
+            }
+            definitions.push_back(basket);
+        }
+        }
+    }
+
+    SymbolTable symbols(16384);
+    SyntheticInstruments synthetics;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    check(synthetics.configure(definitions, symbols, error), "synthetics configured");
+    const double configure_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<SymbolId> ids(1 << 16);
+    std::vector<double> moves(1 << 16);
+    std::normal_distribution<double> normal(0.0, 0.0005);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = symbols.findOrInsert(name("SYM", static_cast<int>(rng() % kSymbols)).c_str());
+        moves[i] = std::exp(normal(rng));
+    }
+    std::vector<double> prices(symbols.capacity(), 1.0);
+
+    constexpr int kTicks = 5000000;
+    const std::size_t allocations_before = allocations;
+    std::uint64_t values = 0;
+    double checksum = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTicks; ++i) {
+        const std::size_t n = static_cast<std::size_t>(i) & 0xFFFF;
+        double& price = prices[ids[n]];
+        price *= moves[n];
+        synthetics.onTick(ids[n], price, [&](SymbolId, double value) {
+            values++;
+            checksum += value;
+        });
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kTicks;
+    const std::size_t hot_allocations = allocations - allocations_before;
+
+    // Timings reported, not checked: they depend on the machine and its load
+    std::cout << std::fixed << std::setprecision(2) << "configure " << configure_ms << " ms, " << ns
+              << " ns/tick (budget 250 ns), "
+              << static_cast<double>(values) / kTicks << " synthetics repriced per tick, " << hot_allocations
+              << " allocations, checksum " << checksum << std::endl;
+    check(hot_allocations == 0, "no allocation per tick");
+    check(values > 0, "synthetics repriced");
+}
+
+void testShippedConfig() {
+    std::cout << "\n6. Shipped configuration" << std::endl;
+    Config& config = Config::getInstance();
+    check(config.loadConfig("config/system_config.json"), "config/system_config.json loads");
+    check(config.getSyntheticConfig().size() == 2, "top-level synthetics read");
+    check(config.getExecutionConfig().stream_id == 1003 && config.getExecutionReportConfig().stream_id == 1004,
+          "aeron streams unaffected");
+
+    SymbolTable symbols(64);
+    SyntheticInstruments synthetics;
+    std::string error;
+    check(synthetics.configure(config.getSyntheticConfig(), symbols, error), "shipped synthetics configure");
+    const SymbolId ratio = symbols.find("EURGBP_X");
+    const SymbolId spread = symbols.find("EURUSD_GBPUSD");
+    check(ratio != kInvalidSymbolId && synthetics.isSynthetic(ratio) && spread != kInvalidSymbolId &&
+          synthetics.isSynthetic(spread), "EURGBP_X and EURUSD_GBPUSD defined");
+    check(synthetics.dependents(symbols.find("EURUSD")) == 2 && synthetics.dependents(symbols.find("GBPUSD")) == 2,
+          "both built on EURUSD and GBPUSD");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Synthetic Instruments Test ===" << std::endl;
+
+    testValues();
+    testDependencies();
+    testErrors();
+    testSpreadEvents();
+    testThousandsOfSynthetics();
+    testShippedConfig();
+
+    return testSummary();
+}
@@ -0,0 +1,238 @@
+/**
+ * Theta Ensemble Test
+ * Votes over a symbol's trends at a ladder of DC thresholds: the weighted
+ * popcount vote must match a plain weighted sum, a signal must get through
+ * only when it moves the consensus, bad weights and quorums must be
+ * refused, a replay through a four-rung ladder must send far fewer orders
+ * than trading every rung, and a vote must stay a few nanoseconds.
+ *
+ * Build: g++ -std=c++17 -O3 -march=native -pthread -Iinclude test/theta_ensemble_test.cpp src/strategy/ThetaEnsemble.cpp src/common/DCIndicator.cpp src/strategy/StrategyInstance.cpp src/strategy/OrderBatcher.cpp src/strategy/RiskGate.cpp src/strategy/RuleTable.cpp src/common/TimeUtils.cpp src/common/Logger.cpp -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/DCIndicator.h"
+#include "strategy/StrategyInstance.h"
+#include "strategy/ThetaEnsemble.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+class CountingPublisher : public OrderPublisher {
+public:
+    bool publish(const std::uint8_t*, std::size_t) override {
+        orders++;
+        return true;
+    }
+
+    std::uint64_t orders = 0;
+};
+
+void testVotes() {
+    std::cout << "\n1. Votes and consensus" << std::endl;
+    ThetaEnsemble ensemble;
+    std::string error;
+    check(ensemble.configure({1, 1, 1}, 0, error) && ensemble.quorum() == 2, "three equal thetas, majority of 2");
+
+    ThetaEnsemble::Votes votes = ThetaEnsemble::kNoVotes;
+    check(!ensemble.vote(votes, 0, DCEventType::UPTURN), "one upturn is not a majority");
+    check(ensemble.vote(votes, 1, DCEventType::UPTURN) && votes.consensus == DCEventType::UPTURN,
+          "second upturn moves the consensus up");
+    check(!ensemble.vote(votes, 2, DCEventType::UPTURN), "third upturn adds nothing");
+    check(!ensemble.vote(votes, 0, DCEventType::DOWNTURN) && votes.consensus == DCEventType::UPTURN,
+          "one downturn leaves it up");
+    check(ensemble.vote(votes, 1, DCEventType::DOWNTURN) && votes.consensus == DCEventType::DOWNTURN,
+          "second downturn turns it down");
+    check(ensemble.votesOn(2) && !ensemble.votesOn(3), "rungs past the weights do not vote");
+
+    // The slow theta outweighs the three fast ones together
+    check(ensemble.configure({1, 1, 1, 4}, 4, error), "weighted thetas");
+    votes = ThetaEnsemble::kNoVotes;
+    ensemble.vote(votes, 0, DCEventType::UPTURN);
+    ensemble.vote(votes, 1, DCEventType::UPTURN);
+    check(!ensemble.vote(votes, 2, DCEventType::UPTURN), "fast thetas alone miss the quorum");
+    check(ensemble.vote(votes, 3, DCEventType::UPTURN), "slow theta reaches it");
+    votes = ThetaEnsemble::kNoVotes;
+    check(ensemble.vote(votes, 3, DCEventType::DOWNTURN), "slow theta alone decides");
+
+    // Bit planes against a plain weighted sum
+    std::mt19937_64 rng(48);
+    std::vector<std::uint32_t> weights(64);
+    for (std::uint32_t& weight : weights) {
+        weight = static_cast<std::uint32_t>(rng() % (ThetaEnsemble::kMaxWeight + 1));
+    }
+    check(ensemble.configure(weights, 0, error), "64 thetas with weights up to 255");
+    int mismatches = 0;
+    for (int i = 0; i < 10000; ++i) {
+        const std::uint64_t mask = rng();
+        std::uint32_t expected = 0;
+        for (std::size_t bit = 0; bit < 64; ++bit) {
+            expected += (mask >> bit) & 1 ? weights[bit] : 0;
+        }
+        mismatches += ensemble.weight(mask) != expected ? 1 : 0;
+    }
+    check(mismatches == 0, "popcount weights equal the weighted sum");
+}
+
+void testErrors() {
+    std::cout << "\n2. Invalid settings" << std::endl;
+    ThetaEnsemble ensemble;
+    std::string error;
+    ensemble.configure({1, 1, 1}, 0, error);
+
+    check(!ensemble.configure({}, 0, error), "no weights");
+    check(!ensemble.configure(std::vector<std::uint32_t>(65, 1), 0, error), "more than 64 thetas");
+    check(!ensemble.configure({1, 256}, 0, error), "weight over 255");
+    std::cout << "  " << error << std::endl;
+    check(!ensemble.configure({1, 1, 1, 1}, 2, error), "quorum both sides can reach");
+    std::cout << "  " << error << std::endl;
+    check(!ensemble.configure({1, 1}, 3, error), "quorum over the total weight");
+    check(!ensemble.configure({0, 0}, 0, error), "no weight at all");
+    check(ensemble.thetas() == 3 && ensemble.quorum() == 2, "failed settings keep the current ones");
+}
+
+struct Load {
+    std::uint64_t signals;
+    std::uint64_t traded;
+    std::uint64_t orders;
+};
+
+// A symbol's ticks through a theta ladder; every rung's events go to the
+// strategy, or only those that move the ensemble's consensus
+Load replay(const std::vector<MarketDataPoint>& ticks, const std::vector<double>& thetas, const ThetaEnsemble* ensemble) {
+    RcuDomain rcu;
+    RcuDomain::ReaderId reader = rcu.registerReader();
+    CountingPublisher publisher;
+    StrategyVariant strategy;
+    makeStrategy(DCTrendStrategy::kName, strategy);
+    const StrategyInstanceSettings settings{DCTrendStrategy::kName, 1.0, false, {}, nullptr, false};
+    StrategyInstance instance(0, strategy, settings, rcu, publisher, 4);
+    instance.setReportMode(false, false);
+    instance.enableRiskChecks(false);
+    rcu.online(reader);
+
+    std::vector<DCIndicator> ladder;
+    for (double theta : thetas) {
+        ladder.emplace_back(theta);
+    }
+    ThetaEnsemble::Votes votes = ThetaEnsemble::kNoVotes;
+    Load load{0, 0, 0};
+    for (const MarketDataPoint& tick : ticks) {
+        for (std::size_t rung = 0; rung < ladder.size(); ++rung) {
+            const DCEvent event = ladder[rung].processDataPoint(tick);
+            if (event.type == DCEventType::NONE) {
+                continue;
+            }
+            load.signals++;
+            if (ensemble && !ensemble->vote(votes, static_cast<std::uint8_t>(rung), event.type)) {
+                continue;
+            }
+            load.traded++;
+
+            DCSignalMessage message{};
+            message.event_type = event.type;
+            message.theta_index = static_cast<std::uint8_t>(rung);
+            message.theta = thetas[rung];
+            message.time_adjusted_return = event.type == DCEventType::UPTURN ? event.time_adjusted_return
+                                                                             : -event.time_adjusted_return;
+            message.price = event.price;
+            instance.onSignal(message, 0, MarketState::UNKNOWN, 1.0, 0);
+        }
+    }
+    rcu.offline(reader);
+    load.orders = publisher.orders;
+    return load;
+}
+
+void testReplay() {
+    std::cout << "\n3. Four-rung ladder replay" << std::endl;
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> normal(0.0, 0.0003);
+    std::vector<MarketDataPoint> ticks;
+    double price = 100.0;
+    for (std::int64_t i = 0; i < 200000; ++i) {
+        price *= std::exp(normal(rng));
+        ticks.emplace_back(i * 100000000, price);
+    }
+
+    const std::vector<double> thetas = {0.002, 0.004, 0.008, 0.016};
+    ThetaEnsemble ensemble;
+    std::string error;
+    ensemble.configure({1, 1, 1, 1}, 3, error);
+    const Load independent = replay(ticks, thetas, nullptr);
+    const Load voted = replay(ticks, thetas, &ensemble);
+
+    std::cout << "every rung: " << independent.signals << " signals, " << independent.orders << " orders; "
+              << "ensemble: " << voted.traded << " of " << voted.signals << " signals traded, "
+              << voted.orders << " orders" << std::endl;
+    check(voted.signals == independent.signals, "every rung's events are voted on");
+    check(voted.orders * 3 < independent.orders, "under a third of the orders");
+    check(voted.orders > 0, "the consensus still trades");
+}
+
+void testCost() {
+    std::cout << "\n4. Cost per vote (benchmark)" << std::endl;
+    std::mt19937_64 rng(1);
+    std::vector<std::uint8_t> rungs(1 << 16);
+    std::vector<DCEventType> events(1 << 16);
+    for (std::size_t i = 0; i < rungs.size(); ++i) {
+        rungs[i] = static_cast<std::uint8_t>(rng() % 64);
+        events[i] = rng() % 2 ? DCEventType::UPTURN : DCEventType::DOWNTURN;
+    }
+
+    auto measure = [&](const ThetaEnsemble& ensemble) {
+        constexpr int kVotes = 20000000;
+        std::vector<std::uint8_t> voting(rungs.size());
+        for (std::size_t i = 0; i < rungs.size(); ++i) {
+            voting[i] = static_cast<std::uint8_t>(rungs[i] % ensemble.thetas());
+        }
+        std::vector<ThetaEnsemble::Votes> votes(1024, ThetaEnsemble::kNoVotes);
+        std::uint64_t moved = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kVotes; ++i) {
+            const std::size_t n = static_cast<std::size_t>(i) & 0xFFFF;
+            moved += ensemble.vote(votes[i & 1023], voting[n], events[n]);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kVotes;
+        return std::make_pair(ns, moved);
+    };
+
+    ThetaEnsemble equal;
+    ThetaEnsemble weighted;
+    std::string error;
+    equal.configure(std::vector<std::uint32_t>(4, 1), 0, error);
+    std::vector<std::uint32_t> weights(64);
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        weights[i] = static_cast<std::uint32_t>(1 + i * 4);
+    }
+    weighted.configure(weights, 0, error);
+    const auto equal_cost = measure(equal);
+    const auto weighted_cost = measure(weighted);
+
+    // Reported, not checked: timing depends on the machine and its load
+    std::cout << std::fixed << std::setprecision(2) << "4 equal thetas " << equal_cost.first << " ns/vote, "
+              << "64 weighted thetas " << weighted_cost.first << " ns/vote (budget 25 ns; " << equal_cost.second
+              << ", " << weighted_cost.second << " moves)" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Theta Ensemble Test ===" << std::endl;
+
+    testVotes();
+    testErrors();
+    testReplay();
+    testCost();
+
+    return testSummary();
+}
@@ -0,0 +1,213 @@
+/**
+ * Tick-to-Trade Test
+ * Drives one tick through DC detection, a strategy instance and the
+ * execution engine's simulated venue, then checks that every hop timestamp
+ * reaches the journaled execution and the latency breakdown, and that
+ * market data marks the resulting position once per duty cycle. Also
+ * checks that a restarted engine continues order ids in a new session.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -Iinclude test/tick_to_trade_test.cpp src/common/DCIndicator.cpp \
+ *            src/common/MappedFile.cpp src/common/TimeUtils.cpp src/common/Logger.cpp \
+ *            src/strategy/StrategyInstance.cpp src/strategy/OrderBatcher.cpp src/strategy/RiskGate.cpp \
+ *            src/execution/ExecutionEngine.cpp src/execution/ExchangeSimulator.cpp src/execution/OrderBook.cpp \
+ *            src/execution/PositionKeeper.cpp src/execution/TradeJournal.cpp -laeron_client -lspdlog -lfmt
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/DCIndicator.h"
+#include "common/TimeUtils.h"
+#include "execution/ExecutionEngine.h"
+#include "strategy/StrategyInstance.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+const std::string kJournalPath = "tick_to_trade_test.journal";
+constexpr std::int64_t kSecond = 1000000000;
+
+class CapturingPublisher : public OrderPublisher {
+public:
+    bool publish(const std::uint8_t* data, std::size_t length) override {
+        if (length == sizeof(TradingOrder)) {
+            TradingOrder order;
+            std::memcpy(&order, data, sizeof(order));
+            orders.push_back(order);
+        }
+        return true;
+    }
+
+    std::vector<TradingOrder> orders;
+};
+
+MarketDataMessage tick(double price) {
+    MarketDataMessage message{};
+    message.timestamp = TimeUtils::getCurrentTimestampNs();
+    message.price = price;
+    message.volume = 100.0;
+    std::strncpy(message.symbol, "EURUSD", sizeof(message.symbol) - 1);
+    return message;
+}
+
+// Stamped the way MarketDataProcessor stamps a tick and its signal
+bool detectSignal(DCSignalMessage& signal) {
+    DCIndicator indicator(0.001);
+    const double prices[] = {1.1000, 1.0990, 1.0970, 1.0950, 1.0960, 1.0980, 1.1000, 1.1020};
+    for (double price : prices) {
+        HopTimestamps hops{};
+        hops.feed_receive_ns = TimeUtils::getCurrentTimestampNs();
+        const DCEvent event = indicator.processDataPoint(MarketDataPoint(hops.feed_receive_ns, price, 100.0));
+        if (event.type != DCEventType::UPTURN) {
+            continue;
+        }
+        hops.dc_detected_ns = TimeUtils::getCurrentTimestampNs();
+
+        signal = DCSignalMessage{};
+        signal.timestamp = event.timestamp;
+        signal.event_type = event.type;
+        signal.price = event.price;
+        signal.time_adjusted_return = event.time_adjusted_return;
+        signal.theta = indicator.getBaseTheta();
+        std::strncpy(signal.symbol, "EURUSD", sizeof(signal.symbol) - 1);
+        hops.signal_published_ns = TimeUtils::getCurrentTimestampNs();
+        signal.hops = hops;
+        return true;
+    }
+    return false;
+}
+
+void removeJournal() {
+    for (std::uint64_t segment = 0; segment < 4; ++segment) {
+        std::remove(TradeJournalSegment::path(kJournalPath, segment).c_str());
+    }
+}
+
+void testTickToTrade() {
+    std::cout << "\n1. Tick to trade" << std::endl;
+    removeJournal();
+
+    DCSignalMessage signal{};
+    check(detectSignal(signal), "rising ticks produce an upturn");
+    check(signal.time_adjusted_return > 0.0, "upturn return agrees with the trend strategy");
+
+    // Signal to order
+    RcuDomain rcu;
+    RcuDomain::ReaderId reader = rcu.registerReader();
+    CapturingPublisher publisher;
+    StrategyVariant trend;
+    makeStrategy(DCTrendStrategy::kName, trend);
+    const StrategyInstanceSettings settings{DCTrendStrategy::kName, 1.0, false, {}, nullptr, false};
+    StrategyInstance instance(0, trend, settings, rcu, publisher, 64);
+    instance.enableRiskChecks(false);
+    rcu.online(reader);
+    instance.onSignal(signal, 0, MarketState::UNKNOWN, 1.0, TimeUtils::getCurrentTimestampNs());
+    rcu.offline(reader);
+    check(publisher.orders.size() == 1 && publisher.orders[0].signal == SignalType::BUY, "strategy buys the upturn");
+    if (publisher.orders.size() != 1) {
+        return;
+    }
+    const TradingOrder order = publisher.orders[0];
+    check(order.hops.feed_receive_ns == signal.hops.feed_receive_ns &&
+          order.hops.dc_detected_ns == signal.hops.dc_detected_ns &&
+          order.hops.signal_published_ns == signal.hops.signal_published_ns, "order carries the signal's hops");
+    check(order.hops.order_created_ns >= signal.hops.signal_published_ns && order.hops.execution_ns == 0,
+          "order stamped at creation");
+
+    // Order to fill, without slippage so the fill price is the order price
+    ExecutionEngine engine;
+    ExchangeSimulator::Settings venue = ExchangeSimulator::Settings::defaults();
+    venue.slippage_noise_bps = 0.0;
+    engine.configureSimulatedVenue(venue);
+    engine.setMarkToMarket(true);
+    check(engine.openTradeJournal(kJournalPath, 1024), "journal opened");
+
+    engine.handleOrder(order);
+    check(engine.pollSimulatedVenue(TimeUtils::getCurrentTimestampNs() + kSecond) == 1, "venue fills the order");
+    check(engine.getPosition("EURUSD") == order.quantity, "position booked");
+
+    const std::vector<TradeExecution> history = engine.getTradeHistory();
+    check(history.size() == 1, "execution journaled");
+    if (history.size() != 1) {
+        return;
+    }
+    const HopTimestamps& hops = history[0].hops;
+    check(hops.feed_receive_ns == order.hops.feed_receive_ns && hops.dc_detected_ns == order.hops.dc_detected_ns &&
+          hops.signal_published_ns == order.hops.signal_published_ns &&
+          hops.order_created_ns == order.hops.order_created_ns, "execution carries every upstream hop");
+    check(hops.execution_ns >= hops.order_created_ns && hops.execution_ns == history[0].execution_timestamp,
+          "execution stamped when the fill is recorded");
+
+    const LatencyBreakdown breakdown = engine.getLatencyBreakdown();
+    check(breakdown.samples == 1, "one tick-to-trade sample");
+    check(breakdown.feed_to_dc.avg_ns == hops.dc_detected_ns - hops.feed_receive_ns &&
+          breakdown.dc_to_signal.avg_ns == hops.signal_published_ns - hops.dc_detected_ns &&
+          breakdown.signal_to_order.avg_ns == hops.order_created_ns - hops.signal_published_ns &&
+          breakdown.order_to_execution.avg_ns == hops.execution_ns - hops.order_created_ns,
+          "each hop measured between its own timestamps");
+    check(breakdown.tick_to_trade.avg_ns == hops.execution_ns - hops.feed_receive_ns, "tick to trade end to end");
+
+    // Marks: a burst of ticks is applied once, at the last price
+    const double fill_price = history[0].executed_price;
+    engine.handleMarketData(tick(fill_price + 0.0010), TimeUtils::getCurrentTimestampNs());
+    engine.handleMarketData(tick(fill_price + 0.0020), TimeUtils::getCurrentTimestampNs());
+    check(std::fabs(engine.getPortfolio().unrealized_pnl) < 1e-9, "staged marks wait for the duty cycle");
+    engine.applyMarks();
+    const PortfolioSnapshot portfolio = engine.getPortfolio();
+    check(std::fabs(portfolio.unrealized_pnl - order.quantity * 0.0020) < 1e-9, "marked to the last tick");
+    check(std::fabs(portfolio.net_exposure - order.quantity * (fill_price + 0.0020)) < 1e-9, "exposure at the mark");
+
+    removeJournal();
+}
+
+void testSessionAfterRestart() {
+    std::cout << "\n2. Order session after a restart" << std::endl;
+    removeJournal();
+
+    TradingOrder order{};
+    order.signal = SignalType::BUY;
+    order.price = 1.1;
+    order.quantity = 10.0;
+    std::strncpy(order.symbol, "EURUSD", sizeof(order.symbol) - 1);
+
+    {
+        ExecutionEngine engine;
+        engine.setOrderIdSource(0, 65535);
+        engine.openTradeJournal(kJournalPath, 1024);
+        engine.handleOrder(order);
+        engine.pollSimulatedVenue(TimeUtils::getCurrentTimestampNs() + kSecond);
+    }
+
+    ExecutionEngine restarted;
+    check(restarted.openTradeJournal(kJournalPath, 1024) && restarted.getPosition("EURUSD") == 10.0,
+          "restart replays the journal");
+    restarted.handleOrder(order);
+    restarted.pollSimulatedVenue(TimeUtils::getCurrentTimestampNs() + kSecond);
+
+    const std::vector<TradeExecution> history = restarted.getTradeHistory();
+    check(history.size() == 2, "both executions journaled");
+    if (history.size() == 2) {
+        check(orderIdSession(history[0].order_id) == 65535 && orderIdSession(history[1].order_id) == 0 &&
+              orderIdSequence(history[1].order_id) == 1, "next session after the journal's last, wrapping");
+        check(history[0].order_id != history[1].order_id, "no id reused across the restart");
+    }
+    removeJournal();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Tick-to-Trade Test ===" << std::endl;
+
+    testTickToTrade();
+    testSessionAfterRestart();
+
+    return testSummary();
+}
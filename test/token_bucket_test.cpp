@@ -0,0 +1,92 @@
+/**
+ * Token Bucket Test
+ * Checks burst capacity, sustained refill rate, the unlimited setting and
+ * that a long idle period neither overflows nor over-fills the bucket, and
+ * that checking a bucket without taking from it leaves it unchanged.
+ *
+ * Build: g++ -std=c++17 -O2 -Iinclude test/token_bucket_test.cpp
+ */
+
+#include <iostream>
+#include <string>
+
+#include "common/TokenBucket.h"
+
+#include "TestHarness.h"
+
+using namespace trading;
+
+namespace {
+
+constexpr std::int64_t kMillisecond = 1000000;
+constexpr std::int64_t kSecond = 1000000000;
+
+int acquireAll(TokenBucket& bucket, const TokenBucketLimit& limit, std::int64_t now_ns, int attempts) {
+    int acquired = 0;
+    for (int i = 0; i < attempts; ++i) {
+        acquired += bucket.tryAcquire(limit, now_ns) ? 1 : 0;
+    }
+    return acquired;
+}
+
+void testBurstAndRate() {
+    std::cout << "\n1. Burst and sustained rate" << std::endl;
+    const TokenBucketLimit limit{10, 5};
+    TokenBucket bucket;
+
+    const std::int64_t start = 42 * kSecond;
+    check(acquireAll(bucket, limit, start, 20) == 5, "new bucket allows the burst");
+    check(acquireAll(bucket, limit, start + 99 * kMillisecond, 20) == 0, "nothing before one token refills");
+    check(acquireAll(bucket, limit, start + 100 * kMillisecond, 20) == 1, "one token per 100 ms at 10/s");
+
+    int acquired = 0;
+    for (std::int64_t t = start + kSecond; t < start + 11 * kSecond; t += kMillisecond) {
+        acquired += bucket.tryAcquire(limit, t) ? 1 : 0;
+    }
+    check(acquired >= 100 && acquired <= 105, "about 100 orders over 10 s of constant pressure");
+
+    check(acquireAll(bucket, limit, start + 1000 * kSecond, 20) == 5, "long idle refills to the burst only");
+}
+
+void testUnlimited() {
+    std::cout << "\n2. Unlimited" << std::endl;
+    TokenBucket bucket;
+    check(acquireAll(bucket, TokenBucketLimit{0, 0}, 0, 1000) == 1000, "rate 0 never throttles");
+    check(acquireAll(bucket, TokenBucketLimit{1000000, 0}, kSecond, 3) == 1, "burst 0 behaves as 1");
+}
+
+void testCheckBeforeTaking() {
+    std::cout << "\n3. Check before taking" << std::endl;
+    const TokenBucketLimit symbol_limit{10, 2};
+    const TokenBucketLimit global_limit{10, 1};
+    TokenBucket symbol;
+    TokenBucket global;
+    const std::int64_t start = 42 * kSecond;
+    global.tryAcquire(global_limit, start);
+
+    // The global bucket is empty: the symbol's burst must survive the refusal
+    int sent = 0;
+    for (int i = 0; i < 5; ++i) {
+        if (symbol.available(symbol_limit, start) && global.available(global_limit, start)) {
+            symbol.consume(symbol_limit);
+            global.consume(global_limit);
+            sent++;
+        }
+    }
+    check(sent == 0, "globally throttled orders refused");
+    check(acquireAll(symbol, symbol_limit, start, 5) == 2, "symbol burst intact");
+    const std::int64_t later = start + 100 * kMillisecond;
+    check(global.available(global_limit, later) && global.available(global_limit, later), "available() takes nothing");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Token Bucket Test ===" << std::endl;
+
+    testBurstAndRate();
+    testUnlimited();
+    testCheckBeforeTaking();
+
+    return testSummary();
+}